@@ -19,6 +19,9 @@
 #include "rules.h"
 #include "apps.h"
 #include "daemon_socket.h"
+#include "warm_show.h"
+#include "window_registry.h"
+#include "window_store.h"
 
 
 typedef enum {
@@ -122,12 +125,15 @@ typedef struct AppData {
     GtkWidget *modal_background;    // Semi-transparent modal overlay
     GtkWidget *dialog_container;    // Container for dialog content
 
-    WindowInfo windows[MAX_WINDOWS];        // Raw window list from X11
-    WindowInfo history[MAX_WINDOWS];        // History-ordered windows
-    WindowInfo filtered[MAX_WINDOWS];       // Filtered and display-ready windows
+    WindowInfo *windows;                    // Raw window list from X11
+    Window *history;                        // Window IDs in history (MRU) order
+    WindowInfo *filtered;                   // Filtered and display-ready windows
+    int window_capacity;                    // Allocated length of the arrays above (window_store.c)
     int window_count;
+    WindowRegistry windows_by_id;           // Window ID -> index in windows[]
     int history_count;
     int filtered_count;
+    int filtered_unordered;                 // Trailing filtered rows not yet ranked and copied (filter.c)
     SelectionState selection;               // Centralized selection management
     int active_window_id;                   // Currently active window
     Window own_window_id;                   // Our own window ID for filtering
@@ -146,7 +152,8 @@ typedef struct AppData {
     int filtered_harpoon_count;
 
     // Names tab data
-    NamedWindow filtered_names[MAX_WINDOWS];
+    NamedWindow *filtered_names;
+    int filtered_names_capacity;
     int filtered_names_count;
 
     // Config tab data
@@ -220,6 +227,7 @@ typedef struct AppData {
     gboolean fixed_window_size_initializing; // Guard flag while initial resize is being applied
     gulong fixed_size_allocate_handler_id;  // One-shot size-allocate handler id for textview
     gboolean pending_initial_render;        // True when first render is waiting for fixed sizing
+    WarmShowState warm_show;                // Pre-rendered windows list for the hotkey show path
     
     // Timer management for deferred operations
     guint focus_loss_timer;                 // Timer ID for focus loss delay
@@ -228,7 +236,7 @@ typedef struct AppData {
     int pending_hotkey_mode;               // ShowMode to dispatch on next idle (-1 = none)
     
     // Move-all-to-workspace state
-    Window windows_to_move[MAX_WINDOWS];    // Windows to move for move-all command
+    Window *windows_to_move;                // Windows to move for move-all command (window_capacity long)
     int windows_to_move_count;              // Number of windows to move
 
     // Repeat last action (windows tab, session-only)
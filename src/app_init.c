@@ -31,6 +31,9 @@ void init_tab_visibility(AppData *app) {
 }
 
 void init_app_data(AppData *app) {
+    // Allocate the window store up front so the window arrays are never NULL
+    ensure_window_capacity(app, WINDOW_STORE_MIN_CAPACITY);
+
     // Initialize history and active window tracking
     app->history_count = 0;
     app->active_window_id = -1; // Use -1 to force initial active window to be moved to front
@@ -101,6 +104,7 @@ void init_app_data(AppData *app) {
     app->fixed_window_size_initializing = FALSE;
     app->fixed_size_allocate_handler_id = 0;
     app->pending_initial_render = FALSE;
+    init_warm_show_state(&app->warm_show);
     
     // Initialize timers
     app->focus_loss_timer = 0;
@@ -166,8 +170,8 @@ void init_window_list(AppData *app) {
 
 void init_history_from_windows(AppData *app) {
     // Initialize history with current windows
-    for (int i = 0; i < app->window_count && i < MAX_WINDOWS; i++) {
-        app->history[i] = app->windows[i];
+    for (int i = 0; i < app->window_count; i++) {
+        app->history[i] = app->windows[i].id;
     }
     app->history_count = app->window_count;
     
@@ -176,6 +180,6 @@ void init_history_from_windows(AppData *app) {
     
     log_trace("First 3 windows in history after filter:");
     for (int i = 0; i < 3 && i < app->history_count; i++) {
-        log_trace("  [%d] %s (0x%lx)", i, app->history[i].title, app->history[i].id);
+        log_trace("  [%d] 0x%lx", i, app->history[i]);
     }
 }
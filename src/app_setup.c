@@ -28,8 +28,10 @@
 #include "key_handler.h"
 #include "log.h"
 #include "overlay_manager.h"
+#include "results_view.h"
 #include "selection.h"
 #include "version.h"
+#include "warm_show.h"
 #include "window_highlight.h"
 #include "window_list.h"
 #include "window_lifecycle.h"
@@ -139,15 +141,16 @@ void setup_application(AppData *app, WindowAlignment alignment) {
     app->main_content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     gtk_container_add(GTK_CONTAINER(app->main_overlay), app->main_content);
 
-    app->textview = gtk_text_view_new();
-    app->textbuffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(app->textview));
-    gtk_text_view_set_editable(GTK_TEXT_VIEW(app->textview), FALSE);
-    gtk_text_view_set_cursor_visible(GTK_TEXT_VIEW(app->textview), FALSE);
+    // The view keeps the buffer alive; help and messages still write it
+    app->textbuffer = gtk_text_buffer_new(NULL);
+    app->textview = results_view_new(app->textbuffer);
+    g_object_unref(app->textbuffer);
     gtk_widget_set_can_focus(app->textview, FALSE);
 
     GtkCssProvider *css_provider = gtk_css_provider_new();
     const char *css =
         "textview { font-family: monospace; font-size: 12pt; }\n"
+        "#results { font-family: monospace; font-size: 12pt; background-color: @theme_base_color; color: @theme_text_color; }\n"
         "entry { font-family: monospace; font-size: 12pt; }\n"
         "#mode-indicator { font-family: monospace; font-size: 12pt; padding-left: 10px; padding-right: 5px; }\n"
         "#modal-background { background-color: rgba(0, 0, 0, 0.7); }\n"
@@ -160,11 +163,6 @@ void setup_application(AppData *app, WindowAlignment alignment) {
                                    GTK_STYLE_PROVIDER(css_provider),
                                    GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
 
-    gtk_text_view_set_left_margin(GTK_TEXT_VIEW(app->textview), 10);
-    gtk_text_view_set_right_margin(GTK_TEXT_VIEW(app->textview), 10);
-    gtk_text_view_set_top_margin(GTK_TEXT_VIEW(app->textview), 10);
-    gtk_text_view_set_bottom_margin(GTK_TEXT_VIEW(app->textview), 10);
-
     gtk_widget_set_vexpand(app->textview, TRUE);
     gtk_widget_set_valign(app->textview, GTK_ALIGN_END);
 
@@ -230,6 +228,7 @@ void setup_application(AppData *app, WindowAlignment alignment) {
     }
 
     init_overlay_system(app);
+    attach_warm_show(app);
 
     app->fixed_size_allocate_handler_id =
         g_signal_connect(app->textview, "size-allocate",
@@ -7,11 +7,14 @@
 #include <stdlib.h>
 #include <ctype.h>
 
+// Sorted by index so qsort swaps 16 bytes instead of whole AppEntry rows
 typedef struct {
-    AppEntry entry;
+    int index;      // into s_scoring_src
     score_t score;
 } ScoredAppEntry;
 
+static const AppEntry *s_scoring_src = NULL;  // src of the apps_filter_entries() call sorting
+
 static AppEntry s_entries[MAX_APPS];
 static int s_count = 0;
 static GList *s_app_list = NULL;
@@ -34,7 +37,9 @@ static int scored_app_entry_cmp(const void *a, const void *b) {
         return 1;
     }
 
-    return g_utf8_collate(left->entry.name, right->entry.name);
+    int by_name = g_utf8_collate(s_scoring_src[left->index].name,
+                                 s_scoring_src[right->index].name);
+    return by_name != 0 ? by_name : left->index - right->index;
 }
 
 static int is_token_separator(char ch) {
@@ -160,7 +165,7 @@ void apps_sort_entries(AppEntry *entries, int count) {
 void apps_filter_entries(const char *query,
                          AppEntry *src, int src_count,
                          AppEntry *out, int *out_count) {
-    ScoredAppEntry scored[MAX_APPS];
+    static ScoredAppEntry scored[MAX_APPS];
     int scored_count = 0;
 
     *out_count = 0;
@@ -172,16 +177,18 @@ void apps_filter_entries(const char *query,
 
         score_t score = score_app_entry(query, &src[i]);
         if (score > SCORE_MIN && scored_count < MAX_APPS) {
-            scored[scored_count].entry = src[i];
+            scored[scored_count].index = i;
             scored[scored_count].score = score;
             scored_count++;
         }
     }
 
+    s_scoring_src = src;
     qsort(scored, (size_t)scored_count, sizeof(ScoredAppEntry), scored_app_entry_cmp);
+    s_scoring_src = NULL;
 
     for (int i = 0; i < scored_count; i++) {
-        out[(*out_count)++] = scored[i].entry;
+        out[(*out_count)++] = src[scored[i].index];
     }
 }
 
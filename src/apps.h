@@ -30,6 +30,7 @@ typedef struct {
     SystemActionId action_id;
     char exec_path[512];
     GAppInfo *info;  /* owned by GIO list; valid until apps_unload() */
+    guint64 name_mask;  /* fzf_char_mask(name); kept for PATH cache entries */
 } AppEntry;
 
 /* Load all launchable desktop apps, sorted alphabetically. */
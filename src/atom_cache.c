@@ -18,12 +18,24 @@ void atom_cache_init(Display *display, AtomCache *cache) {
     cache->net_desktop_names = XInternAtom(display, "_NET_DESKTOP_NAMES", False);
     cache->net_active_window = XInternAtom(display, "_NET_ACTIVE_WINDOW", False);
     cache->net_client_list = XInternAtom(display, "_NET_CLIENT_LIST", False);
+    cache->net_client_list_stacking = XInternAtom(display, "_NET_CLIENT_LIST_STACKING", False);
     cache->net_workarea = XInternAtom(display, "_NET_WORKAREA", False);
+    cache->net_wm_state = XInternAtom(display, "_NET_WM_STATE", False);
+    cache->net_wm_state_hidden = XInternAtom(display, "_NET_WM_STATE_HIDDEN", False);
+    cache->net_wm_state_shaded = XInternAtom(display, "_NET_WM_STATE_SHADED", False);
+    cache->net_wm_state_sticky = XInternAtom(display, "_NET_WM_STATE_STICKY", False);
+    cache->net_wm_state_maximized_vert = XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_VERT", False);
+    cache->net_wm_state_maximized_horz = XInternAtom(display, "_NET_WM_STATE_MAXIMIZED_HORZ", False);
+    cache->net_wm_state_fullscreen = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
+    cache->net_wm_state_above = XInternAtom(display, "_NET_WM_STATE_ABOVE", False);
+    cache->net_wm_state_below = XInternAtom(display, "_NET_WM_STATE_BELOW", False);
+    cache->net_wm_state_skip_taskbar = XInternAtom(display, "_NET_WM_STATE_SKIP_TASKBAR", False);
+    cache->net_wm_state_demands_attention = XInternAtom(display, "_NET_WM_STATE_DEMANDS_ATTENTION", False);
     
     // Additional atoms
     cache->wm_state = XInternAtom(display, "WM_STATE", False);
     cache->wm_change_state = XInternAtom(display, "WM_CHANGE_STATE", False);
     cache->utf8_string = XInternAtom(display, "UTF8_STRING", False);
     
-    log_debug("Atom cache initialized with %d atoms", 18);
+    log_debug("Atom cache initialized with %d atoms", 30);
 }
\ No newline at end of file
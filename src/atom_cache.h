@@ -18,7 +18,19 @@ typedef struct {
     Atom net_desktop_names;
     Atom net_active_window;
     Atom net_client_list;
+    Atom net_client_list_stacking;
     Atom net_workarea;
+    Atom net_wm_state;
+    Atom net_wm_state_hidden;
+    Atom net_wm_state_shaded;
+    Atom net_wm_state_sticky;
+    Atom net_wm_state_maximized_vert;
+    Atom net_wm_state_maximized_horz;
+    Atom net_wm_state_fullscreen;
+    Atom net_wm_state_above;
+    Atom net_wm_state_below;
+    Atom net_wm_state_skip_taskbar;
+    Atom net_wm_state_demands_attention;
     
     // Additional atoms
     Atom wm_state;
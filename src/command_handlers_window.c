@@ -1,6 +1,7 @@
 #include "command_handlers_window.h"
 
 #include "app_data.h"
+#include "filter.h"
 #include "log.h"
 #include "monitor_move.h"
 #include "overlay_manager.h"
@@ -209,6 +210,7 @@ typedef struct {
 } SwapAtoms;
 
 static WindowInfo *find_swap_partner(AppData *app, Window selected_id) {
+    ensure_filtered_order(app, 2);
     for (int i = 0; i < app->filtered_count; i++) {
         if (app->filtered[i].id != selected_id) {
             return &app->filtered[i];
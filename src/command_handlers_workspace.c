@@ -84,7 +84,7 @@ static gboolean window_is_sticky_desktop(const WindowInfo *window) {
     return window->desktop == -1 || window->desktop == 0xFFFFFFFF;
 }
 
-static gboolean should_move_window(AppData *app, WindowInfo *win, int current_workspace) {
+static gboolean should_move_window(const WindowInfo *win, int current_workspace) {
     if (strcmp(win->type, "Special") == 0) {
         log_debug("Skipping special window: %s", win->title);
         return FALSE;
@@ -97,7 +97,7 @@ static gboolean should_move_window(AppData *app, WindowInfo *win, int current_wo
         return FALSE;
     }
 
-    if (get_window_state(app->display, win->id, "_NET_WM_STATE_STICKY")) {
+    if (win->state & WINDOW_STATE_FLAG_STICKY) {
         log_debug("Skipping sticky window (state check): %s", win->title);
         return FALSE;
     }
@@ -110,11 +110,7 @@ static int collect_windows_to_move(AppData *app, int current_workspace) {
 
     for (int i = 0; i < app->window_count; i++) {
         WindowInfo *win = &app->windows[i];
-        if (!should_move_window(app, win, current_workspace)) {
-            continue;
-        }
-
-        if (app->windows_to_move_count >= MAX_WINDOWS) {
+        if (!should_move_window(win, current_workspace)) {
             continue;
         }
 
@@ -5,6 +5,7 @@
 #include "run_mode.h"
 #include "selection.h"
 #include "dynamic_display.h"
+#include "filter.h"
 #include "command_parse_defs.h"
 
 #include <string.h>
@@ -349,15 +350,13 @@ void enter_command_mode(AppData *app) {
 
     if (app->current_tab == TAB_WINDOWS && app->filtered_count > 0 &&
         app->command_target_id != 0) {
-        for (int i = 0; i < app->filtered_count; i++) {
-            if ((Window)app->filtered[i].id == app->command_target_id) {
-                app->selection.window_index = i;
-                app->selection.selected_window_id = app->filtered[i].id;
-                update_display(app);
-                log_debug("Command mode: selected window 0x%lx at index %d by pre-focus ID",
-                          app->command_target_id, i);
-                break;
-            }
+        int row = find_filtered_row(app, app->command_target_id);
+        if (row >= 0) {
+            app->selection.window_index = row;
+            app->selection.selected_window_id = app->filtered[row].id;
+            update_display(app);
+            log_debug("Command mode: selected window 0x%lx at index %d by pre-focus ID",
+                      app->command_target_id, row);
         }
     } else if (app->current_tab == TAB_WINDOWS && app->filtered_count > 0 &&
                app->selection.window_index == 1) {
@@ -15,6 +15,7 @@
 #include "run_mode.h"
 #include "selection.h"
 #include "tab_switching.h"
+#include "warm_show.h"
 #include "window_lifecycle.h"
 #include "x11_utils.h"
 
@@ -100,12 +101,15 @@ static void show_tab_for_opcode(AppData *app, TabMode tab) {
 
     reset_interaction_modes(app);
 
+    // A freshly shown windows tab is already filtered and rendered by
+    // show_window; only an already visible window needs the reset
+    gboolean was_visible = app->window_visible;
     app->current_tab = TAB_WINDOWS;
     show_window(app);
 
     if (tab != TAB_WINDOWS) {
         surface_tab(app, tab);
-    } else {
+    } else if (was_visible) {
         gtk_entry_set_text(GTK_ENTRY(app->entry), "");
         reset_selection(app);
         filter_windows(app, "");
@@ -141,6 +145,7 @@ void daemon_socket_dispatch_opcode(AppData *app, uint8_t opcode) {
         return;
     }
 
+    warm_show_mark_request(app);
     refresh_focus_timestamp(app);
 
     switch (opcode) {
@@ -15,8 +15,38 @@
 #include "dynamic_display.h"
 #include "named_window.h"
 #include "display_pipeline.h"
+#include "filter.h"
 #include "tab_switching.h"
 #include "path_binaries.h"
+#include "match_highlight.h"
+#include "line_diff.h"
+#include "results_view.h"
+#include "render_fingerprint.h"
+#include "search_cache.h"
+#include "row_cache.h"
+#include "window_list.h"
+
+// Marks a buffer that holds a frame of update_display()
+#define RENDERED_FRAME_KEY "cofi-rendered-frame"
+
+// Matched characters of the windows rows the current frame draws
+static MatchHighlighter highlighter;
+
+// Lines last put into the results buffer, to rewrite only what changed
+static LineDiff rendered_lines;
+
+// Formatted windows tab rows, reused while their window does not change
+static RowCache formatted_rows;
+
+// Inputs of the frame on screen, to skip frames that would paint the same
+static RenderFingerprint rendered_frame;
+
+// Frame clock a requested frame waits on; a weak pointer, so a destroyed
+// window takes its queued frame along
+static GdkFrameClock *queued_clock;
+static gulong queued_update_id;
+static gboolean queued_over_frame;    // Buffer held our frame at the last request
+static unsigned queued_coalesced;     // Requests folded into an already queued frame
 
 // Check if instance and class should be swapped for display
 static gboolean should_swap_instance_class(const char *instance) {
@@ -272,15 +302,26 @@ static void overlay_scrollbar_adapter(gpointer context, GString *text,
                       scroll_offset, target_columns);
 }
 
-static void render_windows_item(gpointer context, gint index,
-                                gint selected_idx, GString *text) {
-    AppData *app = (AppData *)context;
-    WindowInfo *win = &app->filtered[index];
-
-    g_string_append(text,
-                    (index == selected_idx) ? SELECTION_INDICATOR
-                                            : NO_SELECTION_INDICATOR);
+// Line of the selected row in the frame being formatted, -1 if none
+static int selected_line = -1;
+
+// Start a row with a blank gutter whether or not it is selected, so a row's
+// text never depends on the selection: moving it rewrites no lines (nor
+// their cached rows and layouts). results_view draws the marker over the
+// gutter of the line apply_selection_tag() tags.
+static void append_selection_gutter(GString *text, gint index, gint selected_idx) {
+    if (index == selected_idx) {
+        selected_line = 0;
+        for (gsize i = 0; i < text->len; i++) {
+            selected_line += text->str[i] == '\n';
+        }
+    }
+    g_string_append(text, NO_SELECTION_INDICATOR);
+}
 
+// Format the row of win after the selection gutter into row
+static void format_windows_row(const WindowInfo *win, gint slot, Window display_id,
+                               CachedRow *row) {
     char display_instance[MAX_CLASS_LEN];
     char display_class[MAX_CLASS_LEN];
     if (should_swap_instance_class(win->instance)) {
@@ -296,10 +337,6 @@ static void render_windows_item(gpointer context, gint index,
     char instance_col[DISPLAY_INSTANCE_WIDTH + 1];
     char title_col[DISPLAY_TITLE_WIDTH + 1];
     char class_col[DISPLAY_CLASS_WIDTH + 1];
-    char window_id[32];
-
-    gint slot = get_window_slot(&app->harpoon, win->id);
-    Window display_id = win->id;
 
     if (slot >= 0) {
         if (slot <= HARPOON_LAST_NUMBER) {
@@ -308,10 +345,6 @@ static void render_windows_item(gpointer context, gint index,
             snprintf(harpoon_col, sizeof(harpoon_col), "%c ",
                      'a' + (slot - HARPOON_FIRST_LETTER));
         }
-
-        if (app->harpoon.slots[slot].assigned) {
-            display_id = app->harpoon.slots[slot].id;
-        }
     } else {
         strcpy(harpoon_col, "  ");
     }
@@ -325,19 +358,59 @@ static void render_windows_item(gpointer context, gint index,
 
     fit_column(display_title, DISPLAY_TITLE_WIDTH, title_col);
     fit_column(display_class, DISPLAY_CLASS_WIDTH, class_col);
-    snprintf(window_id, sizeof(window_id), "0x%lx", display_id);
 
-    g_string_append(text, harpoon_col);
-    g_string_append(text, desktop_col);
-    g_string_append(text, " ");
-    g_string_append(text, instance_col);
-    g_string_append(text, " ");
-    g_string_append(text, title_col);
-    g_string_append(text, " ");
-    g_string_append(text, class_col);
-    g_string_append(text, " ");
-    g_string_append(text, window_id);
-    g_string_append(text, "\n");
+    // Match positions cover desktop to class only; the harpoon slot and
+    // window id are not part of what filtering matched
+    row->match_start = (int)strlen(harpoon_col);
+    int len = snprintf(row->line, sizeof(row->line), "%s%s %s %s %s",
+                       harpoon_col, desktop_col, instance_col, title_col, class_col);
+    row->match_len = len - row->match_start;
+    len += snprintf(row->line + len, sizeof(row->line) - (size_t)len, " 0x%lx", display_id);
+    row->len = MIN(len, (int)sizeof(row->line) - 1);
+}
+
+static void render_windows_item(gpointer context, gint index,
+                                gint selected_idx, GString *text) {
+    AppData *app = (AppData *)context;
+    WindowInfo *win = &app->filtered[index];
+
+    gint slot = get_window_slot(&app->harpoon, win->id);
+    Window display_id = win->id;
+    if (slot >= 0 && app->harpoon.slots[slot].assigned) {
+        display_id = app->harpoon.slots[slot].id;
+    }
+
+    // Rows only change with their window, so most frames copy every row
+    uint64_t key = row_cache_key(search_key_fingerprint(win), slot, display_id);
+    const CachedRow *row = row_cache_lookup(&formatted_rows, win->id, key);
+    CachedRow scratch;
+    if (!row) {
+        CachedRow *stored = row_cache_store(&formatted_rows, win->id, key);
+        format_windows_row(win, slot, display_id, stored ? stored : &scratch);
+        row = stored ? stored : &scratch;
+    }
+
+    append_selection_gutter(text, index, selected_idx);
+    gsize row_start = text->len;
+    g_string_append_len(text, row->line, row->len);
+
+    // Match positions for this drawn row only
+    match_highlight_row(&highlighter, text->str + row_start + row->match_start,
+                        row->match_len,
+                        (int)strlen(NO_SELECTION_INDICATOR) + row->match_start);
+
+    g_string_append_c(text, '\n');
+}
+
+// Drop rows of windows that left the list (only once the cache outgrew it)
+static void prune_formatted_rows(const AppData *app) {
+    if (formatted_rows.count <= app->window_count) return;
+
+    for (int i = formatted_rows.count - 1; i >= 0; i--) {
+        if (find_window_index(app, formatted_rows.entries[i].id) < 0) {
+            row_cache_forget(&formatted_rows, formatted_rows.entries[i].id);
+        }
+    }
 }
 
 static void format_windows_display(AppData *app, GString *text, gint selected_idx) {
@@ -356,8 +429,12 @@ static void format_windows_display(AppData *app, GString *text, gint selected_id
         .overlay_scrollbar = overlay_scrollbar_adapter,
     };
     request.render_item = render_windows_item;
+    ensure_filtered_order(app, request.scroll_offset + request.max_lines);
+    prune_formatted_rows(app);
 
     render_display_pipeline(&request, text);
+    log_trace("Windows rows: %u copied, %u formatted so far",
+              formatted_rows.hits, formatted_rows.misses);
 }
 
 static void render_workspaces_item(gpointer context, gint index,
@@ -365,7 +442,7 @@ static void render_workspaces_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     WorkspaceInfo *ws = &app->filtered_workspaces[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
     g_string_append(text, ws->is_current ? "* " : "  ");
     g_string_append_printf(text, "[%d] %s\n", ws->id + 1, ws->name);
 }
@@ -396,7 +473,7 @@ static void render_harpoon_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     HarpoonSlot *slot = &app->filtered_harpoon[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
 
     char slot_name[4];
     gint slot_idx = app->filtered_harpoon_indices[index];
@@ -447,7 +524,7 @@ static void render_names_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     NamedWindow *named = &app->filtered_names[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
 
     char custom_name_col[21], original_title_col[46], class_col[19];
     char window_id[12];
@@ -500,7 +577,7 @@ static void render_config_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     ConfigEntry *entry = &app->filtered_config[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
 
     char key_col[33], value_col[61];
     fit_column(entry->key, 32, key_col);
@@ -541,7 +618,7 @@ static void render_hotkeys_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     HotkeyBinding *binding = &app->filtered_hotkeys[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
 
     char key_col[25], cmd_col[71];
     fit_column(binding->key, 24, key_col);
@@ -583,7 +660,7 @@ static void render_apps_item(gpointer context, gint index,
     AppData *app = (AppData *)context;
     AppEntry *entry = &app->filtered_apps[index];
 
-    g_string_append(text, (index == selected_idx) ? "> " : "  ");
+    append_selection_gutter(text, index, selected_idx);
 
     char name_col[49], generic_col[41];
     fit_column(entry->name, 48, name_col);
@@ -619,8 +696,270 @@ static void format_apps_display(AppData *app, GString *text, gint selected_idx)
     render_display_pipeline(&request, text);
 }
 
-// Update the text display with proper 5-column format like Go code
-void update_display(AppData *app) {
+// Whether an edit rewrote line (its tags are gone)
+static gboolean line_rewritten(int line) {
+    for (int i = 0; i < rendered_lines.edit_count; i++) {
+        const LineEdit *edit = &rendered_lines.edits[i];
+        if (edit->kind == LINE_EDIT_REPLACE && edit->line == line) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+// Tag the highlight spans of the rows just put into the buffer. When only
+// some lines were rewritten and the spans did not change, the other lines
+// keep their tags and only the rewritten ones are tagged again.
+static void apply_match_highlights(GtkTextBuffer *buffer, gboolean diffed) {
+    gboolean only_replaced = diffed;
+    for (int i = 0; i < rendered_lines.edit_count; i++) {
+        only_replaced &= rendered_lines.edits[i].kind == LINE_EDIT_REPLACE;
+    }
+    gboolean partial = only_replaced && !match_highlight_changed(&highlighter);
+    if (highlighter.count == 0 && (partial || !diffed || highlighter.previous_count == 0)) {
+        return;
+    }
+
+    GtkTextTag *tag = results_view_match_tag(buffer);
+
+    if (diffed && !partial) {
+        GtkTextIter start, end;
+        gtk_text_buffer_get_bounds(buffer, &start, &end);
+        gtk_text_buffer_remove_tag(buffer, tag, &start, &end);
+    }
+
+    for (int i = 0; i < highlighter.count; i++) {
+        const HighlightSpan *span = &highlighter.spans[i];
+        if (partial && !line_rewritten(span->line)) {
+            continue;
+        }
+        GtkTextIter start, end;
+        gtk_text_buffer_get_iter_at_line(buffer, &start, span->line);
+        if (span->start + span->len > gtk_text_iter_get_bytes_in_line(&start)) {
+            continue;
+        }
+        end = start;
+        gtk_text_iter_set_line_index(&start, span->start);
+        gtk_text_iter_set_line_index(&end, span->start + span->len);
+        gtk_text_buffer_apply_tag(buffer, tag, &start, &end);
+    }
+}
+
+// Move the selected tag to the gutter of selected_line. Rows read the same
+// whichever is selected, so this is all a selection move changes; a tag
+// that already sits there (kept through line edits) is left alone.
+static void apply_selection_tag(GtkTextBuffer *buffer) {
+    GtkTextTag *tag = results_view_selected_tag(buffer);
+    GtkTextIter start, end;
+
+    if (selected_line >= 0 && selected_line < gtk_text_buffer_get_line_count(buffer)) {
+        gtk_text_buffer_get_iter_at_line(buffer, &start, selected_line);
+        if (gtk_text_iter_has_tag(&start, tag)) {
+            return;
+        }
+    }
+
+    gtk_text_buffer_get_bounds(buffer, &start, &end);
+    gtk_text_buffer_remove_tag(buffer, tag, &start, &end);
+    if (selected_line < 0 || selected_line >= gtk_text_buffer_get_line_count(buffer)) {
+        return;
+    }
+
+    gtk_text_buffer_get_iter_at_line(buffer, &start, selected_line);
+    end = start;
+    gtk_text_iter_set_line_index(&end, (gint)strlen(NO_SELECTION_INDICATOR));
+    gtk_text_buffer_apply_tag(buffer, tag, &start, &end);
+}
+
+static void apply_line_edit(GtkTextBuffer *buffer, const LineEdit *edit) {
+    GtkTextIter start, end;
+    int line_count = gtk_text_buffer_get_line_count(buffer);
+
+    switch (edit->kind) {
+        case LINE_EDIT_REPLACE:
+            gtk_text_buffer_get_iter_at_line(buffer, &start, edit->line);
+            end = start;
+            if (!gtk_text_iter_ends_line(&end)) {
+                gtk_text_iter_forward_to_line_end(&end);
+            }
+            gtk_text_buffer_delete(buffer, &start, &end);
+            gtk_text_buffer_insert(buffer, &start, edit->text, edit->len);
+            break;
+        case LINE_EDIT_INSERT:
+            if (edit->line < line_count) {
+                gtk_text_buffer_get_iter_at_line(buffer, &start, edit->line);
+                gtk_text_buffer_insert(buffer, &start, edit->text, edit->len);
+                gtk_text_buffer_insert(buffer, &start, "\n", 1);
+            } else {
+                gtk_text_buffer_get_end_iter(buffer, &start);
+                gtk_text_buffer_insert(buffer, &start, "\n", 1);
+                gtk_text_buffer_insert(buffer, &start, edit->text, edit->len);
+            }
+            break;
+        case LINE_EDIT_DELETE:
+            gtk_text_buffer_get_iter_at_line(buffer, &start, edit->line);
+            if (edit->line + edit->count < line_count) {
+                gtk_text_buffer_get_iter_at_line(buffer, &end, edit->line + edit->count);
+            } else {
+                // Removing the last lines takes the newline before them
+                gtk_text_buffer_get_end_iter(buffer, &end);
+                gtk_text_iter_backward_char(&start);
+            }
+            gtk_text_buffer_delete(buffer, &start, &end);
+            break;
+    }
+}
+
+// Put text into the buffer, rewriting only the lines that changed since
+// the last frame. Returns FALSE if the whole text had to be set.
+static gboolean set_display_text(GtkTextBuffer *buffer, const char *text) {
+    // Help and messages write the buffer behind our back, which leaves it
+    // modified; a new window brings a buffer without our mark
+    if (!g_object_get_data(G_OBJECT(buffer), RENDERED_FRAME_KEY) ||
+        gtk_text_buffer_get_modified(buffer)) {
+        line_diff_invalidate(&rendered_lines);
+        g_object_set_data(G_OBJECT(buffer), RENDERED_FRAME_KEY, GINT_TO_POINTER(1));
+    }
+
+    int edit_count = line_diff_update(&rendered_lines, text);
+    if (edit_count < 0) {
+        gtk_text_buffer_set_text(buffer, text, -1);
+    }
+    for (int i = 0; i < edit_count; i++) {
+        apply_line_edit(buffer, &rendered_lines.edits[i]);
+    }
+    log_trace("Display update: %s", edit_count < 0 ? "full text" : "line edits");
+
+    gtk_text_buffer_set_modified(buffer, FALSE);
+    return edit_count >= 0;
+}
+
+// Hash in the row count of the current tab and the fields its
+// render_*_item formats for the rows on screen
+static uint64_t fingerprint_rows(AppData *app, int max_lines, int scroll_offset, uint64_t h) {
+    int count = 0;
+    switch (app->current_tab) {
+        case TAB_WINDOWS:      count = app->filtered_count; break;
+        case TAB_WORKSPACES:   count = app->filtered_workspace_count; break;
+        case TAB_HARPOON:      count = app->filtered_harpoon_count; break;
+        case TAB_NAMES:        count = app->filtered_names_count; break;
+        case TAB_CONFIG:       count = app->filtered_config_count; break;
+        case TAB_HOTKEYS:      count = app->filtered_hotkeys_count; break;
+        case TAB_APPS:         count = app->filtered_apps_count; break;
+    }
+    h = render_fingerprint_int(h, count);
+
+    gint start_idx = 0;
+    gint end_idx = 0;
+    calculate_display_range(count, max_lines, scroll_offset, &start_idx, &end_idx);
+    if (app->current_tab == TAB_WINDOWS && end_idx > start_idx) {
+        ensure_filtered_order(app, end_idx);
+    }
+
+    for (gint i = start_idx; i < end_idx; i++) {
+        switch (app->current_tab) {
+            case TAB_WINDOWS: {
+                const WindowInfo *win = &app->filtered[i];
+                int slot = get_window_slot(&app->harpoon, win->id);
+                h = render_fingerprint_int(h, (int64_t)win->id);
+                h = render_fingerprint_int(h, (int64_t)search_key_fingerprint(win));
+                h = render_fingerprint_int(h, slot);
+                if (slot >= 0 && app->harpoon.slots[slot].assigned) {
+                    h = render_fingerprint_int(h, (int64_t)app->harpoon.slots[slot].id);
+                }
+                break;
+            }
+            case TAB_WORKSPACES: {
+                const WorkspaceInfo *ws = &app->filtered_workspaces[i];
+                h = render_fingerprint_int(h, ws->id);
+                h = render_fingerprint_int(h, ws->is_current);
+                h = render_fingerprint_string(h, ws->name);
+                break;
+            }
+            case TAB_HARPOON: {
+                const HarpoonSlot *slot = &app->filtered_harpoon[i];
+                h = render_fingerprint_int(h, app->filtered_harpoon_indices[i]);
+                h = render_fingerprint_int(h, slot->assigned);
+                h = render_fingerprint_string(h, slot->title);
+                h = render_fingerprint_string(h, slot->class_name);
+                h = render_fingerprint_string(h, slot->instance);
+                h = render_fingerprint_string(h, slot->type);
+                break;
+            }
+            case TAB_NAMES: {
+                const NamedWindow *named = &app->filtered_names[i];
+                h = render_fingerprint_int(h, named->assigned);
+                h = render_fingerprint_int(h, (int64_t)named->id);
+                h = render_fingerprint_string(h, named->custom_name);
+                h = render_fingerprint_string(h, named->original_title);
+                h = render_fingerprint_string(h, named->class_name);
+                break;
+            }
+            case TAB_CONFIG:
+                h = render_fingerprint_string(h, app->filtered_config[i].key);
+                h = render_fingerprint_string(h, app->filtered_config[i].value);
+                break;
+            case TAB_HOTKEYS:
+                h = render_fingerprint_string(h, app->filtered_hotkeys[i].key);
+                h = render_fingerprint_string(h, app->filtered_hotkeys[i].command);
+                break;
+            case TAB_APPS:
+                h = render_fingerprint_string(h, app->filtered_apps[i].name);
+                h = render_fingerprint_string(h, app->filtered_apps[i].generic_name);
+                break;
+        }
+    }
+    return h;
+}
+
+// Hash of every input a frame is formatted from: the rows on screen,
+// selection, scrolling, size, query, tab bar and candidate strip. Anything
+// new drawn into a frame has to be hashed here too, or changing it alone
+// will not repaint.
+static uint64_t frame_fingerprint(AppData *app, int selected_idx) {
+    int max_lines = get_max_display_lines_dynamic(app);
+    int scroll_offset = get_scroll_offset(app);
+    uint64_t h = RENDER_FINGERPRINT_SEED;
+
+    h = render_fingerprint_int(h, app->current_tab);
+    h = render_fingerprint_int(h, app->command_mode.state);
+    h = render_fingerprint_int(h, selected_idx);
+    h = render_fingerprint_int(h, scroll_offset);
+    h = render_fingerprint_int(h, max_lines);
+    h = render_fingerprint_int(h, get_display_columns(app));
+
+    h = fingerprint_rows(app, max_lines, scroll_offset, h);
+    if (app->current_tab == TAB_WINDOWS) {
+        // Highlights come from the query
+        h = render_fingerprint_string(h, get_windows_filter());
+    } else if (app->current_tab == TAB_APPS) {
+        h = render_fingerprint_int(h, path_binaries_is_scanning());
+    }
+
+    for (int tab = TAB_WINDOWS; tab <= TAB_APPS; tab++) {
+        h = render_fingerprint_int(h, tab_is_visible(app, (TabMode)tab));
+    }
+
+    h = render_fingerprint_int(h, app->command_mode.candidate_count);
+    h = render_fingerprint_int(h, app->command_mode.candidate_highlight);
+    for (int i = 0; i < app->command_mode.candidate_count; i++) {
+        h = render_fingerprint_string(h, app->command_mode.candidates[i]);
+    }
+    return h;
+}
+
+// Whether the buffer still shows the frame update_display() last wrote
+static gboolean buffer_holds_frame(GtkTextBuffer *buffer) {
+    return g_object_get_data(G_OBJECT(buffer), RENDERED_FRAME_KEY) &&
+           !gtk_text_buffer_get_modified(buffer);
+}
+
+const RenderFingerprint *get_render_fingerprint(void) {
+    return &rendered_frame;
+}
+
+// Format the current tab and put it into the buffer, like Go code
+static void render_display(AppData *app) {
     int selected_idx = get_selected_index(app);
     log_debug("update_display() - filtered_count=%d, selected_index=%d",
             app->filtered_count, selected_idx);
@@ -642,7 +981,23 @@ void update_display(AppData *app) {
                 (selected_idx < app->filtered_count) ? app->filtered[selected_idx].title : "(none)");
     }
     
+    // Most X events leave the frame as it is (a desktop switch while hidden,
+    // a title change off screen). Help or a message in the buffer, or a new
+    // buffer, means the painted frame is gone.
+    uint64_t fingerprint = frame_fingerprint(app, selected_idx);
+    if (!buffer_holds_frame(app->textbuffer)) {
+        render_fingerprint_invalidate(&rendered_frame);
+    }
+    if (render_fingerprint_unchanged(&rendered_frame, fingerprint)) {
+        log_trace("Display unchanged, skipped (%u skipped, %u painted)",
+                  rendered_frame.skipped, rendered_frame.performed);
+        return;
+    }
+
     GString *text = g_string_new("");
+    selected_line = -1;
+    match_highlight_begin(&highlighter,
+                          app->current_tab == TAB_WINDOWS ? get_windows_filter() : NULL);
     
     // Format content based on current tab
     switch (app->current_tab) {
@@ -675,11 +1030,77 @@ void update_display(AppData *app) {
     format_candidate_strip(app, text);
     
     // Set the text
-    gtk_text_buffer_set_text(app->textbuffer, text->str, -1);
+    gboolean diffed = set_display_text(app->textbuffer, text->str);
+    apply_match_highlights(app->textbuffer, diffed);
+    apply_selection_tag(app->textbuffer);
     g_string_free(text, TRUE);
 
 }
 
+static void cancel_queued_render(void) {
+    if (!queued_clock) {
+        return;
+    }
+    g_signal_handler_disconnect(queued_clock, queued_update_id);
+    g_object_remove_weak_pointer(G_OBJECT(queued_clock), (gpointer *)&queued_clock);
+    queued_clock = NULL;
+    queued_update_id = 0;
+}
+
+static void on_display_frame_update(GdkFrameClock *clock, gpointer data) {
+    (void)clock;
+    AppData *app = (AppData *)data;
+    cancel_queued_render();
+
+    // Text written by help or a message after the last request is newer
+    // than the frame that was asked for
+    if (queued_over_frame && app->textbuffer && gtk_text_buffer_get_modified(app->textbuffer)) {
+        log_debug("Queued display update dropped - buffer was written since");
+        return;
+    }
+    render_display(app);
+}
+
+// Request a frame; it is formatted once in the next update phase of the
+// window's frame clock, however many requests come before it. Without a
+// mapped window there is no frame to wait for and it renders right away.
+void update_display(AppData *app) {
+    GdkFrameClock *clock = NULL;
+    if (app->textview && gtk_widget_get_mapped(app->textview)) {
+        clock = gtk_widget_get_frame_clock(app->textview);
+    }
+    if (!clock) {
+        cancel_queued_render();
+        render_display(app);
+        return;
+    }
+
+    queued_over_frame = app->textbuffer && buffer_holds_frame(app->textbuffer);
+    if (queued_clock == clock) {
+        queued_coalesced++;
+        log_trace("Display update coalesced (%u so far)", queued_coalesced);
+        return;
+    }
+
+    cancel_queued_render();
+    queued_clock = clock;
+    g_object_add_weak_pointer(G_OBJECT(clock), (gpointer *)&queued_clock);
+    queued_update_id = g_signal_connect(clock, "update",
+                                        G_CALLBACK(on_display_frame_update), app);
+    gdk_frame_clock_request_phase(clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+}
+
+unsigned get_coalesced_display_updates(void) {
+    return queued_coalesced;
+}
+
+void flush_display(AppData *app) {
+    if (queued_clock) {
+        cancel_queued_render();
+        render_display(app);
+    }
+}
+
 // Send X11 client message (based on wmctrl implementation)
 static int client_msg(Display *disp, Window win, const char *msg, 
     unsigned long data0, unsigned long data1, 
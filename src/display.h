@@ -2,6 +2,7 @@
 #define DISPLAY_H
 
 #include <X11/Xlib.h>
+#include "render_fingerprint.h"
 
 // Forward declaration (avoid duplicate typedef)
 #ifndef APPDATA_TYPEDEF_DEFINED
@@ -9,9 +10,18 @@
 typedef struct AppData AppData;
 #endif
 
-// Update the text display with proper 5-column format
+// Request an update of the text display (5-column format). While the
+// window is mapped the frame is formatted once per frame clock update
+// phase; it is skipped when it would match the one on screen.
 void update_display(AppData *app);
 
+// Format a requested frame now instead of at the next frame (tests, and
+// code that reads the buffer right after requesting)
+void flush_display(AppData *app);
+
+// Requests folded into an already queued frame so far
+unsigned get_coalesced_display_updates(void);
+
 // Get maximum number of lines that can be displayed (legacy function)
 int get_max_display_lines(void);
 
@@ -29,6 +39,9 @@ void overlay_scrollbar(GString *text, int total_items, int visible_items, int sc
 // Activate window using direct X11 calls
 void activate_window(Display *display, Window window_id);
 
+// Frames painted and skipped by update_display() so far
+const RenderFingerprint *get_render_fingerprint(void);
+
 // Switch to a specific tab (handles filtering, placeholder text, display refresh)
 #include "app_data.h"
 void switch_to_tab(AppData *app, TabMode target_tab);
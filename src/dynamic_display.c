@@ -1,6 +1,7 @@
 #include "dynamic_display.h"
 #include "app_data.h"
 #include "log.h"
+#include "results_view.h"
 #include <string.h>
 #include <math.h>
 
@@ -15,8 +16,8 @@ static guint cache_timestamp = 0;
 #define FIXED_MIN_COLUMNS 80
 #define FIXED_MIN_ROWS 8
 
-// Extra pixel budget for non-textview window chrome around the fixed content box:
-// - horizontal: textview margins + window border/shadow slack
+// Extra pixel budget for window chrome around the fixed content box:
+// - horizontal: results view margins + window border/shadow slack
 // - vertical: entry row, tab header/footer separators, and border/shadow slack
 #define FIXED_WINDOW_EXTRA_WIDTH_PX 40
 #define FIXED_WINDOW_EXTRA_HEIGHT_PX 30
@@ -414,9 +415,7 @@ void init_fixed_window_size(struct AppData *app) {
         return;
     }
 
-    gint left_margin = gtk_text_view_get_left_margin(GTK_TEXT_VIEW(tv));
-    gint right_margin = gtk_text_view_get_right_margin(GTK_TEXT_VIEW(tv));
-    gint horizontal_padding = left_margin + right_margin + FIXED_WINDOW_EXTRA_WIDTH_PX;
+    gint horizontal_padding = 2 * RESULTS_VIEW_MARGIN + FIXED_WINDOW_EXTRA_WIDTH_PX;
     gint vertical_padding = FIXED_WINDOW_EXTRA_HEIGHT_PX;
 
     app->fixed_cols = cols;
@@ -479,7 +478,7 @@ gint get_dynamic_max_display_lines(struct AppData *app) {
     return lines;
 }
 
-// Get the number of monospace character columns that fit in the text view
+// Get the number of monospace character columns that fit in the results view
 gint get_display_columns(struct AppData *app) {
     if (app && app->fixed_cols > 0) {
         return app->fixed_cols;
@@ -489,9 +488,7 @@ gint get_display_columns(struct AppData *app) {
 
     GtkWidget *tv = app->textview;
     int widget_width = gtk_widget_get_allocated_width(tv);
-    int left_margin = gtk_text_view_get_left_margin(GTK_TEXT_VIEW(tv));
-    int right_margin = gtk_text_view_get_right_margin(GTK_TEXT_VIEW(tv));
-    int available = widget_width - left_margin - right_margin;
+    int available = widget_width - 2 * RESULTS_VIEW_MARGIN;
 
     // Measure monospace char width via Pango
     PangoContext *context = gtk_widget_get_pango_context(tv);
@@ -89,7 +89,7 @@ gint calculate_max_display_lines(GtkWidget *window, const DynamicDisplayConfig *
 gint get_dynamic_max_display_lines(struct AppData *app);
 
 /**
- * Initialize fixed window sizing from realized textview metrics (one-shot path)
+ * Initialize fixed window sizing from realized results view metrics (one-shot path)
  */
 void init_fixed_window_size(struct AppData *app);
 
@@ -112,7 +112,7 @@ gboolean calculate_fixed_window_grid(gint char_width_px, gint line_height_px,
 void invalidate_display_line_cache(struct AppData *app);
 
 /**
- * Get the number of monospace character columns that fit in the text view
+ * Get the number of monospace character columns that fit in the results view
  */
 gint get_display_columns(struct AppData *app);
 
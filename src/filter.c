@@ -17,17 +17,27 @@
 #include "selection.h"
 #include "x11_utils.h"
 #include "named_window.h"
+#include "window_list.h"
+#include "search_cache.h"
+#include "rank_match.h"
+#include "query_plan.h"
+#include "window_registry.h"
+#include "window_store.h"
+#include "top_k.h"
+#include "dynamic_display.h"
 #include <X11/Xatom.h>
 
 #define UNUSED __attribute__((unused))
 
-// Structure to hold window info with match score
+// Match score for one window; index points into app->windows
 typedef struct {
-    WindowInfo window;
+    int index;
+    Window id;      // Checks `index` when a tail row is copied after the pass
+    int order;      // Position in the history walk, breaks score ties
     score_t score;
 } ScoredWindow;
 
-// Comparison function for qsort
+// Rank order for top_k_sort: best score first, ties in history order
 static int compare_scores(const void *a, const void *b) {
     const ScoredWindow *wa = (const ScoredWindow *)a;
     const ScoredWindow *wb = (const ScoredWindow *)b;
@@ -35,7 +45,7 @@ static int compare_scores(const void *a, const void *b) {
     // -90 is better than -500
     if (wa->score > wb->score) return -1;
     if (wa->score < wb->score) return 1;
-    return 0;
+    return wa->order - wb->order;
 }
 
 // Compose the full display string for a window (same content the user sees)
@@ -59,50 +69,105 @@ static void compose_display_string(const WindowInfo *win, char *out, size_t out_
              desktop_str, display_instance, win->title, display_class);
 }
 
-// Try initials match on the display string
-static score_t try_initials_on_display(const char *filter, const char *display) {
-    int filter_len = strlen(filter);
-    int filter_idx = 0;
-
-    for (int i = 0; display[i] && filter_idx < filter_len; i++) {
-        int at_word_start = (i == 0 || display[i-1] == ' ' || display[i-1] == '-' ||
-                            display[i-1] == '_' || display[i-1] == '.' ||
-                            display[i-1] == '(' || display[i-1] == '|');
-        if (at_word_start && tolower(display[i]) == tolower(filter[filter_idx])) {
-            filter_idx++;
+// Search keys for the windows tab, compiled once per window text
+static SearchCache search_cache;
+
+// Refinement: while each query extends the previous one, the keys scored
+// belong to the same pass and remember whether they matched
+static unsigned refine_pass = 0;
+static char refine_query[FZF_MAX_LEN];  // Lowercased query of the last pass
+
+// Plan of the current query when it uses extended syntax
+static QueryPlan query_plan;
+
+// Query of the last filter_windows() pass, for highlighting its rows
+static char windows_filter[FZF_MAX_LEN];
+
+// Cached search key for a window, compiled on first use or when its text
+// changed; NULL if it could not be compiled
+static SearchKey *search_key_for(const WindowInfo *win) {
+    uint64_t fingerprint = search_key_fingerprint(win);
+    SearchKey *key = search_cache_lookup(&search_cache, win->id, fingerprint);
+    if (key) return key;
+
+    char display[1024];
+    compose_display_string(win, display, sizeof(display));
+    return search_cache_store(&search_cache, win->id, fingerprint, display);
+}
+
+// Drop keys of windows that left the list (only once the cache outgrew it)
+static void prune_search_cache(const AppData *app) {
+    if (search_cache.count <= app->window_count) return;
+
+    for (int i = search_cache.count - 1; i >= 0; i--) {
+        if (find_window_index(app, search_cache.entries[i].id) < 0) {
+            search_cache_forget(&search_cache, search_cache.entries[i].id);
         }
     }
+}
 
-    if (filter_idx == filter_len) {
-        return SCORE_INITIALS_MATCH;
+// Both fzf and initials match a subsequence, so a query extending the
+// previous one can only match keys that one matched. Returns true if the
+// current pass continues; anything else (edits, deletions) starts a new one.
+static bool begin_refinement(const FzfPattern *pattern) {
+    size_t previous_len = strlen(refine_query);
+    bool refine = previous_len > 0 && strncmp(pattern->text, refine_query, previous_len) == 0;
+    if (!refine && ++refine_pass == 0) {
+        refine_pass = 1;  // 0 marks keys never scored
     }
-    return SCORE_MIN;
+    memcpy(refine_query, pattern->text, (size_t)pattern->len + 1);
+    return refine;
 }
 
-// Match a window against filter and return best score
-// Uses fzy on the full display string (what the user sees), plus initials bonus
-static score_t match_window(const char *filter, const WindowInfo *win) {
-    // Compose the same string the user sees
-    char display[1024];
-    compose_display_string(win, display, sizeof(display));
+// Negation and OR terms can accept a longer query after rejecting its
+// prefix, so extended queries never refine; the next plain query starts
+// a new pass
+static void end_refinement(void) {
+    refine_query[0] = '\0';
+}
+
+// Match a window's search key against the filter and return the best score.
+// Uses fzf on the full display string (what the user sees), plus initials bonus
+static score_t match_search_key(const FzfPattern *pattern, SearchKey *key, bool refine) {
+    bool scored_this_pass = refine && key->refine_pass == refine_pass;
+    if (scored_this_pass && !key->refine_matched) {
+        return SCORE_MIN;
+    }
 
-    // Primary: fzf match on full display string
-    score_t best_score = SCORE_MIN;
-    if (fzf_has_match(filter, display)) {
-        best_score = fzf_fuzzy_match(filter, display);
-        log_debug("FZF: '%s' -> '%s' (score: %.0f)", filter, display, best_score);
+    // Primary: fzf match on full display string, resuming at the first
+    // match of the shorter query
+    int start = scored_this_pass ? key->refine_start : 0;
+    score_t best_score = fzf_match_compiled_from(pattern, &key->haystack, &start);
+    if (best_score > SCORE_MIN) {
+        log_debug("FZF: '%s' -> '%s' (score: %.0f)", pattern->text, key->haystack.text, best_score);
     }
+    key->refine_start = best_score > SCORE_MIN ? start : 0;
 
-    // Bonus: initials match (e.g., "ddl" -> "Daniel Dario Lukic")
-    score_t initials = try_initials_on_display(filter, display);
+    // Bonus: initials match
+    score_t initials = rank_initials_score(pattern, key->initials);
     if (initials > best_score) {
         best_score = initials;
-        log_debug("INITIALS: '%s' -> '%s' (score: %.0f)", filter, display, initials);
+        log_debug("INITIALS: '%s' -> '%s' (score: %.0f)", pattern->text, key->haystack.text, initials);
     }
 
+    key->refine_pass = refine_pass;
+    key->refine_matched = best_score > SCORE_MIN;
     return best_score;
 }
 
+// Scratch tables for the filter pipeline. They grow with the window count
+// and are reused on every keystroke. The pipeline moves window IDs and
+// indices into app->windows; a WindowInfo is only copied into
+// app->filtered once its row is ranked, so a pass copies about a screen
+// and a page of rows however many windows match.
+static Window *reorder_scratch = NULL;
+static int reorder_capacity = 0;
+static gboolean *placed = NULL;
+static int placed_capacity = 0;
+static ScoredWindow *scored_scratch = NULL;
+static int scored_capacity = 0;
+static AppData *unordered_app = NULL;     // App whose unordered tail scored_scratch still holds
+static WindowRegistry history_positions;  // Window ID -> index in app->history
 
 // Reorder app->history to match _NET_CLIENT_LIST_STACKING (top-of-stack first)
 static void apply_native_stacking_order(AppData *app) {
@@ -120,30 +185,37 @@ static void apply_native_stacking_order(AppData *app) {
         return;
     }
 
+    if (!GROW_ARRAY(reorder_scratch, reorder_capacity, app->history_count) ||
+        !GROW_ARRAY(placed, placed_capacity, app->history_count)) {
+        XFree(prop);
+        return;
+    }
+
     Window *stack = (Window *)prop;
-    WindowInfo new_order[MAX_WINDOWS];
+    Window *new_order = reorder_scratch;
     int new_count = 0;
 
+    window_registry_clear(&history_positions);
+    for (int j = 0; j < app->history_count; j++) {
+        window_registry_put(&history_positions, app->history[j], j);
+        placed[j] = FALSE;
+    }
+
     // Stack is bottom-to-top; we want top-to-bottom (top = most recently raised first)
-    for (long i = (long)n_items - 1; i >= 0 && new_count < MAX_WINDOWS; i--) {
-        for (int j = 0; j < app->history_count; j++) {
-            if (app->history[j].id == stack[i]) {
-                new_order[new_count++] = app->history[j];
-                break;
-            }
+    for (long i = (long)n_items - 1; i >= 0; i--) {
+        int j = window_registry_get(&history_positions, stack[i]);
+        if (j >= 0 && !placed[j]) {
+            new_order[new_count++] = app->history[j];
+            placed[j] = TRUE;
         }
     }
 
     // Copy any windows not in the stacking list (shouldn't happen, but be safe)
-    for (int j = 0; j < app->history_count && new_count < MAX_WINDOWS; j++) {
-        int found = 0;
-        for (int k = 0; k < new_count; k++) {
-            if (new_order[k].id == app->history[j].id) { found = 1; break; }
-        }
-        if (!found) new_order[new_count++] = app->history[j];
+    for (int j = 0; j < app->history_count; j++) {
+        if (!placed[j]) new_order[new_count++] = app->history[j];
     }
 
-    for (int i = 0; i < new_count; i++) app->history[i] = new_order[i];
+    memcpy(app->history, new_order, sizeof(Window) * (size_t)new_count);
     app->history_count = new_count;
 
     XFree(prop);
@@ -162,44 +234,57 @@ static void prepare_windows_for_filtering(AppData *app) {
         partition_and_reorder(app);
     }
 
-    // Second, update window titles to include custom names for filtering
-    for (int i = 0; i < app->history_count; i++) {
-        const char *custom_name = get_window_custom_name(&app->names, app->history[i].id);
-        if (custom_name) {
-            // Store original title and create modified title for filtering
-            char original_title[MAX_TITLE_LEN];
-            strncpy(original_title, app->history[i].title, sizeof(original_title) - 1);
-            original_title[sizeof(original_title) - 1] = '\0';
-
-            // Format as "custom_name - original_title"
-            snprintf(app->history[i].title, sizeof(app->history[i].title), "%s - %s", custom_name, original_title);
-        }
-    }
-
     log_trace("After pipeline - history_count=%d", app->history_count);
 }
 
-// Score and filter windows based on search text
-static int score_and_filter_windows(AppData *app, const char *filter, 
-                                   const WindowInfo *windows, int window_count,
+// Window as matched and displayed: named windows show "custom_name - title".
+// Returns the canonical entry, or `named` filled with the combined title.
+static const WindowInfo *window_for_display(const AppData *app, int index, WindowInfo *named) {
+    const WindowInfo *win = &app->windows[index];
+    const char *custom_name = get_window_custom_name(&app->names, win->id);
+    if (!custom_name) return win;
+
+    *named = *win;
+    snprintf(named->title, sizeof(named->title), "%s - %s", custom_name, win->title);
+    return named;
+}
+
+// Score and filter windows based on search text, walking history order
+static int score_and_filter_windows(AppData *app, const char *filter,
                                    ScoredWindow *scored_windows) {
     int scored_count = 0;
     int current_desktop = get_current_desktop(app->display);
+    WindowInfo named;
+    FzfPattern pattern;
+    bool extended = query_plan_parse(&query_plan, filter);
+    bool refine = false;
+    if (extended) {
+        end_refinement();
+    } else {
+        fzf_pattern_compile(&pattern, filter);
+        refine = begin_refinement(&pattern);
+    }
     
     // Filter and score windows
-    for (int i = 0; i < window_count; i++) {
-        const WindowInfo *win = &windows[i];
+    for (int i = 0; i < app->history_count; i++) {
+        int index = find_window_index(app, app->history[i]);
+        if (index < 0) continue;
         
         if (strlen(filter) == 0) {
             // No filter - include all windows with max score
-            if (scored_count < MAX_WINDOWS) {
-                scored_windows[scored_count].window = *win;
-                scored_windows[scored_count].score = 1000; // Max score for no filter
-                scored_count++;
-            }
+            scored_windows[scored_count].index = index;
+            scored_windows[scored_count].id = app->history[i];
+            scored_windows[scored_count].order = scored_count;
+            scored_windows[scored_count].score = 1000; // Max score for no filter
+            scored_count++;
         } else {
-            // Use the match_window function for all matching logic
-            score_t best_score = match_window(filter, win);
+            const WindowInfo *win = window_for_display(app, index, &named);
+            SearchKey *key = search_key_for(win);
+            if (!key) continue;
+
+            score_t best_score = extended
+                ? query_plan_match(&query_plan, win, &key->haystack)
+                : match_search_key(&pattern, key, refine);
             
             // Add workspace bonus if window is on current workspace
             if (best_score > SCORE_MIN && win->desktop == current_desktop && win->desktop != -1) {
@@ -213,12 +298,12 @@ static int score_and_filter_windows(AppData *app, const char *filter,
             
             // Add to scored list if we have a match
             if (best_score > SCORE_MIN) {
-                if (scored_count < MAX_WINDOWS) {
-                    scored_windows[scored_count].window = *win;
-                    scored_windows[scored_count].score = best_score;
-                    scored_count++;
-                    log_debug("Window '%s' matched with final score: %f", win->title, best_score);
-                }
+                scored_windows[scored_count].index = index;
+                scored_windows[scored_count].id = app->history[i];
+                scored_windows[scored_count].order = scored_count;
+                scored_windows[scored_count].score = best_score;
+                scored_count++;
+                log_debug("Window '%s' matched with final score: %f", win->title, best_score);
             }
         }
     }
@@ -226,29 +311,65 @@ static int score_and_filter_windows(AppData *app, const char *filter,
     return scored_count;
 }
 
-// Sort scored windows by score (highest first)
-static void sort_scored_windows(ScoredWindow *scored_windows, int count, const char *filter) {
+// Rows ranked and copied per pass: what fits on screen plus a page to
+// scroll into. The rest wait in scored_scratch until
+// ensure_filtered_order() needs them.
+static int ranked_rows_per_pass(AppData *app) {
+    int lines = get_dynamic_max_display_lines(app);
+    return lines > 0 ? lines * 2 : 1;
+}
+
+// Sort the best scored windows by score (highest first); returns how many
+// lead the array in rank order, the rest follow unordered. Without a
+// filter every score ties and the array already is in display order.
+static int sort_scored_windows(AppData *app, ScoredWindow *scored_windows, int count,
+                               const char *filter) {
+    int ranked = ranked_rows_per_pass(app);
+    if (ranked > count) ranked = count;
     if (strlen(filter) > 0 && count > 0) {
-        qsort(scored_windows, count, sizeof(ScoredWindow), compare_scores);
+        top_k_sort(scored_windows, (size_t)count, sizeof(ScoredWindow), (size_t)ranked,
+                   compare_scores);
         
         // Debug: print sorted results
         log_debug("=== Sorted results for filter '%s' ===", filter);
-        for (int i = 0; i < count && i < 5; i++) {
-            log_debug("%d: %s (score: %f)", i, scored_windows[i].window.title, scored_windows[i].score);
+        for (int i = 0; i < ranked && i < 5; i++) {
+            log_debug("%d: %s (score: %f)", i, app->windows[scored_windows[i].index].title,
+                      scored_windows[i].score);
         }
         log_debug("=====================================");
     }
+    return ranked;
 }
 
-// Finalize filter results by copying to app's filtered array
-static void finalize_filter_results(AppData *app, const ScoredWindow *scored_windows, int count) {
-    app->filtered_count = 0;
-    
-    // Copy sorted windows to filtered array
-    for (int i = 0; i < count && i < MAX_WINDOWS; i++) {
-        app->filtered[i] = scored_windows[i].window;
-        app->filtered_count++;
+// Copy the ranked rows [from, to) of scored_scratch into app->filtered,
+// the by-value snapshot that display, selection and commands read. A row
+// whose window moved in app->windows since the pass is found by ID; one
+// whose window is gone ends the list there until the next pass.
+static int copy_ranked_rows(AppData *app, int from, int to) {
+    for (int i = from; i < to; i++) {
+        const ScoredWindow *row = &scored_scratch[i];
+        int index = row->index;
+        if (index >= app->window_count || app->windows[index].id != row->id) {
+            index = find_window_index(app, row->id);
+        }
+        if (index < 0) {
+            app->filtered_count = i;
+            app->filtered_unordered = 0;
+            return i;
+        }
+        WindowInfo named;
+        app->filtered[i] = *window_for_display(app, index, &named);
     }
+    return to;
+}
+
+// Finalize filter results: only the ranked rows are copied, the others
+// wait in scored_scratch for ensure_filtered_order()
+static void finalize_filter_results(AppData *app, int ranked, int count) {
+    app->filtered_count = count;
+    app->filtered_unordered = count - ranked;
+    unordered_app = app;
+    copy_ranked_rows(app, 0, ranked);
     
     // Don't reset selection here - it will be handled by the caller
     // to preserve the selected window by ID
@@ -257,6 +378,7 @@ static void finalize_filter_results(AppData *app, const ScoredWindow *scored_win
 // Filter windows based on search text (now works with history-ordered windows)
 void filter_windows(AppData *app, const char *filter) {
     log_trace("filter_windows() called with filter='%s'", filter);
+    snprintf(windows_filter, sizeof(windows_filter), "%s", filter);
 
     // Preserve current selection
     preserve_selection(app);
@@ -266,45 +388,54 @@ void filter_windows(AppData *app, const char *filter) {
 
 
     // Step 2: Score and filter windows directly from history
-    ScoredWindow scored_windows[MAX_WINDOWS];
-    int scored_count = score_and_filter_windows(app, filter, app->history, 
-                                               app->history_count, scored_windows);
-    
-    // Step 3: Sort by score
-    sort_scored_windows(scored_windows, scored_count, filter);
+    if (!GROW_ARRAY(scored_scratch, scored_capacity, app->history_count)) {
+        app->filtered_count = 0;
+        app->filtered_unordered = 0;
+        return;
+    }
+    int scored_count = score_and_filter_windows(app, filter, scored_scratch);
+    prune_search_cache(app);
     
-    // Step 4: Finalize results
-    finalize_filter_results(app, scored_windows, scored_count);
+    // Step 3: Sort the visible part by score
+    int ranked = sort_scored_windows(app, scored_scratch, scored_count, filter);
     
-    // Step 4.1: Push Special windows to the end (only when not filtering)
-    // When filtering, score-based ordering should be respected
-    if (app->filtered_count > 0 && strlen(filter) == 0) {
-        WindowInfo normal_windows[MAX_WINDOWS];
-        WindowInfo special_windows[MAX_WINDOWS];
+    // Step 4: Display order. When not filtering, push Special windows to
+    // the end; when filtering, score-based ordering should be respected
+    if (strlen(filter) == 0) {
         int normal_count = 0;
         int special_count = 0;
         
-        // Separate Normal and Special windows
-        for (int i = 0; i < app->filtered_count; i++) {
-            if (strcmp(app->filtered[i].type, "Normal") == 0) {
-                normal_windows[normal_count++] = app->filtered[i];
-            } else {
-                special_windows[special_count++] = app->filtered[i];
+        // Renumber in display order, which also keeps the tail in that
+        // order when it is ranked later
+        for (int i = 0; i < scored_count; i++) {
+            if (strcmp(app->windows[scored_scratch[i].index].type, "Normal") == 0) {
+                scored_scratch[i].order = normal_count++;
             }
         }
-        
-        // Rebuild filtered array with Normal windows first, then Special
-        int idx = 0;
-        for (int i = 0; i < normal_count; i++) {
-            app->filtered[idx++] = normal_windows[i];
-        }
-        for (int i = 0; i < special_count; i++) {
-            app->filtered[idx++] = special_windows[i];
+        for (int i = 0; i < scored_count; i++) {
+            if (strcmp(app->windows[scored_scratch[i].index].type, "Normal") != 0) {
+                scored_scratch[i].order = normal_count + special_count++;
+            }
         }
         
         log_trace("Separated windows: %d Normal, %d Special", normal_count, special_count);
+
+        // Move every row to its display position
+        for (int i = 0; i < scored_count; i++) {
+            int j = scored_scratch[i].order;
+            while (j != i) {
+                ScoredWindow moved = scored_scratch[j];
+                scored_scratch[j] = scored_scratch[i];
+                scored_scratch[i] = moved;
+                j = scored_scratch[i].order;
+            }
+        }
     }
 
+    // Step 4.1: Publish the ranked rows; the rest keep their scored_scratch
+    // slot so ensure_filtered_order() can rank and copy them later
+    finalize_filter_results(app, ranked, scored_count);
+
     // Step 5: Restore and validate selection
     restore_selection(app);
     validate_selection(app);
@@ -313,6 +444,60 @@ void filter_windows(AppData *app, const char *filter) {
     apply_alt_tab_selection(app, filter);
 }
 
+const char *get_windows_filter(void) {
+    return windows_filter;
+}
+
+// Rank the unordered tail until the first `count` rows of app->filtered
+// are in order, copying only the rows that got ranked. Ranks at least
+// another pass worth of rows at a time so scrolling down does not sort
+// once per row.
+void ensure_filtered_order(AppData *app, int count) {
+    if (!app || app->filtered_unordered <= 0) return;
+    int ordered = app->filtered_count - app->filtered_unordered;
+    if (app != unordered_app) {
+        // scored_scratch belongs to another app; its tail is lost
+        log_warn("Filtered rows of a stale filter pass dropped");
+        app->filtered_count = ordered;
+        app->filtered_unordered = 0;
+        return;
+    }
+    if (count <= ordered) return;
+
+    int tail = app->filtered_unordered;
+    int extend = count - ordered;
+    int per_pass = ranked_rows_per_pass(app);
+    if (extend < per_pass) extend = per_pass;
+    if (extend > tail) extend = tail;
+
+    top_k_sort(scored_scratch + ordered, (size_t)tail, sizeof(ScoredWindow), (size_t)extend,
+               compare_scores);
+    app->filtered_unordered = tail - extend;
+    copy_ranked_rows(app, ordered, ordered + extend);
+    log_trace("Ranked filtered rows %d..%d of %d", ordered, ordered + extend, app->filtered_count);
+}
+
+// Row of window `id` in app->filtered, or -1. A hit in the unordered tail
+// ranks the whole tail first so the returned row is final.
+int find_filtered_row(AppData *app, Window id) {
+    if (!app) return -1;
+    int ordered = app->filtered_count - app->filtered_unordered;
+    for (int i = 0; i < ordered; i++) {
+        if (app->filtered[i].id == id) return i;
+    }
+    if (app != unordered_app) return -1;
+
+    for (int i = ordered; i < app->filtered_count; i++) {
+        if (scored_scratch[i].id != id) continue;
+        ensure_filtered_order(app, app->filtered_count);
+        for (int j = ordered; j < app->filtered_count; j++) {
+            if (app->filtered[j].id == id) return j;
+        }
+        return -1;
+    }
+    return -1;
+}
+
 // Apply alt-tab selection: set selection to index 1 when conditions are met
 void apply_alt_tab_selection(AppData *app, const char *filter) {
     if (!app || app->current_tab != TAB_WINDOWS) return;
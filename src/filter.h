@@ -1,6 +1,8 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+#include <X11/X.h>
+
 // Forward declaration (avoid duplicate typedef)
 #ifndef APPDATA_TYPEDEF_DEFINED
 #define APPDATA_TYPEDEF_DEFINED
@@ -10,6 +12,14 @@ typedef struct AppData AppData;
 // Filter windows based on search text
 void filter_windows(AppData *app, const char *filter);
 
+// filter_windows() ranks only the rows near the top; these rank the rest
+// on demand. Call before reading app->filtered past the first screen.
+void ensure_filtered_order(AppData *app, int count);
+int find_filtered_row(AppData *app, Window id);
+
+// Query app->filtered was last filtered with
+const char *get_windows_filter(void);
+
 // Filter config options based on search text
 void filter_config(AppData *app, const char *filter);
 
@@ -1,14 +1,26 @@
 #include "app_data.h"
 #include "named_window.h"
-#include "match.h"
+#include "rank_match.h"
 #include "log.h"
+#include "window_store.h"
 #include <string.h>
 #include <stdio.h>
 
-// Filter named windows based on search text
+// Custom names rank above the title they replaced, both above class/instance
+#define NAME_WEIGHT_CUSTOM 200
+#define NAME_WEIGHT_TITLE  100
+
+static RankCache name_candidates;
+static RankedMatch *ranked_names = NULL;
+static int ranked_names_capacity = 0;
+
+// Filter named windows based on search text, best match first
 void filter_names(AppData *app, const char *filter) {
     app->filtered_names_count = 0;
-    
+    if (!GROW_ARRAY(app->filtered_names, app->filtered_names_capacity, app->names.count)) {
+        return;
+    }
+
     if (!filter || !*filter) {
         // No filter - show all named windows
         for (int i = 0; i < app->names.count; i++) {
@@ -17,21 +29,27 @@ void filter_names(AppData *app, const char *filter) {
         }
         return;
     }
-    
-    // Build searchable string for each named window
-    char searchable[1024];
+
+    if (!GROW_ARRAY(ranked_names, ranked_names_capacity, app->names.count)) {
+        return;
+    }
+
     for (int i = 0; i < app->names.count; i++) {
         NamedWindow *entry = &app->names.entries[i];
-        
-        // Build searchable string: "custom_name original_title class instance"
-        snprintf(searchable, sizeof(searchable), "%s %s %s %s",
-                 entry->custom_name, entry->original_title, 
-                 entry->class_name, entry->instance);
-        
-        // Use has_match for filtering
-        if (has_match(filter, searchable)) {
-            app->filtered_names[app->filtered_names_count] = *entry;
-            app->filtered_names_count++;
-        }
+        RankField fields[] = {
+            { entry->custom_name,    NAME_WEIGHT_CUSTOM, 1 },
+            { entry->original_title, NAME_WEIGHT_TITLE,  1 },
+            { entry->class_name,     0,                  0 },
+            { entry->instance,       0,                  0 },
+        };
+        rank_cache_update(&name_candidates, i, fields, 4);
+    }
+
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, filter);
+    int matched = rank_cache_rank(&name_candidates, app->names.count, &pattern,
+                                  app->names.count, ranked_names);
+    for (int i = 0; i < matched; i++) {
+        app->filtered_names[app->filtered_names_count++] = app->names.entries[ranked_names[i].index];
     }
-}
\ No newline at end of file
+}
@@ -15,8 +15,14 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <glib.h>
 
 #include "fzf_algo.h"
+#include "simd_scan.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /* --- Scoring constants (from fzf algo.go) --- */
 
@@ -45,9 +51,6 @@
 /* First character bonus multiplier */
 #define BONUS_FIRST_CHAR_MULTIPLIER 2
 
-/* Maximum haystack/needle length we handle */
-#define FZF_MAX_LEN 1024
-
 /* --- Character classification (from fzf algo.go) --- */
 
 typedef enum {
@@ -69,7 +72,6 @@ static const char *white_chars = " \t\n\v\f\r";
 
 static char_class_t ascii_char_classes[128];
 static int16_t bonus_matrix[CHAR_CLASS_COUNT][CHAR_CLASS_COUNT];
-static int fzf_initialized = 0;
 
 /* Compute bonus for a transition from prev_class to class */
 static int16_t bonus_for(char_class_t prev_class, char_class_t class) {
@@ -106,8 +108,11 @@ static int16_t bonus_for(char_class_t prev_class, char_class_t class) {
     return 0;
 }
 
+/* Fill the tables once; matching runs on worker threads too (name_scorer.c),
+ * so the first callers may race here */
 static void fzf_init(void) {
-    if (fzf_initialized)
+    static gsize initialized = 0;
+    if (!g_once_init_enter(&initialized))
         return;
 
     for (int i = 0; i < 128; i++) {
@@ -133,7 +138,7 @@ static void fzf_init(void) {
         }
     }
 
-    fzf_initialized = 1;
+    g_once_init_leave(&initialized, 1);
 }
 
 static inline char_class_t char_class_of(unsigned char c) {
@@ -159,127 +164,58 @@ int fzf_has_match(const char *needle, const char *haystack) {
     if (!haystack)
         return 0;
 
+    /* tolower() only folds ASCII letters byte-wise, so the bytes that
+     * lower to nc are nc itself and toupper(nc) */
     for (const char *np = needle; *np; np++) {
-        char nc = tolower((unsigned char)*np);
-        while (*haystack) {
-            if (tolower((unsigned char)*haystack) == nc) {
-                haystack++;
-                goto next_char;
-            }
-            haystack++;
-        }
-        return 0;
-next_char:;
+        char nc = (char)tolower((unsigned char)*np);
+        haystack = simd_find_either(haystack, nc, (char)toupper((unsigned char)nc));
+        if (!haystack)
+            return 0;
+        haystack++;
     }
     return 1;
 }
 
 /*
- * FuzzyMatchV2 port - the core algorithm.
- *
- * This is a modified Smith-Waterman that finds the optimal fuzzy match.
- * Key property: scores are floored at 0, so long strings don't accumulate
- * deeply negative gap penalties.
+ * Rows 1..M-1 of the score matrix: what phase 2 hands to a row kernel.
+ * A kernel returns the best score of the last row, or -1 if it ran out
+ * of memory.
  */
-score_t fzf_fuzzy_match(const char *needle, const char *haystack) {
-    fzf_init();
-
-    if (!needle || !haystack)
-        return SCORE_MIN;
-
-    int M = (int)strlen(needle);
-    if (M == 0)
-        return 0;
-
-    int N = (int)strlen(haystack);
-    if (M > N)
-        return SCORE_MIN;
-
-    if (N > FZF_MAX_LEN || M > FZF_MAX_LEN)
-        return SCORE_MIN;
-
-    /*
-     * Phase 1: Quick subsequence check + find first/last occurrence indices.
-     * Also lowercase the text and needle into working buffers.
-     */
-    char lower_needle[FZF_MAX_LEN];
-    for (int i = 0; i < M; i++)
-        lower_needle[i] = tolower((unsigned char)needle[i]);
-
-    char T[FZF_MAX_LEN];       /* lowercased haystack */
-    int16_t B[FZF_MAX_LEN];    /* bonus for each position */
-    int16_t H0[FZF_MAX_LEN];   /* score matrix row 0 */
-    int16_t C0[FZF_MAX_LEN];   /* consecutive count row 0 */
-    int F[FZF_MAX_LEN];        /* first occurrence of each pattern char */
+typedef struct {
+    const char *needle;     /* lowercased pattern */
+    int M;
+    const char *T;          /* lowercased haystack */
+    const int16_t *B;       /* its bonus vector */
+    const int *F;           /* first occurrence of each pattern char */
+    int f0;                 /* F[0]; columns before it score 0 */
+    int width;              /* columns F[0] .. last match of the last char */
+    const int16_t *H0;      /* row 0, indexed by haystack position */
+    const int16_t *C0;
+} FzfRows;
+
+typedef int16_t (*FzfRowKernel)(const FzfRows *rows);
 
-    /*
-     * Phase 2: Calculate bonus for each position, find first occurrences,
-     * and fill in row 0 of the score matrix.
-     */
-    int pidx = 0, last_idx = 0;
-    char pchar0 = lower_needle[0];
-    char pchar = pchar0;
-    int16_t prev_H0 = 0;
-    char_class_t prev_class = INITIAL_CHAR_CLASS;
-    int in_gap = 0;
+/*
+ * Phase 3: Fill in the score matrix (H) for remaining pattern rows.
+ *
+ * We only need to consider positions from F[0] to last_idx.
+ * The matrix is logically M rows x width columns.
+ *
+ * Scalar version, one cell at a time: the reference the vector kernel is
+ * checked against, and the kernel on targets without SSE2.
+ */
+static int16_t fill_rows_scalar(const FzfRows *rows) {
+    const char *lower_needle = rows->needle;
+    int M = rows->M;
+    const char *T = rows->T;
+    const int16_t *B = rows->B;
+    const int *F = rows->F;
+    int f0 = rows->f0;
+    int width = rows->width;
+    const int16_t *H0 = rows->H0;
+    const int16_t *C0 = rows->C0;
     int16_t max_score = 0;
-
-    for (int i = 0; i < N; i++) {
-        unsigned char uc = (unsigned char)haystack[i];
-        char_class_t class = char_class_of(uc);
-        char ch = tolower(uc);
-
-        T[i] = ch;
-        B[i] = bonus_matrix[prev_class][class];
-        prev_class = class;
-
-        if (ch == pchar) {
-            if (pidx < M) {
-                F[pidx] = i;
-                pidx++;
-                pchar = (pidx < M) ? lower_needle[pidx] : 0;
-            }
-            last_idx = i;
-        }
-
-        if (ch == pchar0) {
-            int16_t score = SCORE_MATCH + B[i] * BONUS_FIRST_CHAR_MULTIPLIER;
-            H0[i] = score;
-            C0[i] = 1;
-            if (M == 1 && score > max_score) {
-                max_score = score;
-                if (B[i] >= BONUS_BOUNDARY)
-                    break;
-            }
-            in_gap = 0;
-        } else {
-            if (in_gap) {
-                H0[i] = max16(prev_H0 + SCORE_GAP_EXTENSION, 0);
-            } else {
-                H0[i] = max16(prev_H0 + SCORE_GAP_START, 0);
-            }
-            C0[i] = 0;
-            in_gap = 1;
-        }
-        prev_H0 = H0[i];
-    }
-
-    /* No match if we didn't find all pattern characters */
-    if (pidx != M)
-        return SCORE_MIN;
-
-    /* Single character pattern: done */
-    if (M == 1)
-        return (score_t)max_score;
-
-    /*
-     * Phase 3: Fill in the score matrix (H) for remaining pattern rows.
-     *
-     * We only need to consider positions from F[0] to last_idx.
-     * The matrix is logically M rows x width columns.
-     */
-    int f0 = F[0];
-    int width = last_idx - f0 + 1;
+    int in_gap;
 
     /* Allocate the DP matrices on the stack if small enough, else heap */
     int16_t H_static[FZF_MAX_LEN * 32];  /* good for patterns up to 32 chars */
@@ -296,7 +232,7 @@ score_t fzf_fuzzy_match(const char *needle, const char *haystack) {
         if (!H || !C) {
             free(H);
             free(C);
-            return SCORE_MIN;
+            return -1;
         }
         heap_alloc = 1;
     }
@@ -374,5 +310,386 @@ score_t fzf_fuzzy_match(const char *needle, const char *haystack) {
         free(C);
     }
 
-    return (score_t)max_score;
+    return max_score;
+}
+
+#if defined(__SSE2__)
+
+/*
+ * Vector kernel, 8 columns per step.
+ *
+ * Along a row, the gap term is the one serial dependency:
+ *   s2[j] = P[j-1],  P[j] = s1[j] >= s2[j] ? s1[j] - 3 : s2[j] - 1
+ * where s1 is the match candidate (0 where the char does not match) and
+ * H[j] = max(s1[j], s2[j], 0). The branch fzf takes when s1 + b < s2 only
+ * changes the consecutive count, not the score, so s1 can be taken with
+ * its consecutive bonus throughout.
+ *
+ * With Q[j] = P[j] + j and R[j] = s1[j] - 3 + j that becomes
+ *   Q[j] = Q[j-1] <= R[j] + 2 ? R[j] : Q[j-1]
+ * Each step is q -> (q <= T ? C : q), and those compose associatively:
+ *   (T1, C1) then (T2, C2) = (max(T1, T2), C1 <= T2 ? C2 : C1)
+ * so a log-step prefix scan gives the whole block from the previous
+ * block's carry, with the same int16 values as the scalar loop.
+ *
+ * Instead of reading B at the start of each consecutive run (a gather),
+ * the kernel carries that bonus along the diagonal in its own row (Fb).
+ */
+
+#define FZF_LANES 8
+
+/* Column c of a row is stored at [c + 1]; [0] is the column left of the
+ * first, so the diagonal of column c is always at [c] */
+#define FZF_ROW_CAP (FZF_MAX_LEN + 1 + FZF_LANES)
+
+/* Per-thread scratch: two rows of each matrix plus a padded copy of the
+ * matched stretch of the haystack. Fixed size, since N <= FZF_MAX_LEN. */
+typedef struct {
+    int16_t H[2][FZF_ROW_CAP];
+    int16_t C[2][FZF_ROW_CAP];
+    int16_t Fb[2][FZF_ROW_CAP];     /* bonus at the start of the run */
+    uint8_t T[FZF_MAX_LEN + FZF_LANES];
+    int16_t B[FZF_MAX_LEN + FZF_LANES];
+} FzfArena;
+
+static _Thread_local FzfArena fzf_arena;
+
+static inline __m128i blend16(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* Combine each lane with the lane `shift` to its left; lanes without one
+ * take the identity (-32768, -32768) */
+#define FZF_SCAN_STEP(Tv, Cv, shift, fill) do {                          \
+        __m128i tl = _mm_or_si128(_mm_slli_si128(Tv, 2 * (shift)), fill); \
+        __m128i cl = _mm_or_si128(_mm_slli_si128(Cv, 2 * (shift)), fill); \
+        Cv = blend16(_mm_cmpgt_epi16(cl, Tv), cl, Cv);                    \
+        Tv = _mm_max_epi16(tl, Tv);                                       \
+    } while (0)
+
+static int16_t fill_rows_sse2(const FzfRows *rows) {
+    FzfArena *arena = &fzf_arena;
+    int M = rows->M;
+    int f0 = rows->f0;
+    int width = rows->width;
+
+    for (int c = 0; c < width; c++) {
+        arena->T[c] = (uint8_t)rows->T[f0 + c];
+        arena->B[c] = rows->B[f0 + c];
+        arena->H[0][c + 1] = rows->H0[f0 + c];
+        arena->C[0][c + 1] = rows->C0[f0 + c];
+        arena->Fb[0][c + 1] = rows->B[f0 + c];
+    }
+    /* Lanes past the last column never match (pattern chars are not 0) */
+    memset(arena->T + width, 0, FZF_LANES);
+    memset(arena->B + width, 0, FZF_LANES * sizeof(int16_t));
+    arena->H[0][0] = arena->H[1][0] = 0;
+    arena->C[0][0] = arena->C[1][0] = 0;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lane = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i match_score = _mm_set1_epi16(SCORE_MATCH);
+    const __m128i gap_start = _mm_set1_epi16(SCORE_GAP_START);
+    const __m128i boundary_min = _mm_set1_epi16(BONUS_BOUNDARY - 1);
+    const __m128i consecutive_bonus = _mm_set1_epi16(BONUS_CONSECUTIVE);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i fill1 = _mm_setr_epi16(INT16_MIN, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i fill2 = _mm_setr_epi16(INT16_MIN, INT16_MIN, 0, 0, 0, 0, 0, 0);
+    const __m128i fill4 = _mm_setr_epi16(INT16_MIN, INT16_MIN, INT16_MIN, INT16_MIN, 0, 0, 0, 0);
+    __m128i best = zero;
+
+    for (int i = 1; i < M; i++) {
+        const int16_t *Hp = arena->H[(i - 1) & 1];
+        const int16_t *Cp = arena->C[(i - 1) & 1];
+        const int16_t *Fp = arena->Fb[(i - 1) & 1];
+        int16_t *H = arena->H[i & 1];
+        int16_t *C = arena->C[i & 1];
+        int16_t *Fb = arena->Fb[i & 1];
+        const __m128i pc = _mm_set1_epi16((uint8_t)rows->needle[i]);
+        int first = rows->F[i] - f0;   /* > 0: F is strictly increasing */
+        int last_row = i == M - 1;
+
+        for (int c = 0; c < first; c++) {
+            H[c + 1] = 0;
+            C[c + 1] = 0;
+        }
+
+        /* P of the column left of `first`: a zeroed cell, not in a gap */
+        int16_t carry = SCORE_GAP_START;
+
+        for (int c = first; c < width; c += FZF_LANES) {
+            __m128i t = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(arena->T + c)), zero);
+            __m128i match = _mm_cmpeq_epi16(t, pc);
+            __m128i b = _mm_loadu_si128((const __m128i *)(arena->B + c));
+            __m128i hd = _mm_loadu_si128((const __m128i *)(Hp + c));
+            __m128i cd = _mm_loadu_si128((const __m128i *)(Cp + c));
+            __m128i fbd = _mm_loadu_si128((const __m128i *)(Fp + c));
+
+            /* Consecutive bonus, or a new run at a stronger boundary */
+            __m128i cont = _mm_cmpgt_epi16(cd, zero);
+            __m128i restart = _mm_and_si128(cont, _mm_and_si128(_mm_cmpgt_epi16(b, boundary_min),
+                                                                 _mm_cmpgt_epi16(b, fbd)));
+            __m128i extend = _mm_andnot_si128(restart, cont);
+            __m128i b_run = _mm_max_epi16(_mm_max_epi16(b, consecutive_bonus), fbd);
+            __m128i bonus = blend16(extend, b_run, b);
+            __m128i consecutive = blend16(restart, one, _mm_add_epi16(cd, one));
+            __m128i s1 = _mm_and_si128(match, _mm_add_epi16(_mm_add_epi16(hd, match_score), bonus));
+
+            /* Gap term: prefix scan of (T, C) = (R + 2, R), then the carry */
+            __m128i r = _mm_add_epi16(_mm_add_epi16(s1, gap_start), lane);
+            __m128i tv = _mm_add_epi16(r, two);
+            __m128i cv = r;
+            FZF_SCAN_STEP(tv, cv, 1, fill1);
+            FZF_SCAN_STEP(tv, cv, 2, fill2);
+            FZF_SCAN_STEP(tv, cv, 4, fill4);
+            __m128i q_in = _mm_set1_epi16((int16_t)(carry - 1));
+            __m128i q = blend16(_mm_cmpgt_epi16(q_in, tv), q_in, cv);
+            __m128i q_left = _mm_insert_epi16(_mm_slli_si128(q, 2), carry - 1, 0);
+            __m128i s2 = _mm_add_epi16(_mm_sub_epi16(q_left, lane), one);
+
+            __m128i score = _mm_max_epi16(_mm_max_epi16(s1, s2), zero);
+            __m128i kept = _mm_andnot_si128(_mm_cmpgt_epi16(s2, s1), consecutive);
+            _mm_storeu_si128((__m128i *)(H + c + 1), score);
+            _mm_storeu_si128((__m128i *)(C + c + 1), _mm_and_si128(match, kept));
+            _mm_storeu_si128((__m128i *)(Fb + c + 1), blend16(extend, fbd, b));
+
+            if (last_row) {
+                int valid = width - c < FZF_LANES ? width - c : FZF_LANES;
+                __m128i in_row = _mm_cmpgt_epi16(_mm_set1_epi16((int16_t)valid), lane);
+                best = _mm_max_epi16(best, _mm_and_si128(in_row, score));
+            }
+            carry = (int16_t)(_mm_extract_epi16(q, FZF_LANES - 1) - (FZF_LANES - 1));
+        }
+    }
+
+    /* Horizontal max of the last row */
+    best = _mm_max_epi16(best, _mm_srli_si128(best, 8));
+    best = _mm_max_epi16(best, _mm_srli_si128(best, 4));
+    best = _mm_max_epi16(best, _mm_srli_si128(best, 2));
+    return (int16_t)_mm_extract_epi16(best, 0);
+}
+
+#define FZF_ROW_KERNEL fill_rows_sse2
+
+#else
+
+#define FZF_ROW_KERNEL fill_rows_scalar
+
+#endif /* __SSE2__ */
+
+/*
+ * FuzzyMatchV2 port - the core algorithm.
+ *
+ * This is a modified Smith-Waterman that finds the optimal fuzzy match.
+ * Key property: scores are floored at 0, so long strings don't accumulate
+ * deeply negative gap penalties.
+ *
+ * Works on a lowercased needle and a lowercased haystack T with its bonus
+ * vector B already computed (see fzf_haystack_compile()).
+ */
+static score_t match_lowered_with(FzfRowKernel kernel, const char *lower_needle, int M,
+                                  const char *T, const int16_t *B, int N,
+                                  int start, int *first_pos) {
+    if (M == 0)
+        return 0;
+    if (M > N)
+        return SCORE_MIN;
+    if (N > FZF_MAX_LEN || M > FZF_MAX_LEN)
+        return SCORE_MIN;
+
+    int16_t H0[FZF_MAX_LEN];   /* score matrix row 0 */
+    int16_t C0[FZF_MAX_LEN];   /* consecutive count row 0 */
+    int F[FZF_MAX_LEN];        /* first occurrence of each pattern char */
+    F[0] = start;              /* set again by the first match */
+
+    /*
+     * Phase 2: Find first occurrences and fill in row 0 of the score
+     * matrix. Row 0 is all zero before the first occurrence of the first
+     * pattern char and nothing reads it there, so a caller that already
+     * knows that position may start at it.
+     */
+    int pidx = 0, last_idx = 0;
+    char pchar0 = lower_needle[0];
+    char pchar = pchar0;
+    int16_t prev_H0 = 0;
+    int in_gap = 0;
+    int16_t max_score = 0;
+
+    for (int i = start; i < N; i++) {
+        char ch = T[i];
+
+        if (ch == pchar) {
+            if (pidx < M) {
+                F[pidx] = i;
+                pidx++;
+                pchar = (pidx < M) ? lower_needle[pidx] : 0;
+            }
+            last_idx = i;
+        }
+
+        if (ch == pchar0) {
+            int16_t score = SCORE_MATCH + B[i] * BONUS_FIRST_CHAR_MULTIPLIER;
+            H0[i] = score;
+            C0[i] = 1;
+            if (M == 1 && score > max_score) {
+                max_score = score;
+                if (B[i] >= BONUS_BOUNDARY)
+                    break;
+            }
+            in_gap = 0;
+        } else {
+            if (in_gap) {
+                H0[i] = max16(prev_H0 + SCORE_GAP_EXTENSION, 0);
+            } else {
+                H0[i] = max16(prev_H0 + SCORE_GAP_START, 0);
+            }
+            C0[i] = 0;
+            in_gap = 1;
+        }
+        prev_H0 = H0[i];
+    }
+
+    /* No match if we didn't find all pattern characters */
+    if (pidx != M)
+        return SCORE_MIN;
+    if (first_pos)
+        *first_pos = F[0];
+
+    /* Single character pattern: done */
+    if (M == 1)
+        return (score_t)max_score;
+
+    /* Phase 3: the remaining rows, from F[0] to last_idx */
+    FzfRows rows = { lower_needle, M, T, B, F, F[0], last_idx - F[0] + 1, H0, C0 };
+    int16_t best = kernel(&rows);
+    return best < 0 ? SCORE_MIN : (score_t)best;
+}
+
+static score_t match_lowered(const char *lower_needle, int M,
+                             const char *T, const int16_t *B, int N,
+                             int start, int *first_pos) {
+    return match_lowered_with(FZF_ROW_KERNEL, lower_needle, M, T, B, N, start, first_pos);
+}
+
+/* Lowercase haystack into T and fill its bonus vector B */
+static void lower_with_bonus(const char *haystack, int N, char *T, int16_t *B) {
+    char_class_t prev_class = INITIAL_CHAR_CLASS;
+    for (int i = 0; i < N; i++) {
+        unsigned char uc = (unsigned char)haystack[i];
+        char_class_t class = char_class_of(uc);
+        T[i] = tolower(uc);
+        B[i] = bonus_matrix[prev_class][class];
+        prev_class = class;
+    }
+}
+
+static score_t fuzzy_match_with(FzfRowKernel kernel, const char *needle, const char *haystack) {
+    fzf_init();
+
+    if (!needle || !haystack)
+        return SCORE_MIN;
+
+    int M = (int)strlen(needle);
+    if (M == 0)
+        return 0;
+
+    int N = (int)strlen(haystack);
+    if (M > N)
+        return SCORE_MIN;
+
+    if (N > FZF_MAX_LEN || M > FZF_MAX_LEN)
+        return SCORE_MIN;
+
+    char lower_needle[FZF_MAX_LEN];
+    for (int i = 0; i < M; i++)
+        lower_needle[i] = tolower((unsigned char)needle[i]);
+
+    char T[FZF_MAX_LEN];       /* lowercased haystack */
+    int16_t B[FZF_MAX_LEN];    /* bonus for each position */
+    lower_with_bonus(haystack, N, T, B);
+
+    return match_lowered_with(kernel, lower_needle, M, T, B, N, 0, NULL);
+}
+
+score_t fzf_fuzzy_match(const char *needle, const char *haystack) {
+    return fuzzy_match_with(FZF_ROW_KERNEL, needle, haystack);
+}
+
+score_t fzf_fuzzy_match_scalar(const char *needle, const char *haystack) {
+    return fuzzy_match_with(fill_rows_scalar, needle, haystack);
+}
+
+/* --- Precompiled haystacks and patterns --- */
+
+static inline uint64_t char_bit(unsigned char c) {
+    c = (unsigned char)tolower(c);
+    if (c >= 'a' && c <= 'z')
+        return UINT64_C(1) << (c - 'a');
+    if (c >= '0' && c <= '9')
+        return UINT64_C(1) << (26 + c - '0');
+    return UINT64_C(1) << (36 + c % 28);
+}
+
+uint64_t fzf_char_mask(const char *text) {
+    uint64_t mask = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+        mask |= char_bit(*p);
+    return mask;
+}
+
+int fzf_haystack_compile(FzfHaystack *hs, const char *haystack) {
+    fzf_init();
+
+    /* fzf_fuzzy_match() rejects haystacks this long, so they compile to
+     * an empty one that no pattern but the empty one matches */
+    int N = (int)strlen(haystack);
+    if (N > FZF_MAX_LEN)
+        N = 0;
+
+    /* One block: bonus vector first (alignment), then the text */
+    size_t size = sizeof(int16_t) * (size_t)N + (size_t)N + 1;
+    void *block = realloc(hs->bonus, size);
+    if (!block)
+        return 0;
+
+    hs->bonus = (int16_t *)block;
+    hs->text = (char *)block + sizeof(int16_t) * (size_t)N;
+    hs->len = N;
+    lower_with_bonus(haystack, N, hs->text, hs->bonus);
+    hs->text[N] = '\0';
+    hs->mask = fzf_char_mask(hs->text);
+    return 1;
+}
+
+void fzf_haystack_free(FzfHaystack *hs) {
+    free(hs->bonus);
+    memset(hs, 0, sizeof(*hs));
+}
+
+void fzf_pattern_compile(FzfPattern *pattern, const char *needle) {
+    int M = 0;
+    for (; needle[M] && M < FZF_MAX_LEN - 1; M++)
+        pattern->text[M] = tolower((unsigned char)needle[M]);
+    pattern->text[M] = '\0';
+    pattern->len = M;
+    pattern->mask = fzf_char_mask(pattern->text);
+}
+
+score_t fzf_match_compiled(const FzfPattern *pattern, const FzfHaystack *hs) {
+    int first_pos = 0;
+    return fzf_match_compiled_from(pattern, hs, &first_pos);
+}
+
+score_t fzf_match_compiled_from(const FzfPattern *pattern, const FzfHaystack *hs,
+                                int *first_pos) {
+    if (pattern->len == 0)
+        return 0;
+    if ((hs->mask & pattern->mask) != pattern->mask)
+        return SCORE_MIN;
+    int start = *first_pos;
+    if (start < 0 || start > hs->len)
+        start = 0;
+    return match_lowered(pattern->text, pattern->len, hs->text, hs->bonus, hs->len,
+                         start, first_pos);
 }
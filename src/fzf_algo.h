@@ -11,12 +11,17 @@
 #ifndef FZF_ALGO_H
 #define FZF_ALGO_H
 
+#include <stdint.h>
+
 #include "match.h"  /* score_t, SCORE_MIN */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Maximum haystack/needle length we handle */
+#define FZF_MAX_LEN 1024
+
 /*
  * Perform fzf-style fuzzy matching of needle against haystack.
  *
@@ -25,12 +30,65 @@ extern "C" {
  */
 score_t fzf_fuzzy_match(const char *needle, const char *haystack);
 
+/*
+ * fzf_fuzzy_match() with the one-cell-at-a-time score matrix. The vector
+ * kernel must give identical scores; kept as the reference for tests.
+ */
+score_t fzf_fuzzy_match_scalar(const char *needle, const char *haystack);
+
 /*
  * Quick check whether needle is a subsequence of haystack.
  * Returns 1 if match exists, 0 otherwise. Case-insensitive.
  */
 int fzf_has_match(const char *needle, const char *haystack);
 
+/*
+ * Precompiled haystack: the lowercased text, its per-position bonus vector
+ * and a character-presence mask. Build it once per string and reuse it
+ * across queries; matching it skips the lowercase and bonus passes.
+ * Zero-initialize before the first compile; recompiling reuses the block.
+ * Text longer than FZF_MAX_LEN compiles empty and never matches, like
+ * fzf_fuzzy_match() on the same text.
+ */
+typedef struct {
+    char *text;         /* lowercased haystack (points into the bonus block) */
+    int16_t *bonus;     /* bonus for each position */
+    int len;
+    uint64_t mask;      /* fzf_char_mask() of text */
+} FzfHaystack;
+
+/* Precompiled needle (lowercased) for matching many haystacks */
+typedef struct {
+    char text[FZF_MAX_LEN];
+    int len;
+    uint64_t mask;
+} FzfPattern;
+
+/*
+ * Case-insensitive character-presence mask. A needle can only match a
+ * haystack whose mask covers the needle's; letters and digits get their
+ * own bits, other bytes share the rest.
+ */
+uint64_t fzf_char_mask(const char *text);
+
+/* Returns 1 on success, 0 if the buffer could not be allocated */
+int fzf_haystack_compile(FzfHaystack *hs, const char *haystack);
+void fzf_haystack_free(FzfHaystack *hs);
+
+void fzf_pattern_compile(FzfPattern *pattern, const char *needle);
+
+/* Same score as fzf_fuzzy_match() on the original strings */
+score_t fzf_match_compiled(const FzfPattern *pattern, const FzfHaystack *hs);
+
+/*
+ * fzf_match_compiled() resuming the scan at *first_pos, which must not be
+ * past the first occurrence of the pattern's first char (0 if unknown).
+ * On a match *first_pos is set to that occurrence; a pattern extending
+ * this one keeps the same first char, so it can start there.
+ */
+score_t fzf_match_compiled_from(const FzfPattern *pattern, const FzfHaystack *hs,
+                                int *first_pos);
+
 #ifdef __cplusplus
 }
 #endif
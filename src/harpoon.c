@@ -93,6 +93,51 @@ int is_slot_assigned(const HarpoonManager *manager, int slot) {
 
 
 
+// Try to move a slot whose window is gone onto a matching window.
+// `candidates` holds indices into `windows`; NULL means every window.
+// Returns 1 if the slot was reassigned.
+static int reassign_orphaned_slot(HarpoonManager *manager, int slot,
+                                  WindowInfo *windows, int window_count,
+                                  const int *candidates, int candidate_count) {
+    log_trace("Window 0x%lx in slot %d no longer exists, looking for replacement",
+             manager->slots[slot].id, slot);
+    log_trace("Looking for: class='%s', instance='%s', type='%s', title='%s'",
+             manager->slots[slot].class_name, manager->slots[slot].instance,
+             manager->slots[slot].type, manager->slots[slot].title);
+
+    int count = candidates ? candidate_count : window_count;
+
+    // Look for a matching window using wildcard support
+    for (int c = 0; c < count; c++) {
+        int i = candidates ? candidates[c] : c;
+        if (i < 0 || i >= window_count) continue;
+
+        // Skip if this window is already assigned to a slot
+        int already_assigned = 0;
+        for (int j = 0; j < MAX_HARPOON_SLOTS; j++) {
+            if (manager->slots[j].assigned && manager->slots[j].id == windows[i].id) {
+                already_assigned = 1;
+                break;
+            }
+        }
+        if (already_assigned) continue;
+
+        log_trace("Checking window %d: class='%s', instance='%s', type='%s', title='%s'",
+                 i, windows[i].class_name, windows[i].instance, windows[i].type, windows[i].title);
+
+        // Use wildcard matching
+        if (window_matches_harpoon_slot(&windows[i], &manager->slots[slot])) {
+            // Found a match! Reassign the slot
+            Window old_id = manager->slots[slot].id;
+            manager->slots[slot].id = windows[i].id;
+            log_info("Automatically reassigned slot %d from window 0x%lx to 0x%lx (wildcard match: %s)",
+                    slot, old_id, windows[i].id, windows[i].title);
+            return 1;
+        }
+    }
+    return 0;
+}
+
 bool check_and_reassign_windows(HarpoonManager *manager, WindowInfo *windows, int window_count) {
     if (!manager || !windows) return false;
     
@@ -121,44 +166,57 @@ bool check_and_reassign_windows(HarpoonManager *manager, WindowInfo *windows, in
         
         // If window doesn't exist anymore, try to find a matching window
         if (!window_still_exists) {
-            log_trace("Window 0x%lx in slot %d no longer exists, looking for replacement",
-                     manager->slots[slot].id, slot);
-            log_trace("Looking for: class='%s', instance='%s', type='%s', title='%s'",
-                     manager->slots[slot].class_name, manager->slots[slot].instance,
-                     manager->slots[slot].type, manager->slots[slot].title);
-            
-            // Look for a matching window using wildcard support
+            config_changed |= reassign_orphaned_slot(manager, slot, windows, window_count, NULL, 0);
+        }
+    }
+    
+    // Note: Config will be saved by the calling code when appropriate
+    if (config_changed) {
+        log_debug("Harpoon slots were automatically reassigned");
+    }
+    return config_changed;
+}
+
+bool check_and_reassign_windows_delta(HarpoonManager *manager, WindowInfo *windows,
+                                      int window_count, const WindowListDelta *delta) {
+    if (!manager || !windows || !delta) return false;
+    if (delta->added_count == 0 && delta->removed_count == 0) return false;
+
+    int config_changed = 0;
+
+    for (int slot = 0; slot < MAX_HARPOON_SLOTS; slot++) {
+        if (!manager->slots[slot].assigned) continue;
+        Window id = manager->slots[slot].id;
+
+        int just_removed = 0;
+        for (int r = 0; r < delta->removed_count; r++) {
+            if (delta->removed[r] == id) {
+                just_removed = 1;
+                break;
+            }
+        }
+
+        if (just_removed) {
+            // Window just closed: any current window may take the slot over
+            config_changed |= reassign_orphaned_slot(manager, slot, windows, window_count, NULL, 0);
+        } else if (delta->added_count > 0) {
+            // Slot orphaned earlier: only the new windows are new candidates
+            int exists = 0;
             for (int i = 0; i < window_count; i++) {
-                // Skip if this window is already assigned to a slot
-                int already_assigned = 0;
-                for (int j = 0; j < MAX_HARPOON_SLOTS; j++) {
-                    if (manager->slots[j].assigned && manager->slots[j].id == windows[i].id) {
-                        already_assigned = 1;
-                        break;
-                    }
-                }
-                if (already_assigned) continue;
-                
-                log_trace("Checking window %d: class='%s', instance='%s', type='%s', title='%s'",
-                         i, windows[i].class_name, windows[i].instance, windows[i].type, windows[i].title);
-                
-                // Use wildcard matching
-                if (window_matches_harpoon_slot(&windows[i], &manager->slots[slot])) {
-                    // Found a match! Reassign the slot
-                    Window old_id = manager->slots[slot].id;
-                    manager->slots[slot].id = windows[i].id;
-                    config_changed = 1;
-                    log_info("Automatically reassigned slot %d from window 0x%lx to 0x%lx (wildcard match: %s)",
-                            slot, old_id, windows[i].id, windows[i].title);
+                if (windows[i].id == id) {
+                    exists = 1;
                     break;
                 }
             }
+            if (!exists) {
+                config_changed |= reassign_orphaned_slot(manager, slot, windows, window_count,
+                                                         delta->added, delta->added_count);
+            }
         }
     }
-    
-    // Note: Config will be saved by the calling code when appropriate
+
     if (config_changed) {
         log_debug("Harpoon slots were automatically reassigned");
     }
     return config_changed;
-}
\ No newline at end of file
+}
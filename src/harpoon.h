@@ -4,6 +4,7 @@
 #include <X11/Xlib.h>
 #include <stdbool.h>
 #include "types.h"
+#include "window_list.h"
 
 // Forward declare WindowAlignment
 struct AppData;
@@ -36,5 +37,8 @@ int is_slot_assigned(const HarpoonManager *manager, int slot);
 // Automatic reassignment functions
 // Returns true if any slots were reassigned
 bool check_and_reassign_windows(HarpoonManager *manager, WindowInfo *windows, int window_count);
+// Same, but only considers windows touched by an incremental list update
+bool check_and_reassign_windows_delta(HarpoonManager *manager, WindowInfo *windows,
+                                      int window_count, const WindowListDelta *delta);
 
 #endif // HARPOON_H
\ No newline at end of file
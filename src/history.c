@@ -5,8 +5,19 @@
 #include "history.h"
 #include "x11_utils.h"
 #include "window_info.h"
+#include "window_list.h"
+#include "window_store.h"
 #include "log.h"
 
+// Scratch tables reused by update_history() and partition_and_reorder();
+// they grow with the window count, not per call
+static Window *scratch = NULL;
+static int scratch_capacity = 0;
+static gboolean *in_history = NULL;  // By index into app->windows
+static int in_history_capacity = 0;
+static unsigned char *groups = NULL; // Partition group by history position
+static int groups_capacity = 0;
+
 // Update history with current window list (like Go code's KeepOnly + AddNew + UpdateActiveWindow)
 void update_history(AppData *app) {
     // Get current active window
@@ -15,46 +26,34 @@ void update_history(AppData *app) {
     log_trace("update_history() - current_active=0x%x, previous_active=0x%x",
             current_active, app->active_window_id);
     
+    if (!GROW_ARRAY(scratch, scratch_capacity, app->window_count) ||
+        !GROW_ARRAY(in_history, in_history_capacity, app->window_count)) {
+        return;
+    }
+
     // Keep only existing windows in history (KeepOnly logic)
-    WindowInfo new_history[MAX_WINDOWS];
+    Window *new_history = scratch;
     int new_history_count = 0;
+    memset(in_history, 0, sizeof(gboolean) * (size_t)app->window_count);
     
     for (int i = 0; i < app->history_count; i++) {
-        WindowInfo *hist_win = &app->history[i];
-        
         // Find this window in current list
-        for (int j = 0; j < app->window_count; j++) {
-            if (app->windows[j].id == hist_win->id) {
-                // Update with current window info and keep in history
-                new_history[new_history_count] = app->windows[j];
-                new_history_count++;
-                break;
-            }
+        int j = find_window_index(app, app->history[i]);
+        if (j >= 0 && !in_history[j]) {
+            new_history[new_history_count++] = app->history[i];
+            in_history[j] = TRUE;
         }
     }
     
     // Add new windows that aren't in history (AddNew logic)
     for (int i = 0; i < app->window_count; i++) {
-        WindowInfo *win = &app->windows[i];
-        gboolean found_in_history = FALSE;
-        
-        for (int j = 0; j < new_history_count; j++) {
-            if (new_history[j].id == win->id) {
-                found_in_history = TRUE;
-                break;
-            }
-        }
-        
-        if (!found_in_history && new_history_count < MAX_WINDOWS) {
-            new_history[new_history_count] = *win;
-            new_history_count++;
+        if (!in_history[i]) {
+            new_history[new_history_count++] = app->windows[i].id;
         }
     }
     
     // Copy back to history
-    for (int i = 0; i < new_history_count; i++) {
-        app->history[i] = new_history[i];
-    }
+    memcpy(app->history, new_history, sizeof(Window) * (size_t)new_history_count);
     app->history_count = new_history_count;
     
     // Update active window (move to front if changed, like Go code's UpdateActiveWindow)
@@ -62,19 +61,17 @@ void update_history(AppData *app) {
         log_debug("Active window changed, looking for window 0x%x in history", current_active);
         // Find active window in history and move to front
         for (int i = 1; i < app->history_count; i++) { // Start from 1, skip if already at front
-            if (app->history[i].id == (Window)current_active) {
+            if (app->history[i] == (Window)current_active) {
+                const WindowInfo *win = &app->windows[find_window_index(app, app->history[i])];
                 // Check if this is not our own window (by class name)
-                if (strcasecmp(app->history[i].class_name, "cofi") != 0) {
+                if (strcasecmp(win->class_name, "cofi") != 0) {
                     log_trace("Moving window '%s' (0x%lx) to front from position %d", 
-                            app->history[i].title, app->history[i].id, i);
+                            win->title, win->id, i);
                     // Move to front
-                    WindowInfo active_win = app->history[i];
-                    for (int j = i; j > 0; j--) {
-                        app->history[j] = app->history[j-1];
-                    }
-                    app->history[0] = active_win;
+                    memmove(&app->history[1], &app->history[0], sizeof(Window) * (size_t)i);
+                    app->history[0] = win->id;
                 } else {
-                    log_trace("Skipping cofi window (class: %s)", app->history[i].class_name);
+                    log_trace("Skipping cofi window (class: %s)", win->class_name);
                 }
                 break;
             }
@@ -87,73 +84,29 @@ void update_history(AppData *app) {
     log_trace("update_history() complete - history_count=%d", app->history_count);
 }
 
+// Partition group of a window below the first two (lower goes first)
+static int partition_group(const WindowInfo *win, int current_desktop) {
+    if (win->desktop == -1) return 4;                        // Sticky
+    int other = win->desktop != current_desktop;
+    if (strcmp(win->type, "Normal") == 0) return other;      // Current / other Normal
+    return 2 + other;                                        // Current / other Special
+}
+
 // Partition windows by type and reorder (Normal first, then Special)
 void partition_and_reorder(AppData *app) {
     if (app->history_count <= 2) return; // Nothing to reorder if we have 2 or fewer windows
+    if (!GROW_ARRAY(scratch, scratch_capacity, app->history_count) ||
+        !GROW_ARRAY(groups, groups_capacity, app->history_count)) {
+        return;
+    }
     
-    // CRITICAL: Preserve first TWO windows for Alt-Tab functionality
-    WindowInfo first_window = app->history[0];
-    WindowInfo second_window = app->history[1];
     int current_desktop = get_current_desktop(app->display);
     
-    // Arrays for each category
-    WindowInfo current_normal[MAX_WINDOWS];
-    WindowInfo other_normal[MAX_WINDOWS];
-    WindowInfo current_special[MAX_WINDOWS];
-    WindowInfo other_special[MAX_WINDOWS];
-    WindowInfo sticky_windows[MAX_WINDOWS];
-    
-    int current_normal_count = 0;
-    int other_normal_count = 0;
-    int current_special_count = 0;
-    int other_special_count = 0;
-    int sticky_count = 0;
-    
     log_trace("partition_and_reorder() - starting with %d windows, current desktop: %d", 
               app->history_count, current_desktop);
     
-    // Partition windows starting from index 2 (skip first two windows)
-    for (int i = 2; i < app->history_count; i++) {
-        WindowInfo *win = &app->history[i];
-        
-        // Check if window is sticky
-        if (win->desktop == -1) {
-            if (sticky_count < MAX_WINDOWS) {
-                sticky_windows[sticky_count] = *win;
-                sticky_count++;
-            }
-        }
-        // Check if window is Normal type
-        else if (strcmp(win->type, "Normal") == 0) {
-            if (win->desktop == current_desktop) {
-                if (current_normal_count < MAX_WINDOWS) {
-                    current_normal[current_normal_count] = *win;
-                    current_normal_count++;
-                }
-            } else {
-                if (other_normal_count < MAX_WINDOWS) {
-                    other_normal[other_normal_count] = *win;
-                    other_normal_count++;
-                }
-            }
-        }
-        // Window is Special type
-        else {
-            if (win->desktop == current_desktop) {
-                if (current_special_count < MAX_WINDOWS) {
-                    current_special[current_special_count] = *win;
-                    current_special_count++;
-                }
-            } else {
-                if (other_special_count < MAX_WINDOWS) {
-                    other_special[other_special_count] = *win;
-                    other_special_count++;
-                }
-            }
-        }
-    }
-    
-    // Rebuild history in the desired order:
+    // Stable counting sort on the partition group, so the relative order
+    // inside each group is kept:
     // 1. First window (currently active)
     // 2. Second window (previously active - for Alt-Tab)
     // 3. Current workspace Normal windows
@@ -161,38 +114,25 @@ void partition_and_reorder(AppData *app) {
     // 5. Current workspace Special windows
     // 6. Other workspace Special windows
     // 7. Sticky windows
-    
-    app->history_count = 0;
-    
-    // Always preserve the first TWO windows
-    app->history[app->history_count++] = first_window;
-    app->history[app->history_count++] = second_window;
-    
-    // Add current workspace Normal windows
-    for (int i = 0; i < current_normal_count && app->history_count < MAX_WINDOWS; i++) {
-        app->history[app->history_count++] = current_normal[i];
-    }
-    
-    // Add other workspace Normal windows
-    for (int i = 0; i < other_normal_count && app->history_count < MAX_WINDOWS; i++) {
-        app->history[app->history_count++] = other_normal[i];
-    }
-    
-    // Add current workspace Special windows
-    for (int i = 0; i < current_special_count && app->history_count < MAX_WINDOWS; i++) {
-        app->history[app->history_count++] = current_special[i];
+    // CRITICAL: Preserve first TWO windows for Alt-Tab functionality
+    int group_counts[5] = {0};
+    for (int i = 2; i < app->history_count; i++) {
+        int j = find_window_index(app, app->history[i]);
+        groups[i] = j >= 0 ? (unsigned char)partition_group(&app->windows[j], current_desktop) : 4;
+        group_counts[groups[i]]++;
     }
-    
-    // Add other workspace Special windows
-    for (int i = 0; i < other_special_count && app->history_count < MAX_WINDOWS; i++) {
-        app->history[app->history_count++] = other_special[i];
+
+    int next[5];
+    int offset = 2;
+    for (int group = 0; group < 5; group++) {
+        next[group] = offset;
+        offset += group_counts[group];
     }
-    
-    // Add sticky windows at the end
-    for (int i = 0; i < sticky_count && app->history_count < MAX_WINDOWS; i++) {
-        app->history[app->history_count++] = sticky_windows[i];
+    for (int i = 2; i < app->history_count; i++) {
+        scratch[next[groups[i]]++] = app->history[i];
     }
+    memcpy(&app->history[2], &scratch[2], sizeof(Window) * (size_t)(app->history_count - 2));
     
     log_debug("Partitioned windows - Current Normal: %d, Other Normal: %d, Current Special: %d, Other Special: %d, Sticky: %d",
-              current_normal_count, other_normal_count, current_special_count, other_special_count, sticky_count);
+              group_counts[0], group_counts[1], group_counts[2], group_counts[3], group_counts[4]);
 }
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "hotkey_config.h"
 #include "log.h"
 #include "types.h"
+#include "warm_show.h"
+#include "window_list.h"
 #include "x11_utils.h"
 
 extern void show_window(AppData *app);
@@ -201,12 +203,8 @@ static void prefill_command_mode(AppData *app, const char *command) {
 }
 
 static WindowInfo *find_window_by_id(AppData *app, Window id) {
-    for (int i = 0; i < app->window_count; i++) {
-        if (app->windows[i].id == id) {
-            return &app->windows[i];
-        }
-    }
-    return NULL;
+    int index = find_window_index(app, id);
+    return index >= 0 ? &app->windows[index] : NULL;
 }
 
 static gboolean hotkey_dispatch_idle(gpointer data) {
@@ -238,6 +236,9 @@ static gboolean hotkey_dispatch_idle(gpointer data) {
         if (!keeps_open && app->window_visible) {
             hide_window(app);
         }
+        if (!app->window_visible) {
+            warm_show_cancel_request(app);
+        }
     } else {
         prefill_command_mode(app, command);
     }
@@ -278,6 +279,7 @@ void handle_hotkey_event(AppData *app, XKeyEvent *event) {
         }
 
         app->pending_hotkey_mode = 1;
+        warm_show_mark_request(app);
 
         HotkeyDispatch *dispatch = malloc(sizeof(HotkeyDispatch));
         if (!dispatch) {
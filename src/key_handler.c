@@ -143,6 +143,7 @@ void on_entry_changed(GtkEntry *entry, AppData *app) {
         return;
     }
 
+    const gint64 keystroke_us = g_get_monotonic_time();
     const char *text = gtk_entry_get_text(entry);
     if (strlen(text) > 0) {
         log_debug("USER: Filter text changed -> '%s'", text);
@@ -161,9 +162,17 @@ void on_entry_changed(GtkEntry *entry, AppData *app) {
     } else if (app->current_tab == TAB_HOTKEYS) {
         filter_hotkeys(app, text);
     } else if (app->current_tab == TAB_APPS) {
-        filter_apps(app, text);
+        if (filter_apps_async(app, text, keystroke_us)) {
+            // Scored on a worker; the previous rows stay on screen and the
+            // entry keeps echoing until the results land
+            log_debug("Keystroke to echo: %.2fms",
+                      (double)(g_get_monotonic_time() - keystroke_us) / 1000.0);
+            return;
+        }
     }
 
     reset_selection(app);
     update_display(app);
+    log_debug("Keystroke to echo and results: %.2fms",
+              (double)(g_get_monotonic_time() - keystroke_us) / 1000.0);
 }
@@ -0,0 +1,102 @@
+#include "layout_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "window_store.h"
+
+#define FNV_OFFSET UINT64_C(14695981039346656037)
+#define FNV_PRIME  UINT64_C(1099511628211)
+
+static uint64_t hash_key(const char *key) {
+    uint64_t h = FNV_OFFSET;
+    for (const unsigned char *p = (const unsigned char *)key; *p; p++) {
+        h ^= *p;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+// A screen of rows is a few dozen entries, so a scan over the hashes
+// costs less than keeping a table in order
+static LayoutCacheEntry *find_entry(LayoutCache *cache, uint64_t hash, const char *key) {
+    for (int i = 0; i < cache->count; i++) {
+        LayoutCacheEntry *entry = &cache->entries[i];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void *layout_cache_lookup(LayoutCache *cache, const char *key) {
+    LayoutCacheEntry *entry = find_entry(cache, hash_key(key), key);
+    if (!entry) {
+        cache->misses++;
+        return NULL;
+    }
+    entry->last_used = ++cache->clock;
+    cache->hits++;
+    return entry->layout;
+}
+
+static void free_entry(LayoutCache *cache, LayoutCacheEntry *entry) {
+    if (cache->free_layout) {
+        cache->free_layout(entry->layout);
+    }
+    free(entry->key);
+}
+
+void layout_cache_store(LayoutCache *cache, const char *key, void *layout) {
+    uint64_t hash = hash_key(key);
+    LayoutCacheEntry *entry = find_entry(cache, hash, key);
+    char *copy = entry ? NULL : strdup(key);
+
+    if (entry) {
+        if (cache->free_layout && entry->layout != layout) {
+            cache->free_layout(entry->layout);
+        }
+    } else if (!copy) {
+        log_error("Failed to cache layout of a %zu byte row", strlen(key));
+        if (cache->free_layout) cache->free_layout(layout);
+        return;
+    } else if (cache->count == LAYOUT_CACHE_MAX_ENTRIES) {
+        entry = &cache->entries[0];
+        for (int i = 1; i < cache->count; i++) {
+            if (cache->entries[i].last_used < entry->last_used) {
+                entry = &cache->entries[i];
+            }
+        }
+        free_entry(cache, entry);
+    } else {
+        if (!GROW_ARRAY(cache->entries, cache->capacity, cache->count + 1)) {
+            log_error("Failed to grow layout cache to %d entries", cache->count + 1);
+            free(copy);
+            if (cache->free_layout) cache->free_layout(layout);
+            return;
+        }
+        entry = &cache->entries[cache->count++];
+    }
+
+    if (copy) {
+        entry->hash = hash;
+        entry->key = copy;
+    }
+    entry->layout = layout;
+    entry->last_used = ++cache->clock;
+}
+
+void layout_cache_clear(LayoutCache *cache) {
+    for (int i = 0; i < cache->count; i++) {
+        free_entry(cache, &cache->entries[i]);
+    }
+    cache->count = 0;
+}
+
+void layout_cache_cleanup(LayoutCache *cache) {
+    layout_cache_clear(cache);
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->capacity = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef LAYOUT_CACHE_H
+#define LAYOUT_CACHE_H
+
+#include <stdint.h>
+
+// Laid-out rows of the results view, keyed by the row's text (and its
+// highlights), kept across frames. A row that keeps its text keeps its
+// layout whatever line it moves to; the least recently drawn rows go
+// first once the cache is full.
+
+#define LAYOUT_CACHE_MAX_ENTRIES 256
+
+typedef void (*LayoutFreeFunc)(void *layout);
+
+typedef struct {
+    uint64_t hash;
+    char *key;
+    void *layout;
+    unsigned last_used;
+} LayoutCacheEntry;
+
+typedef struct {
+    LayoutCacheEntry *entries;
+    int count;
+    int capacity;
+    unsigned clock;
+    LayoutFreeFunc free_layout;     // Called for evicted and cleared layouts
+    unsigned hits;
+    unsigned misses;
+} LayoutCache;
+
+// Layout stored for key, or NULL (counted as a miss)
+void *layout_cache_lookup(LayoutCache *cache, const char *key);
+
+// Store layout for key, evicting the least recently used entry when full.
+// On allocation failure the layout is freed right away.
+void layout_cache_store(LayoutCache *cache, const char *key, void *layout);
+
+// Drop every layout (the font changed)
+void layout_cache_clear(LayoutCache *cache);
+
+void layout_cache_cleanup(LayoutCache *cache);
+
+#endif // LAYOUT_CACHE_H
@@ -0,0 +1,117 @@
+#include "line_diff.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "window_store.h"
+
+// Copy text into lt and index its lines ("a\nb" and "a\nb\n" have two and
+// three lines, as in a text buffer)
+static bool split_lines(LineText *lt, const char *text) {
+    int len = (int)strlen(text);
+    if (!GROW_ARRAY(lt->text, lt->capacity, len + 1)) return false;
+    memcpy(lt->text, text, (size_t)len + 1);
+
+    lt->count = 0;
+    int start = 0;
+    for (int i = 0; i <= len; i++) {
+        if (i < len && text[i] != '\n') continue;
+        if (!GROW_ARRAY(lt->starts, lt->starts_capacity, lt->count + 1)) return false;
+        lt->starts[lt->count++] = start;
+        start = i + 1;
+    }
+    return true;
+}
+
+static const char *line_text(const LineText *lt, int line, int *len) {
+    int start = lt->starts[line];
+    int end = line + 1 < lt->count ? lt->starts[line + 1] - 1 : (int)strlen(lt->text + start) + start;
+    *len = end - start;
+    return lt->text + start;
+}
+
+static bool lines_equal(const LineText *a, int line_a, const LineText *b, int line_b) {
+    int len_a, len_b;
+    const char *text_a = line_text(a, line_a, &len_a);
+    const char *text_b = line_text(b, line_b, &len_b);
+    return len_a == len_b && memcmp(text_a, text_b, (size_t)len_a) == 0;
+}
+
+static bool add_edit(LineDiff *diff, LineEdit edit) {
+    if (!GROW_ARRAY(diff->edits, diff->edit_capacity, diff->edit_count + 1)) return false;
+    diff->edits[diff->edit_count++] = edit;
+    return true;
+}
+
+// Edits turning old into new: keep the common head and tail, replace the
+// lines that differ pairwise in between, then insert or delete the rest
+static bool compute_edits(LineDiff *diff, const LineText *old, const LineText *new) {
+    int head = 0;
+    while (head < old->count && head < new->count && lines_equal(old, head, new, head)) {
+        head++;
+    }
+    int tail = 0;
+    while (tail < old->count - head && tail < new->count - head &&
+           lines_equal(old, old->count - 1 - tail, new, new->count - 1 - tail)) {
+        tail++;
+    }
+
+    int old_middle = old->count - head - tail;
+    int new_middle = new->count - head - tail;
+    int paired = old_middle < new_middle ? old_middle : new_middle;
+
+    for (int i = head; i < head + paired; i++) {
+        if (lines_equal(old, i, new, i)) continue;
+        LineEdit edit = { LINE_EDIT_REPLACE, i, 1, NULL, 0 };
+        edit.text = line_text(new, i, &edit.len);
+        if (!add_edit(diff, edit)) return false;
+    }
+
+    int first = head + paired;
+    if (new_middle > old_middle) {
+        int count = new_middle - old_middle;
+        int last_len;
+        const char *last = line_text(new, first + count - 1, &last_len);
+        LineEdit edit = { LINE_EDIT_INSERT, first, count, new->text + new->starts[first], 0 };
+        edit.len = (int)(last + last_len - edit.text);
+        if (!add_edit(diff, edit)) return false;
+    } else if (old_middle > new_middle) {
+        LineEdit edit = { LINE_EDIT_DELETE, first, old_middle - new_middle, NULL, 0 };
+        if (!add_edit(diff, edit)) return false;
+    }
+    return true;
+}
+
+int line_diff_update(LineDiff *diff, const char *text) {
+    int next = 1 - diff->current;
+    diff->edit_count = 0;
+
+    if (!split_lines(&diff->lines[next], text)) {
+        log_error("Failed to index %zu bytes of display text", strlen(text));
+        diff->valid = false;
+        return -1;
+    }
+    bool diffed = diff->valid &&
+                  compute_edits(diff, &diff->lines[diff->current], &diff->lines[next]);
+    diff->current = next;
+    diff->valid = true;  // The caller puts text into the buffer either way
+    if (!diffed) {
+        diff->edit_count = 0;
+        return -1;
+    }
+    return diff->edit_count;
+}
+
+void line_diff_invalidate(LineDiff *diff) {
+    diff->valid = false;
+}
+
+void line_diff_cleanup(LineDiff *diff) {
+    for (int i = 0; i < 2; i++) {
+        free(diff->lines[i].text);
+        free(diff->lines[i].starts);
+    }
+    free(diff->edits);
+    memset(diff, 0, sizeof(*diff));
+}
@@ -0,0 +1,56 @@
+#ifndef LINE_DIFF_H
+#define LINE_DIFF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Line-level diff between the text last put into the results buffer and
+// the next frame, so update_display() rewrites only the lines that
+// changed. Moving the selection changes no lines (the marker is a tag);
+// typing changes the rows whose content moved.
+
+typedef enum {
+    LINE_EDIT_REPLACE,      // Line `line` becomes text
+    LINE_EDIT_INSERT,       // `count` lines of text are inserted before line `line`
+    LINE_EDIT_DELETE,       // Lines [line, line + count) are removed
+} LineEditKind;
+
+// Edits apply in order; lines are numbered as the buffer stands after
+// the previous edit. text has no trailing newline (INSERT lines are
+// joined by '\n') and points into the diff's copy of the new text.
+typedef struct {
+    LineEditKind kind;
+    int line;
+    int count;
+    const char *text;
+    int len;
+} LineEdit;
+
+typedef struct {
+    char *text;
+    int capacity;
+    int *starts;            // Byte offset of each line in text
+    int count;
+    int starts_capacity;
+} LineText;
+
+typedef struct {
+    LineText lines[2];
+    int current;            // lines[current] is what the buffer holds
+    bool valid;             // False until the buffer holds known text
+    LineEdit *edits;
+    int edit_count;
+    int edit_capacity;
+} LineDiff;
+
+// Diff text against the previous text and make it the current one.
+// Returns the number of edits in diff->edits, or -1 when there is nothing
+// to diff against and the caller has to set the whole text.
+int line_diff_update(LineDiff *diff, const char *text);
+
+// Forget the previous text (the buffer was written by someone else)
+void line_diff_invalidate(LineDiff *diff);
+
+void line_diff_cleanup(LineDiff *diff);
+
+#endif // LINE_DIFF_H
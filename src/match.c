@@ -8,12 +8,14 @@
 
 #include "match.h"
 #include "bonus.h"
+#include "simd_scan.h"
 
 #include "config.h"
 
-static char *strcasechr(const char *s, char c) {
-	const char accept[3] = {c, toupper(c), 0};
-	return strpbrk(s, accept);
+/* Same set strpbrk() with {c, toupper(c)} accepted: a lowercase needle
+ * char matches either case, anything else only itself */
+static const char *strcasechr(const char *s, char c) {
+	return simd_find_either(s, c, (char)toupper(c));
 }
 
 int has_match(const char *needle, const char *haystack) {
@@ -151,7 +153,7 @@ score_t match(const char *needle, const char *haystack) {
 	return last_M[m - 1];
 }
 
-score_t match_positions(const char *needle, const char *haystack, size_t *positions) {
+score_t match_positions_scratch(MatchScratch *scratch, const char *needle, const char *haystack, size_t *positions) {
 	if (!*needle)
 		return SCORE_MIN;
 
@@ -182,17 +184,27 @@ score_t match_positions(const char *needle, const char *haystack, size_t *positi
 	/*
 	 * D[][] Stores the best score for this position ending with a match.
 	 * M[][] Stores the best possible score at this position.
+	 * Both are n rows of m scores, kept in the scratch so that repeated
+	 * calls only allocate when a longer needle or haystack comes along.
 	 */
-	score_t (*D)[MATCH_MAX_LEN], (*M)[MATCH_MAX_LEN];
-	M = malloc(sizeof(score_t) * MATCH_MAX_LEN * n);
-	D = malloc(sizeof(score_t) * MATCH_MAX_LEN * n);
+	size_t needed = (size_t)2 * n * m;
+	if (scratch->capacity < needed) {
+		score_t *rows = realloc(scratch->rows, sizeof(score_t) * needed);
+		if (!rows)
+			return SCORE_MIN;
+		scratch->rows = rows;
+		scratch->capacity = needed;
+	}
+	score_t *D = scratch->rows;
+	score_t *M = scratch->rows + (size_t)n * m;
+#define AT(T, i, j) T[(size_t)(i) * m + (j)]
 
 	score_t *last_D = NULL, *last_M = NULL;
 	score_t *curr_D, *curr_M;
 
 	for (int i = 0; i < n; i++) {
-		curr_D = &D[i][0];
-		curr_M = &M[i][0];
+		curr_D = &AT(D, i, 0);
+		curr_M = &AT(M, i, 0);
 
 		match_row(&match, i, curr_D, curr_M, last_D, last_M);
 
@@ -213,15 +225,15 @@ score_t match_positions(const char *needle, const char *haystack, size_t *positi
 				 * we encounter, the latest in the candidate
 				 * string.
 				 */
-				if (D[i][j] != SCORE_MIN &&
-				    (match_required || D[i][j] == M[i][j])) {
+				if (AT(D, i, j) != SCORE_MIN &&
+				    (match_required || AT(D, i, j) == AT(M, i, j))) {
 					/* If this score was determined using
 					 * SCORE_MATCH_CONSECUTIVE, the
 					 * previous character MUST be a match
 					 */
 					match_required =
 					    i && j &&
-					    M[i][j] == D[i - 1][j - 1] + SCORE_MATCH_CONSECUTIVE;
+					    AT(M, i, j) == AT(D, i - 1, j - 1) + SCORE_MATCH_CONSECUTIVE;
 					positions[i] = j--;
 					break;
 				}
@@ -229,10 +241,21 @@ score_t match_positions(const char *needle, const char *haystack, size_t *positi
 		}
 	}
 
-	score_t result = M[n - 1][m - 1];
+	score_t result = AT(M, n - 1, m - 1);
+#undef AT
 
-	free(M);
-	free(D);
+	return result;
+}
 
+score_t match_positions(const char *needle, const char *haystack, size_t *positions) {
+	MatchScratch scratch = {0};
+	score_t result = match_positions_scratch(&scratch, needle, haystack, positions);
+	match_scratch_free(&scratch);
 	return result;
 }
+
+void match_scratch_free(MatchScratch *scratch) {
+	free(scratch->rows);
+	scratch->rows = NULL;
+	scratch->capacity = 0;
+}
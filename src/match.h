@@ -11,8 +11,17 @@ typedef double score_t;
 
 #define MATCH_MAX_LEN 1024
 
+/* DP rows reused across match_positions_scratch() calls; zero-initialize,
+ * release with match_scratch_free() */
+typedef struct {
+	score_t *rows;
+	size_t capacity;
+} MatchScratch;
+
 int has_match(const char *needle, const char *haystack);
 score_t match_positions(const char *needle, const char *haystack, size_t *positions);
+score_t match_positions_scratch(MatchScratch *scratch, const char *needle, const char *haystack, size_t *positions);
+void match_scratch_free(MatchScratch *scratch);
 score_t match(const char *needle, const char *haystack);
 
 #ifdef __cplusplus
@@ -0,0 +1,104 @@
+#define _GNU_SOURCE
+#include "match_highlight.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "window_store.h"
+
+void match_highlight_begin(MatchHighlighter *hl, const char *query) {
+    HighlightSpan *spans = hl->previous;
+    int capacity = hl->previous_capacity;
+    hl->previous = hl->spans;
+    hl->previous_capacity = hl->capacity;
+    hl->previous_count = hl->count;
+    hl->spans = spans;
+    hl->capacity = capacity;
+    hl->count = 0;
+    hl->lines = 0;
+    hl->active = false;
+    if (!query || !*query) return;
+
+    // Negated terms match nothing to show; the workspace number is not
+    // part of the text a row is matched against
+    query_plan_parse(&hl->plan, query);
+    for (int t = 0; t < hl->plan.term_count; t++) {
+        const QueryTerm *term = &hl->plan.terms[t];
+        hl->active |= !term->negated && term->field != QUERY_FIELD_WORKSPACE;
+    }
+}
+
+static void add_span(MatchHighlighter *hl, int line, int start, int len) {
+    // Consecutive matched characters become one span
+    if (hl->count > 0) {
+        HighlightSpan *last = &hl->spans[hl->count - 1];
+        if (last->line == line && start >= last->start && start <= last->start + last->len) {
+            int end = start + len;
+            if (end > last->start + last->len) last->len = end - last->start;
+            return;
+        }
+    }
+    if (!GROW_ARRAY(hl->spans, hl->capacity, hl->count + 1)) return;
+    hl->spans[hl->count++] = (HighlightSpan){ line, start, len };
+}
+
+// fzy's optimal alignment of the term in the row
+static void highlight_fuzzy(MatchHighlighter *hl, const QueryTerm *term, int line, int offset) {
+    const char *needle = term->pattern.text;
+    if (!has_match(needle, hl->row)) return;
+    if (match_positions_scratch(&hl->scratch, needle, hl->row, hl->positions) == SCORE_MIN) return;
+
+    // fzy aligns bytes; only whole (ASCII) characters can be tagged
+    for (int i = 0; i < term->pattern.len; i++) {
+        int position = (int)hl->positions[i];
+        if ((unsigned char)hl->row[position] >= 0x80) continue;
+        add_span(hl, line, offset + position, 1);
+    }
+}
+
+// First occurrence of an exact or anchored term
+static void highlight_substring(MatchHighlighter *hl, const QueryTerm *term, int line, int offset) {
+    const char *hit = strcasestr(hl->row, term->pattern.text);
+    if (hit) add_span(hl, line, offset + (int)(hit - hl->row), term->pattern.len);
+}
+
+void match_highlight_row(MatchHighlighter *hl, const char *text, int len, int offset) {
+    int line = hl->lines++;
+    if (!hl->active) return;
+
+    // The row as drawn can be cut short of what filtering matched (fitted
+    // columns), so a term that is no longer visible just adds nothing
+    if (len > MATCH_MAX_LEN) len = MATCH_MAX_LEN;
+    memcpy(hl->row, text, (size_t)len);
+    hl->row[len] = '\0';
+
+    for (int t = 0; t < hl->plan.term_count; t++) {
+        const QueryTerm *term = &hl->plan.terms[t];
+        if (term->negated || term->field == QUERY_FIELD_WORKSPACE) continue;
+        if (term->kind == QUERY_FUZZY) {
+            highlight_fuzzy(hl, term, line, offset);
+        } else {
+            highlight_substring(hl, term, line, offset);
+        }
+    }
+}
+
+bool match_highlight_changed(const MatchHighlighter *hl) {
+    return hl->count != hl->previous_count ||
+           (hl->count > 0 &&
+            memcmp(hl->spans, hl->previous, (size_t)hl->count * sizeof(HighlightSpan)) != 0);
+}
+
+void match_highlight_cleanup(MatchHighlighter *hl) {
+    match_scratch_free(&hl->scratch);
+    free(hl->spans);
+    free(hl->previous);
+    hl->spans = NULL;
+    hl->previous = NULL;
+    hl->count = 0;
+    hl->capacity = 0;
+    hl->previous_count = 0;
+    hl->previous_capacity = 0;
+    hl->lines = 0;
+    hl->active = false;
+}
@@ -0,0 +1,48 @@
+#ifndef MATCH_HIGHLIGHT_H
+#define MATCH_HIGHLIGHT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "match.h"
+#include "query_plan.h"
+
+// Matched characters of the rows a frame draws. Filtering only scores;
+// positions need fzy's full DP matrix and a backtrace, so they are
+// computed here, per drawn row, into one scratch reused across frames.
+
+// Bytes [start, start + len) of a drawn line that the query matched
+typedef struct {
+    int line;
+    int start;
+    int len;
+} HighlightSpan;
+
+typedef struct {
+    QueryPlan plan;
+    bool active;                    // Query has terms to highlight
+    MatchScratch scratch;
+    size_t positions[MATCH_MAX_LEN];
+    char row[MATCH_MAX_LEN + 1];    // NUL-terminated copy of the matched part
+    HighlightSpan *spans;
+    int count;
+    int capacity;
+    HighlightSpan *previous;        // Spans of the frame before
+    int previous_count;
+    int previous_capacity;
+    int lines;                      // Rows added this frame
+} MatchHighlighter;
+
+// Start a frame for query (NULL or "" highlights nothing)
+void match_highlight_begin(MatchHighlighter *hl, const char *query);
+
+// Add the next drawn line. text[0, len) is the part of it matching looks
+// at, starting at byte `offset` of the line.
+void match_highlight_row(MatchHighlighter *hl, const char *text, int len, int offset);
+
+// Whether this frame's spans differ from the previous frame's
+bool match_highlight_changed(const MatchHighlighter *hl);
+
+void match_highlight_cleanup(MatchHighlighter *hl);
+
+#endif // MATCH_HIGHLIGHT_H
@@ -0,0 +1,175 @@
+#define _GNU_SOURCE
+#include "name_scorer.h"
+
+#include <string.h>
+
+#include "fzf_algo.h"
+#include "top_k.h"
+
+// One slice of the candidates. Workers write only inside their own slice
+// of scored/survivors, so no locking is needed until the merge.
+typedef struct NameScorerRun NameScorerRun;
+
+typedef struct {
+    NameScorerRun *run;
+    int start;
+    int end;
+    int matched;
+    gboolean cancelled;
+} NameScorerChunk;
+
+struct NameScorerRun {
+    const char *query;
+    guint64 query_mask;
+    const char *const *names;
+    const guint64 *masks;
+    const int *candidates;
+    int k;
+    ScoredName *scored;
+    int *survivors;
+    GCancellable *cancellable;
+
+    GMutex lock;
+    GCond done;
+    int pending;
+};
+
+static GThreadPool *pool = NULL;
+
+static int compare_scored_names(const void *a, const void *b) {
+    const ScoredName *left = (const ScoredName *)a;
+    const ScoredName *right = (const ScoredName *)b;
+    if (left->score > right->score) return -1;
+    if (left->score < right->score) return 1;
+    // Total order, so every split agrees; names are sorted, so ties stay
+    // alphabetical without collating in the hot loop
+    return left->index - right->index;
+}
+
+static void score_chunk(NameScorerChunk *chunk) {
+    NameScorerRun *run = chunk->run;
+    ScoredName *scored = run->scored + chunk->start;
+    int *survivors = run->survivors + chunk->start;
+    int matched = 0;
+
+    for (int c = chunk->start; c < chunk->end; c++) {
+        if (((c - chunk->start) & 255) == 0 && g_cancellable_is_cancelled(run->cancellable)) {
+            chunk->cancelled = TRUE;
+            return;
+        }
+        int i = run->candidates ? run->candidates[c] : c;
+        // A name missing any query character cannot contain the query
+        if ((run->masks[i] & run->query_mask) != run->query_mask ||
+            !strcasestr(run->names[i], run->query)) {
+            continue;
+        }
+        survivors[matched] = i;
+        scored[matched].index = i;
+        scored[matched].score = match(run->query, run->names[i]);
+        matched++;
+    }
+
+    top_k_sort(scored, (size_t)matched, sizeof(ScoredName), (size_t)run->k, compare_scored_names);
+    chunk->matched = matched;
+}
+
+static void pool_worker(gpointer data, gpointer user_data) {
+    (void)user_data;
+    NameScorerChunk *chunk = (NameScorerChunk *)data;
+    NameScorerRun *run = chunk->run;
+
+    score_chunk(chunk);
+
+    g_mutex_lock(&run->lock);
+    if (--run->pending == 0) g_cond_signal(&run->done);
+    g_mutex_unlock(&run->lock);
+}
+
+// Fixed set of worker threads, started on first use and shared by every
+// caller; chunks past the thread count wait in the pool's queue
+static GThreadPool *get_pool(void) {
+    static gsize initialized = 0;
+    if (g_once_init_enter(&initialized)) {
+        pool = g_thread_pool_new(pool_worker, NULL, NAME_SCORER_MAX_THREADS - 1, TRUE, NULL);
+        g_once_init_leave(&initialized, 1);
+    }
+    return pool;
+}
+
+static int pick_threads(int threads, int candidate_count) {
+    if (threads <= 0) {
+        if (candidate_count < NAME_SCORER_PARALLEL_MIN) return 1;
+        threads = (int)g_get_num_processors();
+    }
+    if (threads > NAME_SCORER_MAX_THREADS) threads = NAME_SCORER_MAX_THREADS;
+    if (threads > candidate_count) threads = candidate_count;
+    return threads > 0 ? threads : 1;
+}
+
+int name_scorer_run(const char *query,
+                    const char *const *names, const guint64 *masks,
+                    const int *candidates, int candidate_count,
+                    int threads, int k,
+                    ScoredName *scored, int *survivors,
+                    GCancellable *cancellable) {
+    NameScorerRun run = {
+        .query = query,
+        .query_mask = fzf_char_mask(query),
+        .names = names,
+        .masks = masks,
+        .candidates = candidates,
+        .k = k,
+        .scored = scored,
+        .survivors = survivors,
+        .cancellable = cancellable,
+    };
+
+    threads = pick_threads(threads, candidate_count);
+    if (threads == 1) {
+        NameScorerChunk chunk = { .run = &run, .start = 0, .end = candidate_count };
+        score_chunk(&chunk);
+        return chunk.cancelled ? -1 : chunk.matched;
+    }
+
+    // Even slices; this thread scores the first one while the pool does the rest
+    NameScorerChunk chunks[NAME_SCORER_MAX_THREADS];
+    for (int t = 0; t < threads; t++) {
+        chunks[t] = (NameScorerChunk){
+            .run = &run,
+            .start = (int)((gint64)candidate_count * t / threads),
+            .end = (int)((gint64)candidate_count * (t + 1) / threads),
+        };
+    }
+
+    g_mutex_init(&run.lock);
+    g_cond_init(&run.done);
+    run.pending = threads - 1;
+    GThreadPool *workers = get_pool();
+    for (int t = 1; t < threads; t++) {
+        g_thread_pool_push(workers, &chunks[t], NULL);
+    }
+    score_chunk(&chunks[0]);
+
+    g_mutex_lock(&run.lock);
+    while (run.pending > 0) g_cond_wait(&run.done, &run.lock);
+    g_mutex_unlock(&run.lock);
+    g_cond_clear(&run.done);
+    g_mutex_clear(&run.lock);
+
+    // Merge: slices are in candidate order, so packing their survivors
+    // keeps that order. Every overall top-k match is in its slice's top k,
+    // so ranking the packed slice fronts gives the single-thread front.
+    int matched = 0;
+    int fronts = 0;
+    for (int t = 0; t < threads; t++) {
+        if (chunks[t].cancelled) return -1;
+        int front = chunks[t].matched < k ? chunks[t].matched : k;
+        memmove(survivors + matched, survivors + chunks[t].start,
+                (size_t)chunks[t].matched * sizeof(int));
+        memmove(scored + fronts, scored + chunks[t].start, (size_t)front * sizeof(ScoredName));
+        matched += chunks[t].matched;
+        fronts += front;
+    }
+    top_k_sort(scored, (size_t)fronts, sizeof(ScoredName), (size_t)k, compare_scored_names);
+    return matched;
+}
@@ -0,0 +1,36 @@
+#ifndef NAME_SCORER_H
+#define NAME_SCORER_H
+
+#include <gio/gio.h>
+
+#include "match.h"
+
+// Below this many candidates one thread scores them all
+#define NAME_SCORER_PARALLEL_MIN 2048
+#define NAME_SCORER_MAX_THREADS     8
+
+typedef struct {
+    int index;          // into the names array
+    score_t score;
+} ScoredName;
+
+// Score every candidate name that contains query (case-insensitive
+// substring, gated by masks = fzf_char_mask() of each name) with match().
+//
+// survivors receives the matching indices in candidate order. The best k
+// matches lead scored in rank order (score, then index; keep names sorted
+// for alphabetical ties); scored entries after those are unspecified.
+// Both arrays must hold candidate_count entries.
+//
+// candidates lists the indices to consider, or NULL for 0..count-1.
+// threads 0 picks one per core (capped at NAME_SCORER_MAX_THREADS) once
+// there are NAME_SCORER_PARALLEL_MIN candidates; any thread count gives
+// the same result. Returns the number of matches, or -1 if cancelled.
+int name_scorer_run(const char *query,
+                    const char *const *names, const guint64 *masks,
+                    const int *candidates, int candidate_count,
+                    int threads, int k,
+                    ScoredName *scored, int *survivors,
+                    GCancellable *cancellable);
+
+#endif // NAME_SCORER_H
@@ -4,20 +4,15 @@
 #include "log.h"
 #include "window_matcher.h"
 #include "utils.h"
+#include "window_store.h"
 
 void init_named_window_manager(NamedWindowManager *manager) {
     if (!manager) return;
     
+    manager->entries = NULL;
     manager->count = 0;
-    for (int i = 0; i < MAX_WINDOWS; i++) {
-        manager->entries[i].assigned = 0;
-        manager->entries[i].id = 0;
-        manager->entries[i].custom_name[0] = '\0';
-        manager->entries[i].original_title[0] = '\0';
-        manager->entries[i].class_name[0] = '\0';
-        manager->entries[i].instance[0] = '\0';
-        manager->entries[i].type[0] = '\0';
-    }
+    manager->capacity = 0;
+    window_registry_init(&manager->index);
 }
 
 void assign_custom_name(NamedWindowManager *manager, const WindowInfo *window, const char *custom_name) {
@@ -32,12 +27,13 @@ void assign_custom_name(NamedWindowManager *manager, const WindowInfo *window, c
         log_info("Updated custom name for window 0x%lx to '%s'", window->id, custom_name);
     } else {
         // Add new named window
-        if (manager->count >= MAX_WINDOWS) {
-            log_error("Cannot add more named windows, limit reached");
+        if (!GROW_ARRAY(manager->entries, manager->capacity, manager->count + 1)) {
+            log_error("Cannot add more named windows, out of memory");
             return;
         }
         
         NamedWindow *entry = &manager->entries[manager->count];
+        memset(entry, 0, sizeof(*entry));
         entry->id = window->id;
         safe_string_copy(entry->custom_name, custom_name, MAX_TITLE_LEN);
         
@@ -62,6 +58,7 @@ void assign_custom_name(NamedWindowManager *manager, const WindowInfo *window, c
         safe_string_copy(entry->type, window->type, 16);
         entry->assigned = 1;
         
+        window_registry_put(&manager->index, entry->id, manager->count);
         manager->count++;
         log_info("Assigned custom name '%s' to window 0x%lx", custom_name, window->id);
     }
@@ -70,10 +67,9 @@ void assign_custom_name(NamedWindowManager *manager, const WindowInfo *window, c
 const char* get_window_custom_name(const NamedWindowManager *manager, Window id) {
     if (!manager || id == 0) return NULL;
     
-    for (int i = 0; i < manager->count; i++) {
-        if (manager->entries[i].id == id && manager->entries[i].assigned) {
-            return manager->entries[i].custom_name;
-        }
+    int i = find_named_window_index(manager, id);
+    if (i >= 0 && manager->entries[i].assigned) {
+        return manager->entries[i].custom_name;
     }
     return NULL;
 }
@@ -97,6 +93,47 @@ static int window_matches_named_entry(const WindowInfo *window, const NamedWindo
     return wildcard_match(entry->original_title, window->title);
 }
 
+// Try to move a name whose window is gone onto a matching window.
+// Returns 1 if the name was reassigned.
+static int reassign_orphaned_name(NamedWindowManager *manager, NamedWindow *entry,
+                                  WindowInfo *windows, int window_count) {
+    log_trace("Window 0x%lx with name '%s' no longer exists, looking for replacement",
+             entry->id, entry->custom_name);
+    log_trace("Looking for: class='%s', instance='%s', type='%s', title='%s'",
+             entry->class_name, entry->instance, entry->type, entry->original_title);
+
+    // Mark as orphaned first
+    Window old_id = entry->id;
+    entry->assigned = 0;
+
+    // Look for a matching window
+    for (int j = 0; j < window_count; j++) {
+        // CRITICAL: Skip if this window already has a custom name
+        if (is_window_already_named(manager, windows[j].id)) {
+            log_trace("Window 0x%lx already has a custom name, skipping", windows[j].id);
+            continue;
+        }
+
+        log_trace("Checking window %d: class='%s', instance='%s', type='%s', title='%s'",
+                 j, windows[j].class_name, windows[j].instance, windows[j].type, windows[j].title);
+
+        // Use wildcard matching
+        if (window_matches_named_entry(&windows[j], entry)) {
+            // Found a match! Reassign the name
+            entry->id = windows[j].id;
+            entry->assigned = 1;
+            reindex_named_windows(manager);
+            log_info("Automatically reassigned name '%s' from window 0x%lx to 0x%lx",
+                    entry->custom_name, old_id, windows[j].id);
+            return 1;
+        }
+    }
+
+    log_trace("Could not find matching window for name '%s', marked as orphaned",
+            entry->custom_name);
+    return 0;
+}
+
 bool check_and_reassign_names(NamedWindowManager *manager, WindowInfo *windows, int window_count) {
     if (!manager || !windows) return false;
     
@@ -127,42 +164,7 @@ bool check_and_reassign_names(NamedWindowManager *manager, WindowInfo *windows,
         
         // If window doesn't exist anymore, try to find a matching window
         if (!window_still_exists) {
-            log_trace("Window 0x%lx with name '%s' no longer exists, looking for replacement",
-                     entry->id, entry->custom_name);
-            log_trace("Looking for: class='%s', instance='%s', type='%s', title='%s'",
-                     entry->class_name, entry->instance, entry->type, entry->original_title);
-            
-            // Mark as orphaned first
-            Window old_id = entry->id;
-            entry->assigned = 0;
-            
-            // Look for a matching window
-            for (int j = 0; j < window_count; j++) {
-                // CRITICAL: Skip if this window already has a custom name
-                if (is_window_already_named(manager, windows[j].id)) {
-                    log_trace("Window 0x%lx already has a custom name, skipping", windows[j].id);
-                    continue;
-                }
-                
-                log_trace("Checking window %d: class='%s', instance='%s', type='%s', title='%s'",
-                         j, windows[j].class_name, windows[j].instance, windows[j].type, windows[j].title);
-                
-                // Use wildcard matching
-                if (window_matches_named_entry(&windows[j], entry)) {
-                    // Found a match! Reassign the name
-                    entry->id = windows[j].id;
-                    entry->assigned = 1;
-                    config_changed = 1;
-                    log_info("Automatically reassigned name '%s' from window 0x%lx to 0x%lx",
-                            entry->custom_name, old_id, windows[j].id);
-                    break;
-                }
-            }
-            
-            if (!entry->assigned) {
-                log_trace("Could not find matching window for name '%s', marked as orphaned",
-                        entry->custom_name);
-            }
+            config_changed |= reassign_orphaned_name(manager, entry, windows, window_count);
         }
     }
     
@@ -172,6 +174,30 @@ bool check_and_reassign_names(NamedWindowManager *manager, WindowInfo *windows,
     return config_changed;
 }
 
+bool check_and_reassign_names_delta(NamedWindowManager *manager, WindowInfo *windows,
+                                    int window_count, const WindowListDelta *delta) {
+    if (!manager || !windows || !delta) return false;
+
+    int config_changed = 0;
+
+    // Only names whose window just closed need work: any current window
+    // (including the added ones) may take them over. Entries that stayed
+    // orphaned are left alone, same as check_and_reassign_names().
+    for (int r = 0; r < delta->removed_count; r++) {
+        for (int i = 0; i < manager->count; i++) {
+            NamedWindow *entry = &manager->entries[i];
+            if (entry->assigned && entry->id == delta->removed[r]) {
+                config_changed |= reassign_orphaned_name(manager, entry, windows, window_count);
+            }
+        }
+    }
+
+    if (config_changed) {
+        log_debug("Named windows were automatically reassigned");
+    }
+    return config_changed;
+}
+
 void delete_custom_name(NamedWindowManager *manager, int index) {
     if (!manager || index < 0 || index >= manager->count) return;
     
@@ -188,6 +214,7 @@ void delete_custom_name(NamedWindowManager *manager, int index) {
     manager->entries[manager->count - 1].id = 0;
     
     manager->count--;
+    reindex_named_windows(manager);
 }
 
 void update_custom_name(NamedWindowManager *manager, int index, const char *new_name) {
@@ -207,12 +234,19 @@ NamedWindow* get_named_window_by_index(NamedWindowManager *manager, int index) {
 int find_named_window_index(const NamedWindowManager *manager, Window id) {
     if (!manager || id == 0) return -1;
 
+    int i = window_registry_get(&manager->index, id);
+    return (i >= 0 && i < manager->count && manager->entries[i].id == id) ? i : -1;
+}
+
+void reindex_named_windows(NamedWindowManager *manager) {
+    if (!manager) return;
+
+    window_registry_clear(&manager->index);
     for (int i = 0; i < manager->count; i++) {
-        if (manager->entries[i].id == id) {
-            return i;
+        if (!window_registry_contains(&manager->index, manager->entries[i].id)) {
+            window_registry_put(&manager->index, manager->entries[i].id, i);
         }
     }
-    return -1;
 }
 
 int find_named_window_by_name(const NamedWindowManager *manager, const char *custom_name) {
@@ -5,6 +5,8 @@
 #include <stdbool.h>
 #include "window_info.h"
 #include "constants.h"
+#include "window_list.h"
+#include "window_registry.h"
 
 // Structure to store a custom window name
 typedef struct NamedWindow {
@@ -19,8 +21,10 @@ typedef struct NamedWindow {
 
 // Manager for all named windows
 typedef struct {
-    NamedWindow entries[MAX_WINDOWS];
+    NamedWindow *entries;  // Grows as names are added
     int count;
+    int capacity;
+    WindowRegistry index;  // Window ID -> first entry with that ID
 } NamedWindowManager;
 
 // Initialize the named window manager
@@ -39,6 +43,10 @@ int is_window_already_named(const NamedWindowManager *manager, Window id);
 // Returns true if any names were reassigned
 bool check_and_reassign_names(NamedWindowManager *manager, WindowInfo *windows, int window_count);
 
+// Same, but only considers names whose window left in an incremental list update
+bool check_and_reassign_names_delta(NamedWindowManager *manager, WindowInfo *windows,
+                                    int window_count, const WindowListDelta *delta);
+
 // Delete a custom name by index
 void delete_custom_name(NamedWindowManager *manager, int index);
 
@@ -51,6 +59,9 @@ NamedWindow* get_named_window_by_index(NamedWindowManager *manager, int index);
 // Find named window index by window ID
 int find_named_window_index(const NamedWindowManager *manager, Window id);
 
+// Rebuild the ID index after entries were written directly (config load)
+void reindex_named_windows(NamedWindowManager *manager);
+
 // Find named window index by custom name
 int find_named_window_by_name(const NamedWindowManager *manager, const char *custom_name);
 
@@ -1,6 +1,7 @@
 #include "named_window_config.h"
 #include "log.h"
 #include "utils.h"
+#include "window_store.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -210,7 +211,7 @@ void load_named_windows(NamedWindowManager *manager) {
         } else if (in_array && strstr(p, "}")) {
             if (in_entry && temp_entry.id != 0) {
                 // End of entry, save it
-                if (manager->count < MAX_WINDOWS) {
+                if (GROW_ARRAY(manager->entries, manager->capacity, manager->count + 1)) {
                     manager->entries[manager->count] = temp_entry;
                     manager->count++;
                 }
@@ -226,5 +227,6 @@ void load_named_windows(NamedWindowManager *manager) {
     }
     
     fclose(file);
+    reindex_named_windows(manager);
     log_info("Loaded %d named windows from %s", manager->count, path);
 }
\ No newline at end of file
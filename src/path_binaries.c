@@ -6,8 +6,11 @@
 
 #include "app_data.h"
 #include "display.h"
+#include "fzf_algo.h"
 #include "log.h"
 #include "match.h"
+#include "name_scorer.h"
+#include "selection.h"
 #include "tab_switching.h"
 
 typedef struct {
@@ -38,26 +41,184 @@ static int path_entry_cmp(const void *a, const void *b) {
     return g_utf8_collate(left->name, right->name);
 }
 
+// Immutable copy of the cache names a filter worker scores against. One is
+// built per cache generation and shared by reference; the main thread may
+// change s_path_entries while a worker still holds the old one.
+typedef struct {
+    gint ref_count;
+    guint generation;
+    int count;
+    const char **names;   // Into `blob`; same indices as s_path_entries
+    guint64 *masks;
+    char *blob;
+} PathSnapshot;
+
+// One query against one snapshot. Runs inline for path_binaries_filter()
+// and on a worker thread for path_binaries_filter_async().
+typedef struct {
+    PathSnapshot *snapshot;
+    char *query;
+    int *candidates;          // Survivors of the previous query, or NULL for all
+    int candidate_count;
+    ScoredName *scored;       // Matches; the best MAX_APPS ranked first
+    int scored_count;
+    int *survivors;           // Matches in cache order, for the next query
+    guint seq;
+    AppData *app;
+    gint64 keystroke_us;
+} PathFilterJob;
+
+static PathSnapshot *s_snapshot = NULL;     // Snapshot of the current generation
+static guint s_cache_generation = 0;
+static guint s_filter_seq = 0;              // Latest filter request; older results are dropped
+static GCancellable *s_filter_cancellable = NULL;
+static int s_filter_jobs_in_flight = 0;
+
+// Entries that matched the last non-empty query. A query containing that
+// one can only match a subset of them (substring filter), so it rescores
+// just these instead of the whole cache.
+static int *s_survivors = NULL;             // Indices into s_path_entries, in cache order
+static int s_survivor_count = 0;
+static char s_survivor_query[256];
+static gboolean s_survivors_valid = FALSE;
+static int s_last_scan_count = 0;           // Entries checked by the last filter call
+
+static void snapshot_unref(PathSnapshot *snapshot) {
+    if (snapshot && g_atomic_int_dec_and_test(&snapshot->ref_count)) {
+        g_free(snapshot->names);
+        g_free(snapshot->masks);
+        g_free(snapshot->blob);
+        g_free(snapshot);
+    }
+}
+
+// Call whenever s_path_entries changes (indices and membership go stale)
+static void path_cache_changed(void) {
+    s_survivors_valid = FALSE;
+    s_survivor_count = 0;
+    s_cache_generation++;
+    snapshot_unref(s_snapshot);
+    s_snapshot = NULL;
+}
+
+static PathSnapshot *acquire_snapshot(void) {
+    if (!s_snapshot) {
+        PathSnapshot *snapshot = g_new0(PathSnapshot, 1);
+        snapshot->ref_count = 1;
+        snapshot->generation = s_cache_generation;
+        snapshot->count = s_path_count;
+        snapshot->names = g_new(const char *, s_path_count + 1);
+        snapshot->masks = g_new(guint64, s_path_count + 1);
+
+        size_t blob_size = 0;
+        for (int i = 0; i < s_path_count; i++) blob_size += strlen(s_path_entries[i].name) + 1;
+        snapshot->blob = g_malloc(blob_size + 1);
+
+        char *next = snapshot->blob;
+        for (int i = 0; i < s_path_count; i++) {
+            size_t len = strlen(s_path_entries[i].name) + 1;
+            memcpy(next, s_path_entries[i].name, len);
+            snapshot->names[i] = next;
+            snapshot->masks[i] = s_path_entries[i].name_mask;
+            next += len;
+        }
+        s_snapshot = snapshot;
+    }
+    g_atomic_int_inc(&s_snapshot->ref_count);
+    return s_snapshot;
+}
+
 static void sort_path_entries(void) {
     qsort(s_path_entries, (size_t)s_path_count, sizeof(AppEntry), path_entry_cmp);
+    path_cache_changed();
 }
 
-typedef struct {
-    AppEntry entry;
-    score_t score;
-} ScoredPathEntry;
+// Set up a job for `query`; refines the previous survivors when it can
+static PathFilterJob *path_filter_job_new(const char *query) {
+    PathFilterJob *job = g_new0(PathFilterJob, 1);
+    job->snapshot = acquire_snapshot();
+    job->query = g_strdup(query);
+
+    /* When the query contains the previous one (typing on), only the
+     * previous survivors can still match; edits and deletions rescan. */
+    gboolean refine = s_survivors_valid && strcasestr(query, s_survivor_query) != NULL;
+    if (refine) {
+        job->candidates = g_new(int, s_survivor_count + 1);
+        memcpy(job->candidates, s_survivors, sizeof(int) * (size_t)s_survivor_count);
+        job->candidate_count = s_survivor_count;
+    } else {
+        job->candidate_count = job->snapshot->count;
+    }
+    job->scored = g_new(ScoredName, job->candidate_count + 1);
+    job->survivors = g_new(int, job->candidate_count + 1);
+    return job;
+}
 
-static int scored_path_entry_cmp(const void *a, const void *b) {
-    const ScoredPathEntry *left = (const ScoredPathEntry *)a;
-    const ScoredPathEntry *right = (const ScoredPathEntry *)b;
-    if (left->score > right->score) return -1;
-    if (left->score < right->score) return 1;
-    return g_utf8_collate(left->entry.name, right->entry.name);
+static void path_filter_job_free(gpointer data) {
+    PathFilterJob *job = (PathFilterJob *)data;
+    snapshot_unref(job->snapshot);
+    g_free(job->query);
+    g_free(job->candidates);
+    g_free(job->scored);
+    g_free(job->survivors);
+    g_free(job);
+}
+
+// Score the job's candidates; touches nothing but the job, so it is safe
+// on a worker thread. Returns FALSE when cancelled part way.
+static gboolean score_path_job(PathFilterJob *job, GCancellable *cancellable) {
+    /* Score ALL substring-matching entries (up to cache cap MAX_PATH_BINS),
+     * then rank the best MAX_APPS. Capping during the scoring loop would
+     * drop high-score entries that appear late in the alphabetically-sorted
+     * cache when >MAX_APPS entries match. Large caches are split across
+     * cores; the result does not depend on the split. */
+    int matched = name_scorer_run(job->query,
+                                  job->snapshot->names, job->snapshot->masks,
+                                  job->candidates, job->candidate_count,
+                                  0, MAX_APPS,
+                                  job->scored, job->survivors,
+                                  cancellable);
+    if (matched < 0) return FALSE;
+    job->scored_count = matched;
+    return TRUE;
+}
+
+// Publish a scored job (main thread, same cache generation as the job)
+static void apply_path_job(PathFilterJob *job, AppEntry *out, int *out_count) {
+    s_last_scan_count = job->candidate_count;
+
+    // The job's survivors become the refinement state for the next query
+    g_free(s_survivors);
+    s_survivors = job->survivors;
+    job->survivors = NULL;
+    s_survivor_count = job->scored_count;
+    s_survivors_valid = strlen(job->query) < sizeof(s_survivor_query);
+    if (s_survivors_valid) {
+        g_strlcpy(s_survivor_query, job->query, sizeof(s_survivor_query));
+    }
+
+    int copy_count = job->scored_count < MAX_APPS ? job->scored_count : MAX_APPS;
+    for (int i = 0; i < copy_count; i++) {
+        out[i] = s_path_entries[job->scored[i].index];
+    }
+    *out_count = copy_count;
+}
+
+// Drop whatever worker result is still on its way
+static void cancel_pending_filter(void) {
+    s_filter_seq++;
+    if (s_filter_cancellable) {
+        g_cancellable_cancel(s_filter_cancellable);
+        g_clear_object(&s_filter_cancellable);
+    }
 }
 
 static void filter_path_entries(const char *query, AppEntry *out, int *out_count) {
     if (!out || !out_count) return;
 
+    // A synchronous answer supersedes any pending worker result
+    cancel_pending_filter();
+
     if (!query || query[0] == '\0') {
         int count = s_path_count < MAX_APPS ? s_path_count : MAX_APPS;
         memcpy(out, s_path_entries, (size_t)count * sizeof(AppEntry));
@@ -65,33 +226,10 @@ static void filter_path_entries(const char *query, AppEntry *out, int *out_count
         return;
     }
 
-    /* Score ALL substring-matching entries (up to cache cap MAX_PATH_BINS),
-     * then sort, then copy at most MAX_APPS into out[]. Capping during the
-     * scoring loop would drop high-score entries that appear late in the
-     * alphabetically-sorted cache when >MAX_APPS entries match.
-     * Heap-allocated: MAX_PATH_BINS entries at ~1.5 KB each would be ~6 MB
-     * on the stack, uncomfortably close to the default 8 MB thread limit. */
-    ScoredPathEntry *scored = g_new(ScoredPathEntry, MAX_PATH_BINS);
-    int scored_count = 0;
-
-    for (int i = 0; i < s_path_count; i++) {
-        if (!strcasestr(s_path_entries[i].name, query)) {
-            continue;
-        }
-        score_t score = match(query, s_path_entries[i].name);
-        scored[scored_count].entry = s_path_entries[i];
-        scored[scored_count].score = score;
-        scored_count++;
-    }
-
-    qsort(scored, (size_t)scored_count, sizeof(ScoredPathEntry), scored_path_entry_cmp);
-
-    int copy_count = scored_count < MAX_APPS ? scored_count : MAX_APPS;
-    for (int i = 0; i < copy_count; i++) {
-        out[i] = scored[i].entry;
-    }
-    *out_count = copy_count;
-    g_free(scored);
+    PathFilterJob *job = path_filter_job_new(query);
+    score_path_job(job, NULL);
+    apply_path_job(job, out, out_count);
+    path_filter_job_free(job);
 }
 
 static void warn_path_cache_cap_once(void) {
@@ -113,6 +251,7 @@ static void ensure_seen_table(void) {
 
 static void clear_cache(void) {
     s_path_count = 0;
+    path_cache_changed();
     ensure_seen_table();
     g_hash_table_remove_all(s_seen_by_name);
 }
@@ -127,8 +266,7 @@ static void maybe_refresh_apps_tab(AppData *app) {
         return;
     }
 
-    filter_apps(app, text);
-    update_display(app);
+    path_binaries_filter_async(app, text + 1, 0);
 }
 
 static gboolean path_entry_from_file(const char *full_path, const char *basename, AppEntry *out) {
@@ -174,10 +312,12 @@ static void merge_entries(const AppEntry *entries, int count) {
         }
 
         s_path_entries[s_path_count] = *entry;
+        s_path_entries[s_path_count].name_mask = fzf_char_mask(entry->name);
         g_hash_table_insert(s_seen_by_name,
                             g_strdup(entry->name),
                             g_strdup(entry->exec_path));
         s_path_count++;
+        path_cache_changed();
     }
 }
 
@@ -404,6 +544,7 @@ static gboolean remove_path_entry_by_name(const char *basename, const char *full
             s_path_entries[j] = s_path_entries[j + 1];
         }
         s_path_count--;
+        path_cache_changed();
         g_hash_table_remove(s_seen_by_name, basename);
         return TRUE;
     }
@@ -440,6 +581,7 @@ static gboolean add_path_entry_if_new(const char *full_path) {
         return FALSE;
     }
 
+    entry.name_mask = fzf_char_mask(entry.name);
     s_path_entries[s_path_count++] = entry;
     g_hash_table_insert(s_seen_by_name, basename, g_strdup(full_path));
     sort_path_entries();
@@ -535,11 +677,80 @@ void path_binaries_filter(const char *query, AppEntry *out, int *out_count) {
               elapsed_ms);
 }
 
+static void path_filter_thread(GTask *task,
+                               gpointer source_object,
+                               gpointer task_data,
+                               GCancellable *cancellable) {
+    (void)source_object;
+    g_task_return_boolean(task, score_path_job((PathFilterJob *)task_data, cancellable));
+}
+
+static void path_filter_done_cb(GObject *source_object, GAsyncResult *result, gpointer user_data) {
+    (void)source_object;
+    (void)user_data;
+    GTask *task = G_TASK(result);
+    PathFilterJob *job = (PathFilterJob *)g_task_get_task_data(task);
+    gboolean scored = g_task_propagate_boolean(task, NULL);
+    s_filter_jobs_in_flight--;
+
+    // Superseded by a newer keystroke, or the user left the apps tab
+    if (!scored || job->seq != s_filter_seq) return;
+    AppData *app = job->app;
+    if (!app || app->current_tab != TAB_APPS) return;
+
+    // The cache changed under the worker; its indices no longer line up
+    if (job->snapshot->generation != s_cache_generation) {
+        path_binaries_filter_async(app, job->query, job->keystroke_us);
+        return;
+    }
+
+    apply_path_job(job, app->filtered_apps, &app->filtered_apps_count);
+    if (job->keystroke_us == 0) {
+        update_display(app);
+        return;
+    }
+    reset_selection(app);
+    update_display(app);
+    log_debug("Keystroke to results: %.2fms ('$%s', %d results)",
+              (double)(g_get_monotonic_time() - job->keystroke_us) / 1000.0,
+              job->query, app->filtered_apps_count);
+}
+
+void path_binaries_filter_async(AppData *app, const char *query, gint64 keystroke_us) {
+    const char *safe_query = query ? query : "";
+    if (safe_query[0] == '\0') {
+        // Nothing to score; answer right away
+        path_binaries_filter(safe_query, app->filtered_apps, &app->filtered_apps_count);
+        if (keystroke_us != 0) reset_selection(app);
+        update_display(app);
+        return;
+    }
+
+    cancel_pending_filter();
+    s_filter_cancellable = g_cancellable_new();
+
+    PathFilterJob *job = path_filter_job_new(safe_query);
+    job->seq = s_filter_seq;
+    job->app = app;
+    job->keystroke_us = keystroke_us;
+
+    GTask *task = g_task_new(NULL, s_filter_cancellable, path_filter_done_cb, NULL);
+    g_task_set_task_data(task, job, path_filter_job_free);
+    s_filter_jobs_in_flight++;
+    g_task_run_in_thread(task, path_filter_thread);
+    g_object_unref(task);
+}
+
+void path_binaries_cancel_filter(void) {
+    cancel_pending_filter();
+}
+
 gboolean path_binaries_is_scanning(void) {
     return s_scanning;
 }
 
 void path_binaries_shutdown(void) {
+    cancel_pending_filter();
     clear_monitors();
     if (s_seen_by_name) {
         g_hash_table_destroy(s_seen_by_name);
@@ -577,6 +788,7 @@ void path_binaries_on_monitor_event_test_hook(GFile *file,
 }
 
 void path_binaries_reset_for_tests(void) {
+    cancel_pending_filter();
     clear_cache();
     clear_monitors();
     s_loaded = FALSE;
@@ -598,4 +810,12 @@ int path_binaries_cap_warn_count_for_tests(void) {
 int path_binaries_count_for_tests(void) {
     return s_path_count;
 }
+
+int path_binaries_last_scan_count_for_tests(void) {
+    return s_last_scan_count;
+}
+
+gboolean path_binaries_filter_pending_for_tests(void) {
+    return s_filter_jobs_in_flight > 0;
+}
 #endif
@@ -12,6 +12,14 @@ typedef struct AppData AppData;
 
 void path_binaries_ensure_loaded(AppData *app);
 void path_binaries_filter(const char *query, AppEntry *out, int *out_count);
+// Score query on a worker thread against a snapshot of the cache and
+// publish into app->filtered_apps once it lands. A newer call, or any
+// synchronous filter, cancels it; the rows on screen stay until then.
+// keystroke_us is when the typed change arrived (resets the selection and
+// logs keystroke-to-results latency), or 0 for a cache refresh.
+void path_binaries_filter_async(AppData *app, const char *query, gint64 keystroke_us);
+// Drop a pending path_binaries_filter_async() result (query left `$` mode)
+void path_binaries_cancel_filter(void);
 gboolean path_binaries_is_scanning(void);
 void path_binaries_shutdown(void);
 
@@ -27,6 +35,8 @@ void path_binaries_reset_for_tests(void);
 gboolean path_binaries_cap_warned_for_tests(void);
 int path_binaries_cap_warn_count_for_tests(void);
 int path_binaries_count_for_tests(void);
+int path_binaries_last_scan_count_for_tests(void);
+gboolean path_binaries_filter_pending_for_tests(void);
 #endif
 
 #endif // PATH_BINARIES_H
@@ -0,0 +1,231 @@
+#define _GNU_SOURCE
+#include "query_plan.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+// Exact and anchored hits score like fzf's per-character match score, so
+// they weigh about the same as a fuzzy term of the same length
+#define QUERY_EXACT_CHAR_SCORE 16
+
+// Next space-separated token of *cursor into token; "\ " is a literal
+// space and sets *escaped. Returns false once the query is used up.
+static bool next_token(const char **cursor, char *token, size_t size, bool *escaped) {
+    const char *p = *cursor;
+    while (*p == ' ') p++;
+    if (!*p) return false;
+
+    size_t len = 0;
+    *escaped = false;
+    while (*p && *p != ' ') {
+        if (p[0] == '\\' && p[1] == ' ') {
+            *escaped = true;
+            p++;
+        }
+        if (len + 1 < size) token[len++] = *p;
+        p++;
+    }
+    token[len] = '\0';
+    *cursor = p;
+    return true;
+}
+
+static QueryField scope_field(char scope) {
+    switch (tolower((unsigned char)scope)) {
+        case 't': return QUERY_FIELD_TITLE;
+        case 'c': return QUERY_FIELD_CLASS;
+        case 'w': return QUERY_FIELD_WORKSPACE;
+        default:  return QUERY_FIELD_ANY;
+    }
+}
+
+// Parse one token; returns false if it has no text yet (a lone "!" or "^"
+// while typing), which the plan skips. *special is set if the token used
+// any operator.
+static bool parse_term(QueryTerm *term, const char *token, bool *special) {
+    const char *text = token;
+    term->negated = false;
+    term->field = QUERY_FIELD_ANY;
+
+    if (*text == '!') {
+        term->negated = true;
+        text++;
+    }
+    if (text[0] && text[1] == ':' && scope_field(text[0]) != QUERY_FIELD_ANY) {
+        term->field = scope_field(text[0]);
+        text += 2;
+    }
+
+    bool exact = false;
+    bool prefix = false;
+    if (*text == '\'') {
+        exact = true;
+        text++;
+    } else if (*text == '^') {
+        prefix = true;
+        text++;
+    }
+
+    size_t len = strlen(text);
+    bool suffix = len > 1 && text[len - 1] == '$';
+    if (suffix) len--;
+    if (len == 0) return false;
+
+    if (prefix && suffix) {
+        term->kind = QUERY_EQUAL;
+    } else if (prefix) {
+        term->kind = QUERY_PREFIX;
+    } else if (suffix) {
+        term->kind = QUERY_SUFFIX;
+    } else if (exact || term->negated || term->field != QUERY_FIELD_ANY) {
+        // "!fire" means "does not contain fire"; "c:fire" narrows to
+        // classes containing it
+        term->kind = QUERY_EXACT;
+    } else {
+        term->kind = QUERY_FUZZY;
+    }
+    if (term->field == QUERY_FIELD_WORKSPACE) {
+        term->kind = QUERY_EQUAL;  // w:1 must not match workspace 10
+    }
+
+    char needle[FZF_MAX_LEN];
+    memcpy(needle, text, len);
+    needle[len] = '\0';
+    fzf_pattern_compile(&term->pattern, needle);
+
+    *special |= term->negated || term->field != QUERY_FIELD_ANY || term->kind != QUERY_FUZZY;
+    return true;
+}
+
+// Cheap groups first; stable, so equal groups keep the order typed
+static void order_groups(QueryPlan *plan) {
+    for (int i = 1; i < plan->group_count; i++) {
+        QueryGroup group = plan->groups[i];
+        int j = i;
+        while (j > 0 && plan->groups[j - 1].fuzzy && !group.fuzzy) {
+            plan->groups[j] = plan->groups[j - 1];
+            j--;
+        }
+        plan->groups[j] = group;
+    }
+}
+
+bool query_plan_parse(QueryPlan *plan, const char *query) {
+    plan->term_count = 0;
+    plan->group_count = 0;
+
+    bool special = false;
+    bool join_next = false;
+    bool escaped = false;
+    const char *cursor = query ? query : "";
+    char token[FZF_MAX_LEN];
+
+    while (next_token(&cursor, token, sizeof(token), &escaped)) {
+        special |= escaped;
+        if (strcmp(token, "|") == 0) {
+            join_next = plan->group_count > 0;
+            special = true;
+            continue;
+        }
+        if (plan->term_count == QUERY_MAX_TERMS) break;
+
+        QueryTerm *term = &plan->terms[plan->term_count];
+        if (!parse_term(term, token, &special)) continue;
+
+        QueryGroup *group;
+        if (join_next) {
+            group = &plan->groups[plan->group_count - 1];
+            group->count++;
+        } else {
+            group = &plan->groups[plan->group_count++];
+            group->first = plan->term_count;
+            group->count = 1;
+            group->fuzzy = false;
+        }
+        group->fuzzy |= term->kind == QUERY_FUZZY && !term->negated;
+        plan->term_count++;
+        join_next = false;
+    }
+
+    order_groups(plan);
+    plan->extended = special || plan->term_count > 1;
+    return plan->extended;
+}
+
+// Exact or anchored hit of term in one field
+static bool field_has(const QueryTerm *term, const char *field) {
+    const char *text = term->pattern.text;
+    size_t len = (size_t)term->pattern.len;
+
+    switch (term->kind) {
+        case QUERY_EXACT:
+            return strcasestr(field, text) != NULL;
+        case QUERY_PREFIX:
+            return strncasecmp(field, text, len) == 0;
+        case QUERY_SUFFIX: {
+            size_t field_len = strlen(field);
+            return field_len >= len && strcasecmp(field + field_len - len, text) == 0;
+        }
+        case QUERY_EQUAL:
+            return strcasecmp(field, text) == 0;
+        case QUERY_FUZZY:
+            break;
+    }
+    return false;
+}
+
+// Score of the term's positive form, SCORE_MIN if it does not match
+static score_t match_term(const QueryTerm *term, const WindowInfo *win,
+                          const FzfHaystack *display) {
+    score_t exact_score = (score_t)term->pattern.len * QUERY_EXACT_CHAR_SCORE;
+    bool hit = false;
+
+    switch (term->field) {
+        case QUERY_FIELD_ANY:
+            if (term->kind == QUERY_FUZZY) return fzf_match_compiled(&term->pattern, display);
+            if (term->kind == QUERY_EXACT) {
+                hit = strstr(display->text, term->pattern.text) != NULL;
+            } else {
+                hit = field_has(term, win->title) || field_has(term, win->class_name) ||
+                      field_has(term, win->instance);
+            }
+            break;
+        case QUERY_FIELD_TITLE:
+            hit = field_has(term, win->title);
+            break;
+        case QUERY_FIELD_CLASS:
+            hit = field_has(term, win->class_name) || field_has(term, win->instance);
+            break;
+        case QUERY_FIELD_WORKSPACE: {
+            char workspace[12];  // Fits any int, so -Wformat-truncation stays quiet
+            if (win->desktop < 0 || win->desktop > 99) {
+                strcpy(workspace, "s");
+            } else {
+                snprintf(workspace, sizeof(workspace), "%d", win->desktop + 1);
+            }
+            hit = field_has(term, workspace);
+            break;
+        }
+    }
+    return hit ? exact_score : SCORE_MIN;
+}
+
+score_t query_plan_match(const QueryPlan *plan, const WindowInfo *win,
+                         const FzfHaystack *display) {
+    score_t total = 0;
+    for (int g = 0; g < plan->group_count; g++) {
+        const QueryGroup *group = &plan->groups[g];
+        score_t best = SCORE_MIN;
+        for (int t = group->first; t < group->first + group->count; t++) {
+            const QueryTerm *term = &plan->terms[t];
+            score_t score = match_term(term, win, display);
+            if (term->negated) score = score == SCORE_MIN ? 0 : SCORE_MIN;
+            if (score > best) best = score;
+        }
+        if (best == SCORE_MIN) return SCORE_MIN;
+        total += best;
+    }
+    return total;
+}
@@ -0,0 +1,79 @@
+#ifndef QUERY_PLAN_H
+#define QUERY_PLAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "fzf_algo.h"
+#include "window_info.h"
+
+// fzf extended-search syntax for the windows tab, parsed once per
+// keystroke into a plan:
+//
+//   fire moz      AND: every space-separated term must match
+//   'fire         exact substring        !fire    must not contain
+//   ^fire         prefix of a field      !^fire   no field starts with it
+//   fox$          suffix of a field      !fox$    no field ends with it
+//   ^firefox$     a whole field
+//   a | b         OR between neighbouring terms
+//   t:  c:  w:    scope a term to the title, class (or instance), or the
+//                 workspace number (w:3, w:s for sticky), e.g. c:firefox
+//
+// A term is "!", then a scope, then its anchors ("!c:^fire"); "\ " is a
+// literal space. Terms match case-insensitively. Unscoped fuzzy and exact
+// terms match the display string the windows tab shows; unscoped anchors
+// match the title, class or instance. Scoped terms match substrings, not
+// fuzzily, so they narrow the list without running fzf.
+
+#define QUERY_MAX_TERMS 16
+
+typedef enum {
+    QUERY_FUZZY,
+    QUERY_EXACT,
+    QUERY_PREFIX,
+    QUERY_SUFFIX,
+    QUERY_EQUAL,
+} QueryTermKind;
+
+typedef enum {
+    QUERY_FIELD_ANY,
+    QUERY_FIELD_TITLE,
+    QUERY_FIELD_CLASS,
+    QUERY_FIELD_WORKSPACE,
+} QueryField;
+
+typedef struct {
+    QueryTermKind kind;
+    QueryField field;
+    bool negated;
+    FzfPattern pattern;     // Lowercased term text
+} QueryTerm;
+
+// Alternatives joined by '|'; the group matches if any of them does
+typedef struct {
+    int first;              // Index into terms
+    int count;
+    bool fuzzy;             // Needs fzf; evaluated after the cheap groups
+} QueryGroup;
+
+typedef struct {
+    QueryTerm terms[QUERY_MAX_TERMS];
+    int term_count;
+    QueryGroup groups[QUERY_MAX_TERMS];
+    int group_count;
+    // False for a single plain fuzzy term, which the caller matches the
+    // usual way (fzf plus initials on the whole query)
+    bool extended;
+} QueryPlan;
+
+// Parse query into plan; returns plan->extended
+bool query_plan_parse(QueryPlan *plan, const char *query);
+
+// Score of win against an extended plan: the sum over the groups of their
+// best matching alternative (negated terms add nothing), or SCORE_MIN.
+// display is the window's compiled display string. Groups of exact,
+// anchored and negated terms run first, so fzf only scores survivors.
+score_t query_plan_match(const QueryPlan *plan, const WindowInfo *win,
+                         const FzfHaystack *display);
+
+#endif // QUERY_PLAN_H
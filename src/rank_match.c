@@ -0,0 +1,240 @@
+#include "rank_match.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "log.h"
+#include "top_k.h"
+#include "window_store.h"
+
+#define FNV_OFFSET UINT64_C(14695981039346656037)
+#define FNV_PRIME  UINT64_C(1099511628211)
+
+// FNV-1a over a string including its terminator, so field borders count
+static uint64_t hash_string(uint64_t h, const char *s) {
+    do {
+        h ^= (unsigned char)*s;
+        h *= FNV_PRIME;
+    } while (*s++);
+    return h;
+}
+
+static uint64_t hash_int(uint64_t h, int value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        h ^= (unsigned char)((unsigned)value >> (8 * i));
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+static uint64_t fields_fingerprint(const RankField *fields, int field_count) {
+    uint64_t h = hash_int(FNV_OFFSET, field_count);
+    for (int f = 0; f < field_count; f++) {
+        h = hash_string(h, fields[f].text ? fields[f].text : "");
+        h = hash_int(h, fields[f].weight);
+        h = hash_int(h, fields[f].token_bonus);
+    }
+    return h;
+}
+
+int rank_is_word_start(const char *text, int i) {
+    if (i == 0) return 1;
+    char prev = text[i - 1];
+    return prev == ' ' || prev == '-' || prev == '_' || prev == '.' ||
+           prev == '(' || prev == '|';
+}
+
+int rank_initials_compile(char **initials, int *capacity, const char *text) {
+    int len = (int)strlen(text);
+    if (!GROW_ARRAY(*initials, *capacity, len + 1)) return 0;
+
+    int count = 0;
+    for (int i = 0; i < len; i++) {
+        if (rank_is_word_start(text, i)) {
+            (*initials)[count++] = (char)tolower((unsigned char)text[i]);
+        }
+    }
+    (*initials)[count] = '\0';
+    return 1;
+}
+
+// Initials match (e.g., "ddl" -> "Daniel Dario Lukic") on the word starts
+score_t rank_initials_score(const FzfPattern *pattern, const char *initials) {
+    int filter_idx = 0;
+    for (int i = 0; initials[i] && filter_idx < pattern->len; i++) {
+        if (initials[i] == pattern->text[filter_idx]) {
+            filter_idx++;
+        }
+    }
+    return filter_idx == pattern->len ? SCORE_INITIALS_MATCH : SCORE_MIN;
+}
+
+static void free_candidate(RankCandidate *candidate) {
+    fzf_haystack_free(&candidate->text);
+    free(candidate->initials);
+}
+
+void rank_cache_cleanup(RankCache *cache) {
+    for (int i = 0; i < cache->count; i++) {
+        free_candidate(&cache->entries[i]);
+    }
+    free(cache->entries);
+    memset(cache, 0, sizeof(*cache));
+}
+
+static int compile_candidate(RankCandidate *candidate, const RankField *fields, int field_count) {
+    char joined[FZF_MAX_LEN];
+    size_t used = 0;
+    joined[0] = '\0';
+    for (int f = 0; f < field_count; f++) {
+        const char *text = fields[f].text ? fields[f].text : "";
+        if (f > 0 && used < sizeof(joined) - 1) joined[used++] = ' ';
+        size_t len = strlen(text);
+        if (len > sizeof(joined) - 1 - used) len = sizeof(joined) - 1 - used;
+        memcpy(joined + used, text, len);
+        joined[used + len] = '\0';
+
+        candidate->field_start[f] = (int)used;
+        candidate->field_len[f] = (int)len;
+        candidate->field_mask[f] = fzf_char_mask(joined + used);
+        candidate->weights[f] = fields[f].weight;
+        candidate->token_bonus[f] = fields[f].token_bonus;
+        used += len;
+    }
+    candidate->field_count = field_count;
+
+    return fzf_haystack_compile(&candidate->text, joined) &&
+           rank_initials_compile(&candidate->initials, &candidate->initials_capacity, joined);
+}
+
+const RankCandidate *rank_cache_update(RankCache *cache, int index,
+                                       const RankField *fields, int field_count) {
+    if (field_count > RANK_MAX_FIELDS) field_count = RANK_MAX_FIELDS;
+    if (index >= cache->count) {
+        if (!GROW_ARRAY(cache->entries, cache->capacity, index + 1)) return NULL;
+        memset(&cache->entries[cache->count], 0,
+               (size_t)(index + 1 - cache->count) * sizeof(RankCandidate));
+        cache->count = index + 1;
+    }
+
+    RankCandidate *candidate = &cache->entries[index];
+    uint64_t fingerprint = fields_fingerprint(fields, field_count);
+    if (candidate->compiled && candidate->fingerprint == fingerprint) return candidate;
+
+    if (!compile_candidate(candidate, fields, field_count)) {
+        log_error("Failed to compile search fields for entry %d", index);
+        candidate->compiled = 0;
+        return NULL;
+    }
+    candidate->fingerprint = fingerprint;
+    candidate->compiled = 1;
+    candidate->refine_pass = 0;
+    return candidate;
+}
+
+// Whether the pattern is a subsequence of text[start, start + len)
+static int field_matches(const FzfPattern *pattern, const char *text, int start, int len) {
+    int matched = 0;
+    for (int i = start; i < start + len && matched < pattern->len; i++) {
+        if (text[i] == pattern->text[matched]) matched++;
+    }
+    return matched == pattern->len;
+}
+
+// Whether a word of text[start, start + len) starts with the pattern
+static int starts_a_word(const FzfPattern *pattern, const char *text, int start, int len) {
+    for (int i = start; i + pattern->len <= start + len; i++) {
+        if (text[i] == pattern->text[0] && (i == start || rank_is_word_start(text, i)) &&
+            memcmp(text + i, pattern->text, (size_t)pattern->len) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// rank_candidate_score() resuming the joined text at *first_pos
+static score_t score_candidate_from(const FzfPattern *pattern, const RankCandidate *candidate,
+                                    int *first_pos) {
+    // Initials and every field are subsequences of the joined text, so
+    // nothing else can match where it does not
+    score_t best = fzf_match_compiled_from(pattern, &candidate->text, first_pos);
+    if (best == SCORE_MIN) return SCORE_MIN;
+
+    const char *text = candidate->text.text;
+    int field_bonus = 0;
+    for (int f = 0; f < candidate->field_count; f++) {
+        int start = candidate->field_start[f];
+        int len = candidate->field_len[f];
+        int bonus = candidate->weights[f];
+        if (bonus <= field_bonus && !candidate->token_bonus[f]) continue;
+        if ((candidate->field_mask[f] & pattern->mask) != pattern->mask) continue;
+        if (!field_matches(pattern, text, start, len)) continue;
+
+        if (candidate->token_bonus[f] && starts_a_word(pattern, text, start, len)) {
+            bonus += RANK_TOKEN_BONUS;
+        }
+        if (bonus > field_bonus) field_bonus = bonus;
+    }
+    best += field_bonus;
+
+    score_t initials = rank_initials_score(pattern, candidate->initials);
+    return initials > best ? initials : best;
+}
+
+score_t rank_candidate_score(const FzfPattern *pattern, const RankCandidate *candidate) {
+    int first_pos = 0;
+    return score_candidate_from(pattern, candidate, &first_pos);
+}
+
+// Every match is a subsequence match of the joined text, so a query
+// extending the previous one can only match what that one matched.
+// Returns true if the current pass continues.
+static int begin_refinement(RankCache *cache, const FzfPattern *pattern) {
+    size_t previous_len = strlen(cache->refine_query);
+    int refine = previous_len > 0 &&
+                 strncmp(pattern->text, cache->refine_query, previous_len) == 0;
+    if (!refine && ++cache->refine_pass == 0) {
+        cache->refine_pass = 1;  // 0 marks candidates never scored
+    }
+    memcpy(cache->refine_query, pattern->text, (size_t)pattern->len + 1);
+    return refine;
+}
+
+static int compare_ranked(const void *a, const void *b) {
+    const RankedMatch *left = (const RankedMatch *)a;
+    const RankedMatch *right = (const RankedMatch *)b;
+    if (left->score > right->score) return -1;
+    if (left->score < right->score) return 1;
+    return left->index - right->index;
+}
+
+int rank_cache_rank(RankCache *cache, int count, const FzfPattern *pattern,
+                    int k, RankedMatch *out) {
+    int refine = begin_refinement(cache, pattern);
+    int matched = 0;
+    for (int i = 0; i < count && i < cache->count; i++) {
+        RankCandidate *candidate = &cache->entries[i];
+        if (!candidate->compiled) continue;
+
+        int scored_this_pass = refine && candidate->refine_pass == cache->refine_pass;
+        if (scored_this_pass && !candidate->refine_matched) continue;
+
+        score_t score = SCORE_MIN;
+        int start = scored_this_pass ? candidate->refine_start : 0;
+        if ((candidate->text.mask & pattern->mask) == pattern->mask) {
+            score = score_candidate_from(pattern, candidate, &start);
+        }
+        candidate->refine_pass = cache->refine_pass;
+        candidate->refine_matched = score > SCORE_MIN;
+        candidate->refine_start = score > SCORE_MIN ? start : 0;
+        if (score == SCORE_MIN) continue;
+        out[matched].index = i;
+        out[matched].score = score;
+        matched++;
+    }
+
+    top_k_sort(out, (size_t)matched, sizeof(RankedMatch), (size_t)k, compare_ranked);
+    return matched;
+}
@@ -0,0 +1,89 @@
+#ifndef RANK_MATCH_H
+#define RANK_MATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fzf_algo.h"
+
+// Ranked matching shared by the tabs: each candidate is a few text fields
+// compiled once into fzf haystacks and cached until its text changes, so a
+// keystroke only scores cached data and ranks the matches.
+//
+// A candidate matches when the query is a subsequence of its fields joined
+// by spaces (the text the tabs always matched). It scores fzf on that
+// joined text, plus the largest weight of a field that matches the query
+// on its own (with RANK_TOKEN_BONUS more if the field asks for it and a
+// word of it starts with the query); SCORE_INITIALS_MATCH if the query is
+// a subsequence of the initials and that is higher. Only the joined text
+// runs the fzf matrix, the fields are plain scans.
+
+#define RANK_MAX_FIELDS 4
+#define RANK_TOKEN_BONUS 120
+
+typedef struct {
+    const char *text;   // NULL counts as empty
+    int weight;         // Added to the field's own fzf score
+    int token_bonus;    // Reward queries starting a word of this field
+} RankField;
+
+typedef struct {
+    uint64_t fingerprint;   // Fields and weights it was compiled from
+    int compiled;
+    FzfHaystack text;       // Fields joined by spaces
+    int field_start[RANK_MAX_FIELDS];   // Where each field sits in text
+    int field_len[RANK_MAX_FIELDS];
+    uint64_t field_mask[RANK_MAX_FIELDS];
+    int weights[RANK_MAX_FIELDS];
+    int token_bonus[RANK_MAX_FIELDS];
+    int field_count;
+    char *initials;         // Lowercased first character of each word
+    int initials_capacity;
+    // Outcome of the last rank pass that scored this candidate, so a query
+    // extending that pass's query skips candidates it already rejected
+    unsigned refine_pass;   // 0 until scored; reset when recompiled
+    int refine_matched;
+    int refine_start;       // First-match position for fzf_match_compiled_from()
+} RankCandidate;
+
+// Candidates of one list, by position; entries are kept for reuse
+typedef struct {
+    RankCandidate *entries;
+    int count;
+    int capacity;
+    unsigned refine_pass;
+    char refine_query[FZF_MAX_LEN];     // Lowercased query of the last pass
+} RankCache;
+
+typedef struct {
+    int index;      // Position in the list
+    score_t score;
+} RankedMatch;
+
+// Word starts shared by initials and token bonuses
+int rank_is_word_start(const char *text, int i);
+
+// Compile the initials of text into *initials (grown as needed);
+// returns 0 if memory ran out
+int rank_initials_compile(char **initials, int *capacity, const char *text);
+
+// SCORE_INITIALS_MATCH if pattern is a subsequence of initials, else SCORE_MIN
+score_t rank_initials_score(const FzfPattern *pattern, const char *initials);
+
+void rank_cache_cleanup(RankCache *cache);
+
+// Candidate index of the cache, recompiled only when fields differ from
+// the ones it was compiled from; NULL if memory ran out
+const RankCandidate *rank_cache_update(RankCache *cache, int index,
+                                       const RankField *fields, int field_count);
+
+score_t rank_candidate_score(const FzfPattern *pattern, const RankCandidate *candidate);
+
+// Score candidates 0..count-1 (all updated this pass) and order the best k
+// of the matches at the front of out: score, then index. out must hold
+// count entries; returns the number of matches. While each query extends
+// the previous one, candidates it rejected are not scored again.
+int rank_cache_rank(RankCache *cache, int count, const FzfPattern *pattern,
+                    int k, RankedMatch *out);
+
+#endif // RANK_MATCH_H
@@ -0,0 +1,39 @@
+#include "render_fingerprint.h"
+
+#include <stddef.h>
+
+#define FNV_PRIME UINT64_C(1099511628211)
+
+uint64_t render_fingerprint_int(uint64_t hash, int64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        hash ^= (unsigned char)((uint64_t)value >> (8 * i));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t render_fingerprint_string(uint64_t hash, const char *text) {
+    if (text) {
+        for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+            hash ^= *p;
+            hash *= FNV_PRIME;
+        }
+    }
+    hash ^= 0xff;   // Never part of a row's text
+    return hash * FNV_PRIME;
+}
+
+bool render_fingerprint_unchanged(RenderFingerprint *state, uint64_t fingerprint) {
+    if (state->valid && state->painted == fingerprint) {
+        state->skipped++;
+        return true;
+    }
+    state->painted = fingerprint;
+    state->valid = true;
+    state->performed++;
+    return false;
+}
+
+void render_fingerprint_invalidate(RenderFingerprint *state) {
+    state->valid = false;
+}
@@ -0,0 +1,33 @@
+#ifndef RENDER_FINGERPRINT_H
+#define RENDER_FINGERPRINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Fingerprint of what a frame of the results list shows: a hash over every
+// input the frame is formatted from. update_display() skips formatting when
+// it matches the frame already painted, which is what most X events (a
+// desktop switch while hidden, a title change on a row off screen) amount to.
+
+#define RENDER_FINGERPRINT_SEED UINT64_C(14695981039346656037)
+
+typedef struct {
+    uint64_t painted;       // Fingerprint of the frame on screen
+    bool valid;             // false until painted or after an overwrite
+    unsigned performed;     // Frames formatted and written to the buffer
+    unsigned skipped;       // Frames that matched the painted one
+} RenderFingerprint;
+
+uint64_t render_fingerprint_int(uint64_t hash, int64_t value);
+
+// Hashes the string and its end, so "ab","c" differs from "a","bc"
+uint64_t render_fingerprint_string(uint64_t hash, const char *text);
+
+// Whether fingerprint is the frame on screen (counted as skipped); if not,
+// it is recorded as the frame about to be painted
+bool render_fingerprint_unchanged(RenderFingerprint *state, uint64_t fingerprint);
+
+// The frame on screen was overwritten; the next one always paints
+void render_fingerprint_invalidate(RenderFingerprint *state);
+
+#endif // RENDER_FINGERPRINT_H
@@ -0,0 +1,279 @@
+#include "results_view.h"
+
+#include <string.h>
+
+#include "constants.h"
+#include "layout_cache.h"
+#include "log.h"
+
+#define RESULTS_VIEW_DATA "cofi-results-view"
+
+// Highlighted ranges read per row; rows are a screen wide, so more than
+// this only happens for pathological queries and the rest stays plain
+#define RESULTS_MAX_SPANS 64
+
+typedef struct {
+    GtkTextBuffer *buffer;
+    LayoutCache layouts;
+    PangoLayout *marker;        // SELECTION_INDICATOR, NULL until first drawn
+    gint line_height;           // 0 until measured for the current font
+    gint requested_height;
+} ResultsView;
+
+typedef struct {
+    gint start;
+    gint end;
+} RowSpan;
+
+static void free_layout(void *layout) {
+    g_object_unref(layout);
+}
+
+static void free_view(gpointer data) {
+    ResultsView *view = (ResultsView *)data;
+    layout_cache_cleanup(&view->layouts);
+    g_clear_object(&view->marker);
+    g_object_unref(view->buffer);
+    g_free(view);
+}
+
+static ResultsView *view_of(GtkWidget *widget) {
+    return (ResultsView *)g_object_get_data(G_OBJECT(widget), RESULTS_VIEW_DATA);
+}
+
+GtkTextTag *results_view_match_tag(GtkTextBuffer *buffer) {
+    GtkTextTagTable *tags = gtk_text_buffer_get_tag_table(buffer);
+    GtkTextTag *tag = gtk_text_tag_table_lookup(tags, RESULTS_MATCH_TAG);
+    if (!tag) {
+        tag = gtk_text_buffer_create_tag(buffer, RESULTS_MATCH_TAG,
+                                         "weight", PANGO_WEIGHT_BOLD,
+                                         "underline", PANGO_UNDERLINE_SINGLE,
+                                         NULL);
+    }
+    return tag;
+}
+
+GtkTextTag *results_view_selected_tag(GtkTextBuffer *buffer) {
+    GtkTextTagTable *tags = gtk_text_buffer_get_tag_table(buffer);
+    GtkTextTag *tag = gtk_text_tag_table_lookup(tags, RESULTS_SELECTED_TAG);
+    if (!tag) {
+        tag = gtk_text_buffer_create_tag(buffer, RESULTS_SELECTED_TAG, NULL);
+    }
+    return tag;
+}
+
+static gint line_height(GtkWidget *widget, ResultsView *view) {
+    if (view->line_height == 0) {
+        PangoLayout *layout = gtk_widget_create_pango_layout(widget, "Ag");
+        gint height = 0;
+        pango_layout_get_pixel_size(layout, NULL, &height);
+        g_object_unref(layout);
+        view->line_height = height > 0 ? height : 1;
+    }
+    return view->line_height;
+}
+
+// Ask for the height of every buffer line, like the text view did, so the
+// window keeps its layout (the view sits at the bottom of the box)
+static void update_size_request(GtkWidget *widget, ResultsView *view) {
+    gint lines = gtk_text_buffer_get_line_count(view->buffer);
+    gint height = lines * line_height(widget, view) + 2 * RESULTS_VIEW_MARGIN;
+    if (height != view->requested_height) {
+        view->requested_height = height;
+        gtk_widget_set_size_request(widget, -1, height);
+    }
+}
+
+static void on_buffer_changed(GtkTextBuffer *buffer, gpointer data) {
+    (void)buffer;
+    GtkWidget *widget = GTK_WIDGET(data);
+    update_size_request(widget, view_of(widget));
+    gtk_widget_queue_draw(widget);
+}
+
+static void on_buffer_tag_changed(GtkTextBuffer *buffer, GtkTextTag *tag,
+                                  GtkTextIter *start, GtkTextIter *end, gpointer data) {
+    (void)buffer;
+    (void)tag;
+    (void)start;
+    (void)end;
+    gtk_widget_queue_draw(GTK_WIDGET(data));
+}
+
+static void on_style_updated(GtkWidget *widget, gpointer data) {
+    (void)data;
+    ResultsView *view = view_of(widget);
+    layout_cache_clear(&view->layouts);
+    g_clear_object(&view->marker);
+    view->line_height = 0;
+    update_size_request(widget, view);
+}
+
+// Byte ranges of line [start, end) that carry tag
+static int read_spans(GtkTextTag *tag, const GtkTextIter *start, const GtkTextIter *end,
+                      RowSpan *spans) {
+    int count = 0;
+    if (!tag) {
+        return 0;
+    }
+
+    GtkTextIter iter = *start;
+    if (!gtk_text_iter_has_tag(&iter, tag)) {
+        gtk_text_iter_forward_to_tag_toggle(&iter, tag);
+    }
+    while (gtk_text_iter_compare(&iter, end) < 0 && count < RESULTS_MAX_SPANS) {
+        GtkTextIter span_end = iter;
+        gtk_text_iter_forward_to_tag_toggle(&span_end, tag);
+        if (gtk_text_iter_compare(&span_end, end) > 0) {
+            span_end = *end;
+        }
+        spans[count].start = gtk_text_iter_get_line_index(&iter);
+        spans[count].end = gtk_text_iter_get_line_index(&span_end);
+        count++;
+
+        iter = span_end;
+        if (!gtk_text_iter_forward_to_tag_toggle(&iter, tag)) {
+            break;
+        }
+    }
+    return count;
+}
+
+static void add_match_attributes(PangoAttrList *attrs, const RowSpan *span) {
+    PangoAttribute *weight = pango_attr_weight_new(PANGO_WEIGHT_BOLD);
+    weight->start_index = (guint)span->start;
+    weight->end_index = (guint)span->end;
+    pango_attr_list_insert(attrs, weight);
+
+    PangoAttribute *underline = pango_attr_underline_new(PANGO_UNDERLINE_SINGLE);
+    underline->start_index = (guint)span->start;
+    underline->end_index = (guint)span->end;
+    pango_attr_list_insert(attrs, underline);
+}
+
+// Layout of one buffer line, from the cache when a row with the same text
+// and highlights was drawn before
+static PangoLayout *row_layout(GtkWidget *widget, ResultsView *view, gint line,
+                               GtkTextTag *match_tag, GString *key) {
+    GtkTextIter start, end;
+    gtk_text_buffer_get_iter_at_line(view->buffer, &start, line);
+    end = start;
+    if (!gtk_text_iter_ends_line(&end)) {
+        gtk_text_iter_forward_to_line_end(&end);
+    }
+    gchar *text = gtk_text_buffer_get_text(view->buffer, &start, &end, FALSE);
+
+    RowSpan spans[RESULTS_MAX_SPANS];
+    int span_count = read_spans(match_tag, &start, &end, spans);
+
+    // Row text, then its highlighted ranges after a separator that never
+    // appears in rows
+    g_string_assign(key, text);
+    for (int i = 0; i < span_count; i++) {
+        g_string_append_printf(key, "\x1f%d-%d", spans[i].start, spans[i].end);
+    }
+
+    PangoLayout *layout = layout_cache_lookup(&view->layouts, key->str);
+    if (!layout) {
+        layout = gtk_widget_create_pango_layout(widget, text);
+        if (span_count > 0) {
+            PangoAttrList *attrs = pango_attr_list_new();
+            for (int i = 0; i < span_count; i++) {
+                add_match_attributes(attrs, &spans[i]);
+            }
+            pango_layout_set_attributes(layout, attrs);
+            pango_attr_list_unref(attrs);
+        }
+        layout_cache_store(&view->layouts, key->str, layout);
+    }
+
+    g_free(text);
+    return layout;
+}
+
+// Line whose start carries the selected tag, -1 if none
+static gint selected_line(GtkTextBuffer *buffer) {
+    GtkTextTag *tag = gtk_text_tag_table_lookup(
+        gtk_text_buffer_get_tag_table(buffer), RESULTS_SELECTED_TAG);
+    if (!tag) {
+        return -1;
+    }
+
+    GtkTextIter iter;
+    gtk_text_buffer_get_start_iter(buffer, &iter);
+    if (!gtk_text_iter_has_tag(&iter, tag) &&
+        !gtk_text_iter_forward_to_tag_toggle(&iter, tag)) {
+        return -1;
+    }
+    return gtk_text_iter_get_line(&iter);
+}
+
+static gboolean on_draw(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    (void)data;
+    ResultsView *view = view_of(widget);
+    GtkStyleContext *style = gtk_widget_get_style_context(widget);
+    gint width = gtk_widget_get_allocated_width(widget);
+    gint height = gtk_widget_get_allocated_height(widget);
+    gtk_render_background(style, cr, 0, 0, width, height);
+
+    // Lines stay at the bottom if the area is taller than asked for
+    gint row_height = line_height(widget, view);
+    gint top = RESULTS_VIEW_MARGIN;
+    if (height > view->requested_height) {
+        top += height - view->requested_height;
+    }
+
+    gint lines = gtk_text_buffer_get_line_count(view->buffer);
+    gint first = 0;
+    gint last = lines - 1;
+    GdkRectangle clip;
+    if (gdk_cairo_get_clip_rectangle(cr, &clip)) {
+        first = MAX(0, (clip.y - top) / row_height);
+        last = MIN(last, (clip.y + clip.height - top) / row_height);
+    }
+
+    GtkTextTag *match_tag = gtk_text_tag_table_lookup(
+        gtk_text_buffer_get_tag_table(view->buffer), RESULTS_MATCH_TAG);
+    gint selected = selected_line(view->buffer);
+    GString *key = g_string_new(NULL);
+    unsigned misses = view->layouts.misses;
+    for (gint line = first; line <= last; line++) {
+        PangoLayout *layout = row_layout(widget, view, line, match_tag, key);
+        gtk_render_layout(style, cr, RESULTS_VIEW_MARGIN, top + line * row_height, layout);
+    }
+    g_string_free(key, TRUE);
+
+    // The selected row's text has a blank gutter; the marker goes over it
+    if (selected >= first && selected <= last) {
+        if (!view->marker) {
+            view->marker = gtk_widget_create_pango_layout(widget, SELECTION_INDICATOR);
+        }
+        gtk_render_layout(style, cr, RESULTS_VIEW_MARGIN, top + selected * row_height,
+                          view->marker);
+    }
+
+    log_trace("Results drawn: lines %d-%d, %u laid out, %d cached",
+              first, last, view->layouts.misses - misses, view->layouts.count);
+    return FALSE;
+}
+
+GtkWidget *results_view_new(GtkTextBuffer *buffer) {
+    GtkWidget *widget = gtk_drawing_area_new();
+    gtk_widget_set_name(widget, "results");
+
+    ResultsView *view = g_new0(ResultsView, 1);
+    view->buffer = g_object_ref(buffer);
+    view->layouts.free_layout = free_layout;
+    g_object_set_data_full(G_OBJECT(widget), RESULTS_VIEW_DATA, view, free_view);
+
+    g_signal_connect(widget, "draw", G_CALLBACK(on_draw), NULL);
+    g_signal_connect(widget, "style-updated", G_CALLBACK(on_style_updated), NULL);
+    g_signal_connect_object(buffer, "changed", G_CALLBACK(on_buffer_changed), widget, 0);
+    g_signal_connect_object(buffer, "apply-tag", G_CALLBACK(on_buffer_tag_changed), widget,
+                            G_CONNECT_AFTER);
+    g_signal_connect_object(buffer, "remove-tag", G_CALLBACK(on_buffer_tag_changed), widget,
+                            G_CONNECT_AFTER);
+
+    update_size_request(widget, view);
+    return widget;
+}
@@ -0,0 +1,32 @@
+#ifndef RESULTS_VIEW_H
+#define RESULTS_VIEW_H
+
+#include <gtk/gtk.h>
+
+// The results list: a drawing area that paints the lines of a text buffer
+// in one font, one PangoLayout per distinct row kept across frames (see
+// layout_cache.h). Only lines inside the area being redrawn are laid out.
+// The buffer stays the model, so help and messages keep using
+// gtk_text_buffer_set_text().
+
+// Space around the text, as the text view's margins were
+#define RESULTS_VIEW_MARGIN 10
+
+// Name of the tag marking matched characters
+#define RESULTS_MATCH_TAG "match"
+
+// Name of the tag marking the selected row's gutter; the view draws
+// SELECTION_INDICATOR over it, so rows keep the same text when the
+// selection moves
+#define RESULTS_SELECTED_TAG "selected"
+
+// New view drawing buffer (it takes a reference); named "results" for CSS
+GtkWidget *results_view_new(GtkTextBuffer *buffer);
+
+// Tag for matched characters in buffer, created on first use
+GtkTextTag *results_view_match_tag(GtkTextBuffer *buffer);
+
+// Tag for the selected row's gutter in buffer, created on first use
+GtkTextTag *results_view_selected_tag(GtkTextBuffer *buffer);
+
+#endif // RESULTS_VIEW_H
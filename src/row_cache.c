@@ -0,0 +1,71 @@
+#include "row_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "window_store.h"
+
+#define FNV_PRIME UINT64_C(1099511628211)
+
+static uint64_t hash_value(uint64_t h, uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        h ^= (unsigned char)(value >> (8 * i));
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+uint64_t row_cache_key(uint64_t fingerprint, int harpoon_slot, Window display_id) {
+    uint64_t h = hash_value(fingerprint, (uint64_t)(int64_t)harpoon_slot);
+    return hash_value(h, (uint64_t)display_id);
+}
+
+const CachedRow *row_cache_lookup(RowCache *cache, Window id, uint64_t key) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0 || cache->entries[index].key != key) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    return &cache->entries[index];
+}
+
+CachedRow *row_cache_store(RowCache *cache, Window id, uint64_t key) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0) {
+        if (!GROW_ARRAY(cache->entries, cache->capacity, cache->count + 1)) {
+            log_error("Failed to grow row cache to %d rows", cache->count + 1);
+            return NULL;
+        }
+        index = cache->count;
+        memset(&cache->entries[index], 0, sizeof(CachedRow));
+        cache->entries[index].id = id;
+        if (!window_registry_put(&cache->index, id, index)) return NULL;
+        cache->count++;
+    }
+
+    CachedRow *row = &cache->entries[index];
+    row->key = key;
+    return row;
+}
+
+void row_cache_forget(RowCache *cache, Window id) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0) return;
+    window_registry_remove(&cache->index, id);
+
+    // Swap-remove; the moved entry keeps its handle in sync
+    int last = cache->count - 1;
+    if (index != last) {
+        cache->entries[index] = cache->entries[last];
+        window_registry_put(&cache->index, cache->entries[index].id, index);
+    }
+    cache->count--;
+}
+
+void row_cache_cleanup(RowCache *cache) {
+    free(cache->entries);
+    window_registry_free(&cache->index);
+    memset(cache, 0, sizeof(*cache));
+}
@@ -0,0 +1,51 @@
+#ifndef ROW_CACHE_H
+#define ROW_CACHE_H
+
+#include <X11/Xlib.h>
+#include <stdint.h>
+#include "window_registry.h"
+
+// Finished windows tab rows, kept per window across frames. A row is
+// reused while the window's content fingerprint (title with its custom
+// name, class, instance, desktop) and its harpoon slot stay the same, so
+// drawing a row that did not change is a copy.
+
+// Harpoon slot, desktop, instance, title, class and window ID columns with
+// their separators fit with room to spare
+#define ROW_CACHE_LINE_MAX 128
+
+typedef struct {
+    Window id;
+    uint64_t key;                   // row_cache_key() the line was formatted for
+    char line[ROW_CACHE_LINE_MAX];  // Row after the selection gutter, no newline
+    int len;
+    int match_start;                // Part filtering matched (desktop to class)
+    int match_len;
+} CachedRow;
+
+typedef struct {
+    CachedRow *entries;     // Grows with the number of windows drawn
+    int count;
+    int capacity;
+    WindowRegistry index;   // Window ID -> index in entries
+    unsigned hits;
+    unsigned misses;
+} RowCache;
+
+// Key of a row: the window's search_key_fingerprint(), its harpoon slot
+// (-1 for none) and the ID shown in the last column
+uint64_t row_cache_key(uint64_t fingerprint, int harpoon_slot, Window display_id);
+
+// Row cached for id if it was formatted for key, else NULL (a miss)
+const CachedRow *row_cache_lookup(RowCache *cache, Window id, uint64_t key);
+
+// Entry for id, marked with key, for the caller to format the row into;
+// NULL if memory ran out
+CachedRow *row_cache_store(RowCache *cache, Window id, uint64_t key);
+
+// Drop a window that left the client list
+void row_cache_forget(RowCache *cache, Window id);
+
+void row_cache_cleanup(RowCache *cache);
+
+#endif // ROW_CACHE_H
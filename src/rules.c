@@ -1,5 +1,6 @@
 #include "rules.h"
 #include "window_matcher.h"
+#include "window_store.h"
 #include <string.h>
 
 void init_rule_state(RuleState *state) {
@@ -10,13 +11,13 @@ void init_rule_state(RuleState *state) {
 // Find or create a window entry in the state
 static RuleWindowState* find_or_add_window(RuleState *state, Window id) {
     // Find existing
-    for (int i = 0; i < state->count; i++) {
-        if (state->windows[i].id == id) {
-            return &state->windows[i];
-        }
+    int index = window_registry_get(&state->index, id);
+    if (index >= 0) {
+        return &state->windows[index];
     }
     // Add new
-    if (state->count >= MAX_RULE_TRACKED_WINDOWS) return NULL;
+    if (!GROW_ARRAY(state->windows, state->capacity, state->count + 1)) return NULL;
+    if (!window_registry_put(&state->index, id, state->count)) return NULL;
     RuleWindowState *ws = &state->windows[state->count];
     ws->id = id;
     ws->matched = false;
@@ -52,11 +53,13 @@ RuleMatch check_rule_match(const Rule *rule, RuleState *state, Window id, const
 
 void rule_state_remove_window(RuleState *state, Window id) {
     if (!state) return;
-    for (int i = 0; i < state->count; i++) {
-        if (state->windows[i].id == id) {
-            state->windows[i] = state->windows[state->count - 1];
-            state->count--;
-            return;
-        }
+    int index = window_registry_get(&state->index, id);
+    if (index < 0) return;
+
+    window_registry_remove(&state->index, id);
+    state->count--;
+    if (index < state->count) {
+        state->windows[index] = state->windows[state->count];
+        window_registry_put(&state->index, state->windows[index].id, index);
     }
 }
@@ -4,9 +4,7 @@
 #include <X11/Xlib.h>
 #include <stdbool.h>
 #include "rules_config.h"
-
-// Max windows to track state for
-#define MAX_RULE_TRACKED_WINDOWS 256
+#include "window_registry.h"
 
 // Per-window match state for a single rule
 typedef struct {
@@ -16,8 +14,10 @@ typedef struct {
 
 // State for all rules across all windows
 typedef struct {
-    RuleWindowState windows[MAX_RULE_TRACKED_WINDOWS];
+    RuleWindowState *windows;  // Grows with the number of windows seen
     int count;
+    int capacity;
+    WindowRegistry index;  // Window ID -> index in windows
 } RuleState;
 
 // Result of checking a rule against a window title
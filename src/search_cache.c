@@ -0,0 +1,93 @@
+#include "search_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "rank_match.h"
+#include "window_store.h"
+
+#define FNV_OFFSET UINT64_C(14695981039346656037)
+#define FNV_PRIME  UINT64_C(1099511628211)
+
+void init_search_cache(SearchCache *cache) {
+    memset(cache, 0, sizeof(*cache));
+}
+
+void cleanup_search_cache(SearchCache *cache) {
+    for (int i = 0; i < cache->count; i++) {
+        fzf_haystack_free(&cache->entries[i].haystack);
+        free(cache->entries[i].initials);
+    }
+    free(cache->entries);
+    window_registry_free(&cache->index);
+    init_search_cache(cache);
+}
+
+// FNV-1a over a string including its terminator, so field borders count
+static uint64_t hash_string(uint64_t h, const char *s) {
+    do {
+        h ^= (unsigned char)*s;
+        h *= FNV_PRIME;
+    } while (*s++);
+    return h;
+}
+
+uint64_t search_key_fingerprint(const WindowInfo *win) {
+    uint64_t h = FNV_OFFSET;
+    h = hash_string(h, win->title);
+    h = hash_string(h, win->class_name);
+    h = hash_string(h, win->instance);
+    for (size_t i = 0; i < sizeof(win->desktop); i++) {
+        h ^= (unsigned char)(win->desktop >> (8 * i));
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+SearchKey *search_cache_lookup(const SearchCache *cache, Window id, uint64_t fingerprint) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0 || cache->entries[index].fingerprint != fingerprint) return NULL;
+    return &cache->entries[index];
+}
+
+SearchKey *search_cache_store(SearchCache *cache, Window id, uint64_t fingerprint,
+                              const char *display) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0) {
+        if (!GROW_ARRAY(cache->entries, cache->capacity, cache->count + 1)) return NULL;
+        index = cache->count;
+        memset(&cache->entries[index], 0, sizeof(SearchKey));
+        cache->entries[index].id = id;
+        if (!window_registry_put(&cache->index, id, index)) return NULL;
+        cache->count++;
+    }
+
+    SearchKey *key = &cache->entries[index];
+    if (!fzf_haystack_compile(&key->haystack, display) ||
+        !rank_initials_compile(&key->initials, &key->initials_capacity, display)) {
+        log_error("Failed to compile search text for window 0x%lx", id);
+        search_cache_forget(cache, id);
+        return NULL;
+    }
+    key->fingerprint = fingerprint;
+    key->refine_pass = 0;
+    return key;
+}
+
+void search_cache_forget(SearchCache *cache, Window id) {
+    int index = window_registry_get(&cache->index, id);
+    if (index < 0) return;
+
+    fzf_haystack_free(&cache->entries[index].haystack);
+    free(cache->entries[index].initials);
+    window_registry_remove(&cache->index, id);
+
+    // Swap-remove; the moved entry keeps its handle in sync
+    int last = cache->count - 1;
+    if (index != last) {
+        cache->entries[index] = cache->entries[last];
+        window_registry_put(&cache->index, cache->entries[index].id, index);
+    }
+    cache->count--;
+}
@@ -0,0 +1,52 @@
+#ifndef SEARCH_CACHE_H
+#define SEARCH_CACHE_H
+
+#include <X11/Xlib.h>
+#include <stdint.h>
+#include "fzf_algo.h"
+#include "window_info.h"
+#include "window_registry.h"
+
+// Precompiled search text for one window (what the windows tab matches
+// against). Rebuilt only when the fields the display string is made of
+// change, so a keystroke only runs the match over cached data.
+typedef struct {
+    Window id;
+    uint64_t fingerprint;   // search_key_fingerprint() of the compiled window
+    FzfHaystack haystack;   // Display string, lowercased with its bonus vector
+    char *initials;         // Lowercased first character of each word
+    int initials_capacity;
+    // Outcome of the last filter pass that scored this key, so a query that
+    // extends that pass's query can skip keys it already rejected
+    unsigned refine_pass;   // 0 until scored; reset when recompiled
+    int refine_matched;
+    int refine_start;       // First-match position for fzf_match_compiled_from()
+} SearchKey;
+
+typedef struct {
+    SearchKey *entries;     // Grows with the number of windows searched
+    int count;
+    int capacity;
+    WindowRegistry index;   // Window ID -> index in entries
+} SearchCache;
+
+void init_search_cache(SearchCache *cache);
+
+// Forget every window and release the tables
+void cleanup_search_cache(SearchCache *cache);
+
+// Hash of title, class, instance and desktop (custom names are part of the
+// title by the time windows are matched)
+uint64_t search_key_fingerprint(const WindowInfo *win);
+
+// Cached key for id if it was compiled from the same fingerprint, else NULL
+SearchKey *search_cache_lookup(const SearchCache *cache, Window id, uint64_t fingerprint);
+
+// Compile display for id and cache it; NULL if memory ran out
+SearchKey *search_cache_store(SearchCache *cache, Window id, uint64_t fingerprint,
+                              const char *display);
+
+// Drop a window that left the client list
+void search_cache_forget(SearchCache *cache, Window id);
+
+#endif // SEARCH_CACHE_H
@@ -1,6 +1,7 @@
 #include "selection.h"
 #include "log.h"
 #include "display.h"
+#include "filter.h"
 
 // Initialize selection state
 void init_selection(AppData *app) {
@@ -73,6 +74,8 @@ WindowInfo* get_selected_window(AppData *app) {
         return NULL;
     }
     
+    ensure_filtered_order(app, app->selection.window_index + 1);
+    if (app->selection.window_index >= app->filtered_count) return NULL;
     return &app->filtered[app->selection.window_index];
 }
 
@@ -122,6 +125,7 @@ void move_selection_up(AppData *app) {
                 // Wrap around to the bottom (index 0 is the best match)
                 app->selection.window_index = 0;
             }
+            ensure_filtered_order(app, app->selection.window_index + 1);
             app->selection.selected_window_id = app->filtered[app->selection.window_index].id;
             update_scroll_position(app);
             update_display(app);
@@ -225,6 +229,7 @@ void move_selection_down(AppData *app) {
                 // Wrap around to the top (highest index)
                 app->selection.window_index = app->filtered_count - 1;
             }
+            ensure_filtered_order(app, app->selection.window_index + 1);
             app->selection.selected_window_id = app->filtered[app->selection.window_index].id;
             update_scroll_position(app);
             update_display(app);
@@ -321,6 +326,7 @@ void preserve_selection(AppData *app) {
     if (!app) return;
     
     if (app->current_tab == TAB_WINDOWS) {
+        ensure_filtered_order(app, app->selection.window_index + 1);
         if (app->filtered_count > 0 && app->selection.window_index >= 0 && 
             app->selection.window_index < app->filtered_count) {
             app->selection.selected_window_id = app->filtered[app->selection.window_index].id;
@@ -344,17 +350,12 @@ void restore_selection(AppData *app) {
     if (app->current_tab == TAB_WINDOWS) {
         if (app->selection.selected_window_id != 0) {
             // Try to find the previously selected window
-            bool found = false;
-            for (int i = 0; i < app->filtered_count; i++) {
-                if (app->filtered[i].id == app->selection.selected_window_id) {
-                    app->selection.window_index = i;
-                    log_trace("Restored window selection to index %d for window ID 0x%lx",
-                              i, app->selection.selected_window_id);
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            int row = find_filtered_row(app, app->selection.selected_window_id);
+            if (row >= 0) {
+                app->selection.window_index = row;
+                log_trace("Restored window selection to index %d for window ID 0x%lx",
+                          row, app->selection.selected_window_id);
+            } else {
                 // Window no longer exists, reset to first
                 app->selection.window_index = 0;
                 app->selection.selected_window_id = (app->filtered_count > 0) ? app->filtered[0].id : 0;
@@ -526,6 +527,7 @@ void validate_selection(AppData *app) {
             app->selection.selected_window_id = 0;
         } else if (app->selection.window_index >= app->filtered_count) {
             app->selection.window_index = app->filtered_count - 1;
+            ensure_filtered_order(app, app->filtered_count);
             app->selection.selected_window_id = app->filtered[app->selection.window_index].id;
         } else if (app->selection.window_index < 0) {
             app->selection.window_index = 0;
@@ -0,0 +1,110 @@
+#include "simd_scan.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <glib.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+
+// Bits of the block that hold a, b or the terminator
+static inline unsigned block_hits_sse2(__m128i block, __m128i va, __m128i vb) {
+    __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, va), _mm_cmpeq_epi8(block, vb));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+    return (unsigned)_mm_movemask_epi8(hits);
+}
+
+static const char *find_either_sse2(const char *s, char a, char b) {
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+
+    // First block starts before s; drop the bytes ahead of it
+    size_t skip = (uintptr_t)s & 15;
+    const char *block = s - skip;
+    unsigned hits = block_hits_sse2(_mm_load_si128((const __m128i *)block), va, vb) >> skip << skip;
+
+    while (!hits) {
+        block += 16;
+        hits = block_hits_sse2(_mm_load_si128((const __m128i *)block), va, vb);
+    }
+
+    const char *found = block + __builtin_ctz(hits);
+    return *found ? found : NULL;
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t block_hits_avx2(__m256i block, __m256i va, __m256i vb) {
+    __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, va), _mm256_cmpeq_epi8(block, vb));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+    return (uint32_t)_mm256_movemask_epi8(hits);
+}
+
+__attribute__((target("avx2")))
+static const char *find_either_avx2(const char *s, char a, char b) {
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+
+    size_t skip = (uintptr_t)s & 31;
+    const char *block = s - skip;
+    uint32_t hits = block_hits_avx2(_mm256_load_si256((const __m256i *)block), va, vb) >> skip << skip;
+
+    while (!hits) {
+        block += 32;
+        hits = block_hits_avx2(_mm256_load_si256((const __m256i *)block), va, vb);
+    }
+
+    const char *found = block + __builtin_ctz(hits);
+    return *found ? found : NULL;
+}
+
+#else
+
+static const char *find_either_scalar(const char *s, char a, char b) {
+    for (; *s; s++) {
+        if (*s == a || *s == b) return s;
+    }
+    return NULL;
+}
+
+#endif // __SSE2__
+
+typedef const char *(*FindEitherFn)(const char *s, char a, char b);
+
+static FindEitherFn find_either = NULL;
+static const char *backend_name = NULL;
+
+static void select_backend(void) {
+#if defined(__SSE2__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        find_either = find_either_avx2;
+        backend_name = "avx2";
+        return;
+    }
+    find_either = find_either_sse2;
+    backend_name = "sse2";
+#else
+    find_either = find_either_scalar;
+    backend_name = "scalar";
+#endif
+}
+
+// Pick the backend on first use; scans also run on the name scorer's
+// worker threads, so the first callers may race here
+static void ensure_backend(void) {
+    static gsize selected = 0;
+    if (g_once_init_enter(&selected)) {
+        select_backend();
+        g_once_init_leave(&selected, 1);
+    }
+}
+
+const char *simd_find_either(const char *s, char a, char b) {
+    ensure_backend();
+    return find_either(s, a, b);
+}
+
+const char *simd_scan_backend(void) {
+    ensure_backend();
+    return backend_name;
+}
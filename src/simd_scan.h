@@ -0,0 +1,13 @@
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+// First byte of s equal to a or b, or NULL if the terminator comes first.
+// Checks 16 bytes at a time with SSE2, 32 with AVX2 when the CPU has it.
+// Loads are aligned to the block size, so the scan never crosses into a
+// page past the terminator; a and b must not be '\0'.
+const char *simd_find_either(const char *s, char a, char b);
+
+// Which implementation simd_find_either() runs: "avx2", "sse2" or "scalar"
+const char *simd_scan_backend(void);
+
+#endif // SIMD_SCAN_H
@@ -8,8 +8,8 @@
 #include "display.h"
 #include "filter.h"
 #include "filter_names.h"
-#include "match.h"
 #include "log.h"
+#include "rank_match.h"
 #include "selection.h"
 #include "path_binaries.h"
 
@@ -126,6 +126,17 @@ gboolean handle_tab_switching(GdkEventKey *event, AppData *app) {
     return TRUE;
 }
 
+// Candidates of the small tabs, compiled when their text changes
+static RankCache workspace_candidates;
+static RankCache harpoon_candidates;
+static RankCache config_candidates;
+static RankCache hotkey_candidates;
+
+// What the user names an entry by (slot, key, workspace name) ranks above
+// the text that comes with it
+#define RANK_WEIGHT_LABEL 200
+#define RANK_WEIGHT_TEXT  100
+
 void filter_workspaces(AppData *app, const char *filter) {
     app->filtered_workspace_count = 0;
 
@@ -136,14 +147,24 @@ void filter_workspaces(AppData *app, const char *filter) {
         return;
     }
 
-    char searchable[512];
     for (int i = 0; i < app->workspace_count; i++) {
-        snprintf(searchable, sizeof(searchable), "%d %s",
-                 app->workspaces[i].id + 1, app->workspaces[i].name);
+        char number[16];
+        snprintf(number, sizeof(number), "%d", app->workspaces[i].id + 1);
+        RankField fields[] = {
+            { number,                   RANK_WEIGHT_LABEL, 0 },
+            { app->workspaces[i].name,  RANK_WEIGHT_LABEL, 1 },
+        };
+        rank_cache_update(&workspace_candidates, i, fields, 2);
+    }
 
-        if (has_match(filter, searchable)) {
-            app->filtered_workspaces[app->filtered_workspace_count++] = app->workspaces[i];
-        }
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, filter);
+    RankedMatch ranked[MAX_WORKSPACES];
+    int matched = rank_cache_rank(&workspace_candidates, app->workspace_count, &pattern,
+                                  app->workspace_count, ranked);
+    for (int i = 0; i < matched; i++) {
+        app->filtered_workspaces[app->filtered_workspace_count++] =
+            app->workspaces[ranked[i].index];
     }
 }
 
@@ -162,7 +183,6 @@ void filter_harpoon(AppData *app, const char *filter) {
         return;
     }
 
-    char searchable[1024];
     for (int i = 0; i < MAX_HARPOON_SLOTS; i++) {
         HarpoonSlot *slot = &app->harpoon.slots[i];
 
@@ -173,16 +193,26 @@ void filter_harpoon(AppData *app, const char *filter) {
             snprintf(slot_name, sizeof(slot_name), "%c", 'a' + (i - 10));
         }
 
-        if (slot->assigned) {
-            snprintf(searchable, sizeof(searchable), "%s %s %s %s",
-                     slot_name, slot->title, slot->class_name, slot->instance);
+        // Empty slots compile to no text, which matches nothing
+        RankField fields[] = {
+            { slot_name,        RANK_WEIGHT_LABEL, 0 },
+            { slot->title,      RANK_WEIGHT_TEXT,  1 },
+            { slot->class_name, 0,                 0 },
+            { slot->instance,   0,                 0 },
+        };
+        rank_cache_update(&harpoon_candidates, i, fields, slot->assigned ? 4 : 0);
+    }
 
-            if (has_match(filter, searchable)) {
-                app->filtered_harpoon[app->filtered_harpoon_count] = *slot;
-                app->filtered_harpoon_indices[app->filtered_harpoon_count] = i;
-                app->filtered_harpoon_count++;
-            }
-        }
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, filter);
+    RankedMatch ranked[MAX_HARPOON_SLOTS];
+    int matched = rank_cache_rank(&harpoon_candidates, MAX_HARPOON_SLOTS, &pattern,
+                                  MAX_HARPOON_SLOTS, ranked);
+    for (int i = 0; i < matched; i++) {
+        int slot_index = ranked[i].index;
+        app->filtered_harpoon[app->filtered_harpoon_count] = app->harpoon.slots[slot_index];
+        app->filtered_harpoon_indices[app->filtered_harpoon_count] = slot_index;
+        app->filtered_harpoon_count++;
     }
 }
 
@@ -201,11 +231,19 @@ void filter_config(AppData *app, const char *filter) {
     }
 
     for (int i = 0; i < all_count; i++) {
-        char searchable[256];
-        snprintf(searchable, sizeof(searchable), "%s %s", all_entries[i].key, all_entries[i].value);
-        if (has_match(filter, searchable)) {
-            app->filtered_config[app->filtered_config_count++] = all_entries[i];
-        }
+        RankField fields[] = {
+            { all_entries[i].key,   RANK_WEIGHT_LABEL, 1 },
+            { all_entries[i].value, RANK_WEIGHT_TEXT,  1 },
+        };
+        rank_cache_update(&config_candidates, i, fields, 2);
+    }
+
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, filter);
+    RankedMatch ranked[MAX_CONFIG_ENTRIES];
+    int matched = rank_cache_rank(&config_candidates, all_count, &pattern, all_count, ranked);
+    for (int i = 0; i < matched; i++) {
+        app->filtered_config[app->filtered_config_count++] = all_entries[ranked[i].index];
     }
 }
 
@@ -222,15 +260,23 @@ void filter_hotkeys(AppData *app, const char *filter) {
     }
 
     for (int i = 0; i < app->hotkey_config.count; i++) {
-        char searchable[512];
-        snprintf(searchable, sizeof(searchable), "%s %s",
-                 app->hotkey_config.bindings[i].key,
-                 app->hotkey_config.bindings[i].command);
-        if (has_match(filter, searchable)) {
-            app->filtered_hotkeys[app->filtered_hotkeys_count] = app->hotkey_config.bindings[i];
-            app->filtered_hotkeys_indices[app->filtered_hotkeys_count] = i;
-            app->filtered_hotkeys_count++;
-        }
+        RankField fields[] = {
+            { app->hotkey_config.bindings[i].key,     RANK_WEIGHT_LABEL, 1 },
+            { app->hotkey_config.bindings[i].command, RANK_WEIGHT_TEXT,  1 },
+        };
+        rank_cache_update(&hotkey_candidates, i, fields, 2);
+    }
+
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, filter);
+    RankedMatch ranked[MAX_HOTKEY_BINDINGS];
+    int matched = rank_cache_rank(&hotkey_candidates, app->hotkey_config.count, &pattern,
+                                  app->hotkey_config.count, ranked);
+    for (int i = 0; i < matched; i++) {
+        int binding = ranked[i].index;
+        app->filtered_hotkeys[app->filtered_hotkeys_count] = app->hotkey_config.bindings[binding];
+        app->filtered_hotkeys_indices[app->filtered_hotkeys_count] = binding;
+        app->filtered_hotkeys_count++;
     }
 }
 
@@ -243,5 +289,19 @@ void filter_apps(AppData *app, const char *filter) {
         return;
     }
 
+    path_binaries_cancel_filter();
     apps_filter(query, app->filtered_apps, &app->filtered_apps_count);
 }
+
+gboolean filter_apps_async(AppData *app, const char *filter, gint64 keystroke_us) {
+    const char *query = filter ? filter : "";
+
+    if (query[0] != '$') {
+        filter_apps(app, query);
+        return FALSE;
+    }
+
+    path_binaries_ensure_loaded(app);
+    path_binaries_filter_async(app, query + 1, keystroke_us);
+    return TRUE;
+}
@@ -15,5 +15,8 @@ void filter_harpoon(AppData *app, const char *filter);
 void filter_config(AppData *app, const char *filter);
 void filter_hotkeys(AppData *app, const char *filter);
 void filter_apps(AppData *app, const char *filter);
+// filter_apps() for typed text: `$` queries go to a worker and return TRUE
+// with the result still pending; anything else is filtered in place
+gboolean filter_apps_async(AppData *app, const char *filter, gint64 keystroke_us);
 
 #endif
@@ -0,0 +1,146 @@
+#include "title_throttle.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "window_store.h"
+
+#define RATE_SAMPLE_US 1000000
+
+void init_title_throttle(TitleThrottle *throttle) {
+    memset(throttle, 0, sizeof(*throttle));
+}
+
+void cleanup_title_throttle(TitleThrottle *throttle) {
+    free(throttle->entries);
+    window_registry_free(&throttle->index);
+    init_title_throttle(throttle);
+}
+
+static TitleThrottleEntry *find_entry(TitleThrottle *throttle, Window id) {
+    int index = window_registry_get(&throttle->index, id);
+    return index >= 0 ? &throttle->entries[index] : NULL;
+}
+
+static void sample_rate(TitleThrottleEntry *entry, gint64 now_us) {
+    gint64 elapsed = now_us - entry->rate_start_us;
+    if (elapsed >= RATE_SAMPLE_US) {
+        entry->events_per_sec = entry->rate_events * 1000000.0 / (double)elapsed;
+        entry->rate_start_us = now_us;
+        entry->rate_events = 0;
+
+        if (entry->events_per_sec >= TITLE_SPAM_RATE && !entry->reported) {
+            entry->reported = TRUE;
+            log_info("Window 0x%lx updates its title %.1f times/s; throttled to %d/s",
+                     entry->id, entry->events_per_sec,
+                     (int)(1000000 / TITLE_THROTTLE_INTERVAL_US));
+        }
+    }
+    entry->rate_events++;
+}
+
+gboolean title_throttle_event(TitleThrottle *throttle, Window id, gint64 now_us) {
+    TitleThrottleEntry *entry = find_entry(throttle, id);
+    if (!entry) {
+        if (!GROW_ARRAY(throttle->entries, throttle->capacity, throttle->count + 1)) {
+            return TRUE;
+        }
+        window_registry_put(&throttle->index, id, throttle->count);
+        entry = &throttle->entries[throttle->count++];
+        memset(entry, 0, sizeof(*entry));
+        entry->id = id;
+        entry->rate_start_us = now_us;
+        entry->last_delivery_us = now_us - TITLE_THROTTLE_INTERVAL_US;
+    }
+
+    entry->events++;
+    sample_rate(entry, now_us);
+
+    if (entry->trailing_pending) {
+        return FALSE;
+    }
+    if (now_us - entry->last_delivery_us < TITLE_THROTTLE_INTERVAL_US) {
+        entry->trailing_pending = TRUE;
+        return FALSE;
+    }
+
+    entry->last_delivery_us = now_us;
+    entry->deliveries++;
+    return TRUE;
+}
+
+gint64 title_throttle_next_due(const TitleThrottle *throttle) {
+    gint64 next = 0;
+    for (int i = 0; i < throttle->count; i++) {
+        const TitleThrottleEntry *entry = &throttle->entries[i];
+        if (!entry->trailing_pending) continue;
+
+        gint64 due = entry->last_delivery_us + TITLE_THROTTLE_INTERVAL_US;
+        if (next == 0 || due < next) {
+            next = due;
+        }
+    }
+    return next;
+}
+
+static int collect(TitleThrottle *throttle, gint64 now_us, gboolean all,
+                   Window *out, int max_out) {
+    int n = 0;
+    for (int i = 0; i < throttle->count && n < max_out; i++) {
+        TitleThrottleEntry *entry = &throttle->entries[i];
+        if (!entry->trailing_pending) continue;
+        if (!all && now_us - entry->last_delivery_us < TITLE_THROTTLE_INTERVAL_US) continue;
+
+        entry->trailing_pending = FALSE;
+        entry->last_delivery_us = now_us;
+        entry->deliveries++;
+        out[n++] = entry->id;
+    }
+    return n;
+}
+
+int title_throttle_collect_due(TitleThrottle *throttle, gint64 now_us, Window *out, int max_out) {
+    return collect(throttle, now_us, FALSE, out, max_out);
+}
+
+int title_throttle_collect_all(TitleThrottle *throttle, gint64 now_us, Window *out, int max_out) {
+    return collect(throttle, now_us, TRUE, out, max_out);
+}
+
+void title_throttle_forget(TitleThrottle *throttle, Window id) {
+    int index = window_registry_get(&throttle->index, id);
+    if (index < 0) return;
+
+    window_registry_remove(&throttle->index, id);
+    throttle->count--;
+    if (index < throttle->count) {
+        throttle->entries[index] = throttle->entries[throttle->count];
+        window_registry_put(&throttle->index, throttle->entries[index].id, index);
+    }
+}
+
+static int compare_by_rate(const void *a, const void *b) {
+    const TitleThrottleEntry *ea = (const TitleThrottleEntry *)a;
+    const TitleThrottleEntry *eb = (const TitleThrottleEntry *)b;
+    if (ea->events_per_sec != eb->events_per_sec) {
+        return ea->events_per_sec < eb->events_per_sec ? 1 : -1;
+    }
+    if (ea->events != eb->events) {
+        return ea->events < eb->events ? 1 : -1;
+    }
+    return 0;
+}
+
+int title_throttle_stats(const TitleThrottle *throttle, TitleThrottleEntry *out, int max_out) {
+    int n = throttle->count < max_out ? throttle->count : max_out;
+    if (n <= 0) return 0;
+
+    TitleThrottleEntry *sorted = malloc(sizeof(TitleThrottleEntry) * (size_t)throttle->count);
+    if (!sorted) return 0;
+    memcpy(sorted, throttle->entries, sizeof(TitleThrottleEntry) * (size_t)throttle->count);
+    qsort(sorted, (size_t)throttle->count, sizeof(TitleThrottleEntry), compare_by_rate);
+    memcpy(out, sorted, sizeof(TitleThrottleEntry) * (size_t)n);
+    free(sorted);
+    return n;
+}
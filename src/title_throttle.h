@@ -0,0 +1,59 @@
+#ifndef TITLE_THROTTLE_H
+#define TITLE_THROTTLE_H
+
+#include <X11/Xlib.h>
+#include <glib.h>
+#include "window_registry.h"
+
+// At most one title refetch per window per interval; updates inside the
+// interval are delivered once at its end (trailing edge)
+#define TITLE_THROTTLE_INTERVAL_US 250000
+
+// Title updates per second at which a window is reported as noisy
+#define TITLE_SPAM_RATE 10.0
+
+typedef struct {
+    Window id;
+    gint64 last_delivery_us;        // When the last refetch was let through
+    gboolean trailing_pending;      // An update arrived inside the interval
+    unsigned long events;           // Title change events seen
+    unsigned long deliveries;       // Title refetches let through
+    gint64 rate_start_us;           // Start of the current rate sample
+    unsigned int rate_events;       // Events in the current rate sample
+    double events_per_sec;          // Rate over the last full sample
+    gboolean reported;              // Already logged as a noisy window
+} TitleThrottleEntry;
+
+typedef struct {
+    TitleThrottleEntry *entries;    // Grows with the number of noisy windows
+    int count;
+    int capacity;
+    WindowRegistry index;           // Window ID -> index in entries
+} TitleThrottle;
+
+void init_title_throttle(TitleThrottle *throttle);
+
+// Forget every window and release the tables
+void cleanup_title_throttle(TitleThrottle *throttle);
+
+// Record a title change; TRUE when the title should be refetched now,
+// FALSE when delivery was deferred to the end of the interval
+gboolean title_throttle_event(TitleThrottle *throttle, Window id, gint64 now_us);
+
+// Earliest time a deferred title is due (0 = none pending)
+gint64 title_throttle_next_due(const TitleThrottle *throttle);
+
+// Take the windows whose deferred title is due at now_us; returns how many
+// were written to out
+int title_throttle_collect_due(TitleThrottle *throttle, gint64 now_us, Window *out, int max_out);
+
+// Take every deferred title regardless of the interval (before showing)
+int title_throttle_collect_all(TitleThrottle *throttle, gint64 now_us, Window *out, int max_out);
+
+// Drop a window that left the client list
+void title_throttle_forget(TitleThrottle *throttle, Window id);
+
+// Copy per-window stats, noisiest first; returns the number copied
+int title_throttle_stats(const TitleThrottle *throttle, TitleThrottleEntry *out, int max_out);
+
+#endif // TITLE_THROTTLE_H
@@ -0,0 +1,58 @@
+#include "top_k.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define ITEM(base, size, i) ((char *)(base) + (i) * (size))
+
+static void swap_items(char *a, char *b, size_t size) {
+    char tmp[64];
+    while (size > 0) {
+        size_t chunk = size < sizeof(tmp) ? size : sizeof(tmp);
+        memcpy(tmp, a, chunk);
+        memcpy(a, b, chunk);
+        memcpy(b, tmp, chunk);
+        a += chunk;
+        b += chunk;
+        size -= chunk;
+    }
+}
+
+// Restore the heap below root: every parent orders after its children,
+// so the root is the last of the items kept so far
+static void sift_down(char *base, size_t size, size_t root, size_t n,
+                      int (*cmp)(const void *, const void *)) {
+    for (;;) {
+        size_t last = root;
+        size_t left = 2 * root + 1;
+        size_t right = left + 1;
+        if (left < n && cmp(ITEM(base, size, left), ITEM(base, size, last)) > 0) last = left;
+        if (right < n && cmp(ITEM(base, size, right), ITEM(base, size, last)) > 0) last = right;
+        if (last == root) return;
+        swap_items(ITEM(base, size, root), ITEM(base, size, last), size);
+        root = last;
+    }
+}
+
+void top_k_sort(void *base, size_t count, size_t size, size_t k,
+                int (*cmp)(const void *, const void *)) {
+    if (k == 0 || count == 0) return;
+    if (k >= count) {
+        qsort(base, count, size, cmp);
+        return;
+    }
+
+    // Keep the best k seen so far in a heap at the front; an item that
+    // orders before its root replaces it and the root goes to the tail
+    for (size_t i = k / 2; i-- > 0;) {
+        sift_down(base, size, i, k, cmp);
+    }
+    for (size_t i = k; i < count; i++) {
+        if (cmp(ITEM(base, size, i), base) < 0) {
+            swap_items(ITEM(base, size, i), base, size);
+            sift_down(base, size, 0, k, cmp);
+        }
+    }
+
+    qsort(base, k, size, cmp);
+}
@@ -0,0 +1,17 @@
+#ifndef TOP_K_H
+#define TOP_K_H
+
+#include <stddef.h>
+
+// Move the first k items of the order cmp defines to the front of base,
+// sorted; the other count - k follow in no particular order. Costs
+// O(count log k) instead of a full sort's O(count log count).
+//
+// cmp must be a total order (break every tie), so the front is exactly
+// what qsort() of the whole array would put there. The tail only holds
+// items ordered after the front, so calling this again on the tail
+// extends the sorted front.
+void top_k_sort(void *base, size_t count, size_t size, size_t k,
+                int (*cmp)(const void *, const void *));
+
+#endif // TOP_K_H
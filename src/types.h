@@ -4,7 +4,6 @@
 #include <X11/Xlib.h>
 
 // Common size constants - centralized from various headers
-#define MAX_WINDOWS 256
 #define MAX_TITLE_LEN 512
 #define MAX_CLASS_LEN 128
 #define MAX_WORKSPACES 32
@@ -0,0 +1,143 @@
+#include "warm_show.h"
+#include "app_data.h"
+#include "display.h"
+#include "filter.h"
+#include "log.h"
+#include "selection.h"
+
+// Warm show: while the window is hidden, the windows tab is filtered and
+// rendered into the text buffer ahead of time (X events keep app->windows
+// current), so a hotkey only has to map the window. Anything that changes
+// what the list would show calls warm_show_invalidate().
+
+void init_warm_show_state(WarmShowState *state) {
+    state->ready = FALSE;
+    state->prepare_idle_id = 0;
+    state->request_time_us = 0;
+    state->request_warm = FALSE;
+    state->draw_handler_id = 0;
+    state->shows = 0;
+    state->warm_shows = 0;
+    state->over_budget = 0;
+    state->last_paint_us = 0;
+    state->max_paint_us = 0;
+}
+
+static gboolean can_prepare(const AppData *app) {
+    return app->window && app->textbuffer && !app->window_visible &&
+           app->current_tab == TAB_WINDOWS &&
+           app->command_mode.state == CMD_MODE_NORMAL &&
+           app->fixed_cols > 0 && app->fixed_rows > 0;
+}
+
+gboolean warm_show_prepare(AppData *app) {
+    WarmShowState *state = &app->warm_show;
+    if (state->ready) {
+        return TRUE;
+    }
+    if (!can_prepare(app)) {
+        return FALSE;
+    }
+
+    reset_selection(app);
+    filter_windows(app, "");
+    update_display(app);
+    state->ready = TRUE;
+
+    log_trace("Warm show prepared: %d windows rendered", app->filtered_count);
+    return TRUE;
+}
+
+static gboolean warm_show_prepare_idle(gpointer data) {
+    AppData *app = (AppData *)data;
+    app->warm_show.prepare_idle_id = 0;
+    warm_show_prepare(app);
+    return FALSE;
+}
+
+void warm_show_invalidate(AppData *app) {
+    WarmShowState *state = &app->warm_show;
+    state->ready = FALSE;
+
+    if (!app->window_visible && state->prepare_idle_id == 0 && can_prepare(app)) {
+        state->prepare_idle_id = g_idle_add(warm_show_prepare_idle, app);
+    }
+}
+
+gboolean warm_show_is_ready(const AppData *app) {
+    return app->warm_show.ready &&
+           app->current_tab == TAB_WINDOWS &&
+           app->command_mode.state == CMD_MODE_NORMAL &&
+           app->fixed_cols > 0 && app->fixed_rows > 0;
+}
+
+void warm_show_mark_request(AppData *app) {
+    if (app->window_visible || app->warm_show.request_time_us != 0) {
+        return;
+    }
+    app->warm_show.request_time_us = g_get_monotonic_time();
+}
+
+void warm_show_cancel_request(AppData *app) {
+    app->warm_show.request_time_us = 0;
+}
+
+void warm_show_mark_path(AppData *app, gboolean warm) {
+    app->warm_show.request_warm = warm;
+}
+
+static gboolean on_textview_draw_after(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    (void)widget;
+    (void)cr;
+    AppData *app = (AppData *)data;
+    WarmShowState *state = &app->warm_show;
+
+    if (state->request_time_us == 0 || !app->window_visible) {
+        return FALSE;
+    }
+
+    gint64 elapsed = g_get_monotonic_time() - state->request_time_us;
+    state->request_time_us = 0;
+
+    state->shows++;
+    if (state->request_warm) {
+        state->warm_shows++;
+    }
+    state->last_paint_us = elapsed;
+    if (elapsed > state->max_paint_us) {
+        state->max_paint_us = elapsed;
+    }
+
+    if (elapsed > WARM_SHOW_PAINT_BUDGET_US) {
+        state->over_budget++;
+        log_warn("First paint took %.2f ms (%s path, budget %.2f ms, %u/%u shows over)",
+                 elapsed / 1000.0, state->request_warm ? "warm" : "cold",
+                 WARM_SHOW_PAINT_BUDGET_US / 1000.0, state->over_budget, state->shows);
+    } else {
+        log_debug("First paint took %.2f ms (%s path, %u/%u shows warm, max %.2f ms)",
+                  elapsed / 1000.0, state->request_warm ? "warm" : "cold",
+                  state->warm_shows, state->shows, state->max_paint_us / 1000.0);
+    }
+
+    return FALSE;
+}
+
+void attach_warm_show(AppData *app) {
+    if (!app->textview || app->warm_show.draw_handler_id > 0) {
+        return;
+    }
+    app->warm_show.draw_handler_id =
+        g_signal_connect_after(app->textview, "draw",
+                               G_CALLBACK(on_textview_draw_after), app);
+}
+
+void cleanup_warm_show(AppData *app) {
+    WarmShowState *state = &app->warm_show;
+    if (state->prepare_idle_id > 0) {
+        g_source_remove(state->prepare_idle_id);
+        state->prepare_idle_id = 0;
+    }
+    // The handler goes away with the textview itself
+    state->draw_handler_id = 0;
+    state->ready = FALSE;
+}
@@ -0,0 +1,51 @@
+#ifndef WARM_SHOW_H
+#define WARM_SHOW_H
+
+#include <gtk/gtk.h>
+#include <glib.h>
+
+// Hotkey-to-first-paint budget for showing the window (microseconds)
+#define WARM_SHOW_PAINT_BUDGET_US 5000
+
+typedef struct {
+    gboolean ready;                 // Hidden window already holds the rendered windows list
+    guint prepare_idle_id;          // g_idle_add ID for the pending background prepare
+    gint64 request_time_us;         // Monotonic time of the pending show request (0 = none)
+    gboolean request_warm;          // Whether the pending show took the warm path
+    gulong draw_handler_id;         // Textview "draw" handler measuring first paint
+
+    // First-paint statistics
+    guint shows;                    // Shows measured
+    guint warm_shows;               // Shows that painted the prepared buffer
+    guint over_budget;              // Shows slower than WARM_SHOW_PAINT_BUDGET_US
+    gint64 last_paint_us;           // Latency of the most recent show
+    gint64 max_paint_us;            // Worst latency seen
+} WarmShowState;
+
+typedef struct AppData AppData;
+
+void init_warm_show_state(WarmShowState *state);
+
+// Connect the first-paint probe once the textview exists
+void attach_warm_show(AppData *app);
+void cleanup_warm_show(AppData *app);
+
+// Drop the prepared list and rebuild it on idle while the window is hidden
+void warm_show_invalidate(AppData *app);
+
+// Filter and render the windows list into the hidden window now
+gboolean warm_show_prepare(AppData *app);
+
+// True when show_window can map the window without filtering or rendering
+gboolean warm_show_is_ready(const AppData *app);
+
+// Record when a show was requested (hotkey, daemon opcode); first call wins
+void warm_show_mark_request(AppData *app);
+
+// Forget a show request that did not end up mapping the window
+void warm_show_cancel_request(AppData *app);
+
+// Note whether the show about to be painted used the prepared list
+void warm_show_mark_path(AppData *app, gboolean warm);
+
+#endif // WARM_SHOW_H
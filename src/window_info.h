@@ -4,6 +4,18 @@
 #include <X11/Xlib.h>
 #include "types.h"
 
+// _NET_WM_STATE flags cached in WindowInfo.state
+#define WINDOW_STATE_FLAG_HIDDEN            (1u << 0)
+#define WINDOW_STATE_FLAG_SHADED            (1u << 1)
+#define WINDOW_STATE_FLAG_STICKY            (1u << 2)
+#define WINDOW_STATE_FLAG_MAXIMIZED_VERT    (1u << 3)
+#define WINDOW_STATE_FLAG_MAXIMIZED_HORZ    (1u << 4)
+#define WINDOW_STATE_FLAG_FULLSCREEN        (1u << 5)
+#define WINDOW_STATE_FLAG_ABOVE             (1u << 6)
+#define WINDOW_STATE_FLAG_BELOW             (1u << 7)
+#define WINDOW_STATE_FLAG_SKIP_TASKBAR      (1u << 8)
+#define WINDOW_STATE_FLAG_DEMANDS_ATTENTION (1u << 9)
+
 typedef struct WindowInfo {
     Window id;
     char title[MAX_TITLE_LEN];
@@ -12,6 +24,7 @@ typedef struct WindowInfo {
     char type[16]; // "Normal" or "Special"
     int desktop;
     int pid;
+    unsigned int state; // WINDOW_STATE_FLAG_* from _NET_WM_STATE
 } WindowInfo;
 
 #endif // WINDOW_INFO_H
\ No newline at end of file
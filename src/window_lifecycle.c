@@ -15,8 +15,10 @@
 #include "run_mode.h"
 #include "selection.h"
 #include "tab_switching.h"
+#include "warm_show.h"
 #include "window_highlight.h"
 #include "window_list.h"
+#include "x11_events.h"
 #include "workspace_utils.h"
 #include "x11_utils.h"
 
@@ -76,6 +78,7 @@ void destroy_window(AppData *app) {
         save_config(&app->config);
         save_harpoon_slots(&app->harpoon);
 
+        cleanup_warm_show(app);
         gtk_widget_destroy(app->window);
         app->window = NULL;
         app->entry = NULL;
@@ -145,6 +148,10 @@ void hide_window(AppData *app) {
     gtk_widget_hide(app->window);
     app->window_visible = FALSE;
 
+    // Re-render the windows list in the background for the next show
+    warm_show_cancel_request(app);
+    warm_show_invalidate(app);
+
     log_debug("Window hidden, X11 event processing continues");
 }
 
@@ -234,6 +241,7 @@ void show_window(AppData *app) {
         return;
     }
 
+    warm_show_mark_request(app);
     log_debug("Showing window and refreshing state");
 
     if (app->mode_indicator) {
@@ -246,10 +254,26 @@ void show_window(AppData *app) {
         gtk_label_set_text(GTK_LABEL(app->mode_indicator), indicator);
     }
 
-    get_window_list(app);
-    check_and_reassign_windows(&app->harpoon, app->windows, app->window_count);
+    // While event monitoring runs, app->windows is kept current by X events:
+    // just apply what is already queued instead of refetching every window
+    if (x11_event_monitoring_active()) {
+        drain_x11_events(app);
+    } else {
+        get_window_list(app);
+        warm_show_invalidate(app);
+    }
+    if (check_and_reassign_windows(&app->harpoon, app->windows, app->window_count)) {
+        warm_show_invalidate(app);
+    }
 
-    if (app->current_tab == TAB_WINDOWS) {
+    // Warm path: the hidden window already holds the filtered and rendered
+    // windows list, so showing it is only a map
+    gboolean warm = warm_show_is_ready(app);
+    warm_show_mark_path(app, warm);
+
+    if (warm) {
+        log_debug("Showing pre-rendered windows list (%d windows)", app->filtered_count);
+    } else if (app->current_tab == TAB_WINDOWS) {
         reset_selection(app);
         filter_windows(app, "");
     } else if (app->current_tab == TAB_WORKSPACES) {
@@ -262,10 +286,12 @@ void show_window(AppData *app) {
     app->window_visible = TRUE;
     ensure_cofi_on_current_workspace(app);
 
-    if (app->fixed_cols > 0 && app->fixed_rows > 0) {
-        update_display(app);
-    } else {
-        app->pending_initial_render = TRUE;
+    if (!warm) {
+        if (app->fixed_cols > 0 && app->fixed_rows > 0) {
+            update_display(app);
+        } else {
+            app->pending_initial_render = TRUE;
+        }
     }
 
     GtkWindow *window = GTK_WINDOW(app->window);
@@ -2,6 +2,10 @@
 #include <X11/Xlib.h>
 #include <X11/Xatom.h>
 #include <X11/Xutil.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <strings.h>
 #include "app_data.h"
@@ -9,124 +13,700 @@
 #include "x11_utils.h"
 #include "log.h"
 #include "utils.h"
+#include "window_store.h"
 
-// Get list of all windows using _NET_CLIENT_LIST
-void get_window_list(AppData *app) {
-    app->window_count = 0;
-    
-    log_debug("Getting window list...");
-    log_trace("net_client_list atom = %lu", app->atoms.net_client_list);
-    
-    unsigned char *prop = NULL;
-    unsigned long n_items;
-    
-    // Get the client list from the root window
-    if (get_x11_property(app->display, DefaultRootWindow(app->display), 
-                         app->atoms.net_client_list, XA_WINDOW, (~0L), 
-                         NULL, NULL, &n_items, &prop) != COFI_SUCCESS) {
+// Same length limits (in 32-bit units) as the Xlib getters in x11_utils.c
+#define PROP_LEN_UNLIMITED UINT32_MAX
+#define PROP_LEN_WM_CLASS 1024
+#define PROP_LEN_ATOM_LIST 64
+
+// Outstanding requests for one client window
+typedef struct {
+    xcb_get_window_attributes_cookie_t attrs;
+    xcb_get_property_cookie_t net_wm_name;
+    xcb_get_property_cookie_t wm_name;
+    xcb_get_property_cookie_t wm_class;
+    xcb_get_property_cookie_t window_type;
+    xcb_get_property_cookie_t pid;
+    xcb_get_property_cookie_t desktop;
+    xcb_get_property_cookie_t state;
+    unsigned int fields;  // WindowField mask of valid property cookies
+    bool has_attrs;       // attrs cookie valid (existence check)
+} WindowCookies;
+
+static WindowListStats last_stats;
+
+const WindowListStats *get_window_list_stats(void) {
+    return &last_stats;
+}
+
+unsigned int window_field_for_atom(const AtomCache *atoms, Atom atom) {
+    if (atom == None) return 0;
+    if (atom == atoms->net_wm_name || atom == XA_WM_NAME) return WINDOW_FIELD_TITLE;
+    if (atom == XA_WM_CLASS) return WINDOW_FIELD_CLASS;
+    if (atom == atoms->net_wm_window_type) return WINDOW_FIELD_TYPE;
+    if (atom == atoms->net_wm_pid) return WINDOW_FIELD_PID;
+    if (atom == atoms->net_wm_desktop) return WINDOW_FIELD_DESKTOP;
+    if (atom == atoms->net_wm_state) return WINDOW_FIELD_STATE;
+    return 0;
+}
+
+static xcb_get_property_cookie_t request_property(xcb_connection_t *conn, Window window,
+                                                  Atom property, Atom type, uint32_t length) {
+    last_stats.requests_sent++;
+    return xcb_get_property(conn, 0, (xcb_window_t)window, (xcb_atom_t)property,
+                            (xcb_atom_t)type, 0, length);
+}
+
+// Every reply is read through here so round_trips counts the waits that
+// actually happen: a reply already read off the socket is taken without
+// blocking, anything else means waiting on the server.
+static void *await_reply(xcb_connection_t *conn, unsigned int sequence,
+                         xcb_generic_error_t **error) {
+    void *reply = NULL;
+    if (xcb_poll_for_reply(conn, sequence, &reply, error)) return reply;
+    last_stats.round_trips++;
+    return xcb_wait_for_reply(conn, sequence, error);
+}
+
+// Collect a property reply. Returns NULL if the property does not exist
+// (Xlib reports actual_type None in that case and get_x11_property fails).
+// X errors (window already destroyed) are counted in *errors.
+static xcb_get_property_reply_t *collect_property(xcb_connection_t *conn,
+                                                  xcb_get_property_cookie_t cookie,
+                                                  int *errors) {
+    xcb_generic_error_t *error = NULL;
+    xcb_get_property_reply_t *reply = await_reply(conn, cookie.sequence, &error);
+    if (error) {
+        if (errors) (*errors)++;
+        free(error);
+    }
+    if (reply && reply->type == XCB_NONE) {
+        free(reply);
+        return NULL;
+    }
+    return reply;
+}
+
+// Title string from a property reply (NUL-terminated copy, like g_strdup on the Xlib buffer)
+static char *title_from_reply(xcb_get_property_reply_t *reply) {
+    if (!reply) return NULL;
+    return g_strndup((const char *)xcb_get_property_value(reply),
+                     xcb_get_property_value_length(reply));
+}
+
+// Mirrors get_window_class(): WM_CLASS holds "instance\0class\0"
+static void class_from_reply(xcb_get_property_reply_t *reply, char *instance, char *class_name) {
+    instance[0] = '\0';
+    class_name[0] = '\0';
+    if (!reply) return;
+
+    int len = xcb_get_property_value_length(reply);
+    char buf[PROP_LEN_WM_CLASS * 4 + 1];
+    if (len > (int)sizeof(buf) - 1) len = sizeof(buf) - 1;
+    memcpy(buf, xcb_get_property_value(reply), len);
+    buf[len] = '\0';
+
+    int null_pos = -1;
+    for (int i = 0; i < len; i++) {
+        if (buf[i] == '\0') {
+            null_pos = i;
+            break;
+        }
+    }
+
+    if (null_pos >= 0 && null_pos + 1 < len) {
+        safe_string_copy(instance, buf, MAX_CLASS_LEN);
+        safe_string_copy(class_name, buf + null_pos + 1, MAX_CLASS_LEN);
+    } else if (null_pos == -1) {
+        // Malformed, treat whole thing as instance
+        safe_string_copy(instance, buf, MAX_CLASS_LEN);
+    }
+}
+
+// Mirrors get_window_type_cached(): Normal only if every listed type is NORMAL
+static const char *type_from_reply(xcb_get_property_reply_t *reply, const AtomCache *atoms) {
+    if (!reply || reply->format != 32) return WINDOW_TYPE_NORMAL;
+
+    int n_items = xcb_get_property_value_length(reply) / 4;
+    if (n_items <= 0) return WINDOW_TYPE_NORMAL;
+
+    const uint32_t *types = (const uint32_t *)xcb_get_property_value(reply);
+    if (atoms->net_wm_window_type_normal == None) return WINDOW_TYPE_SPECIAL;
+    for (int i = 0; i < n_items; i++) {
+        if (types[i] != (uint32_t)atoms->net_wm_window_type_normal) {
+            return WINDOW_TYPE_SPECIAL;
+        }
+    }
+    return WINDOW_TYPE_NORMAL;
+}
+
+// CARDINAL value as signed 32-bit (Xlib sign-extends, so sticky 0xFFFFFFFF reads as -1)
+static int cardinal_from_reply(xcb_get_property_reply_t *reply, int fallback) {
+    if (!reply || reply->format != 32 || xcb_get_property_value_length(reply) < 4) {
+        return fallback;
+    }
+    return (int32_t)*(const uint32_t *)xcb_get_property_value(reply);
+}
+
+// _NET_WM_STATE atom list as WINDOW_STATE_FLAG_* bits
+static unsigned int state_from_reply(xcb_get_property_reply_t *reply, const AtomCache *atoms) {
+    if (!reply || reply->format != 32) return 0;
+
+    const struct {
+        Atom atom;
+        unsigned int flag;
+    } map[] = {
+        { atoms->net_wm_state_hidden, WINDOW_STATE_FLAG_HIDDEN },
+        { atoms->net_wm_state_shaded, WINDOW_STATE_FLAG_SHADED },
+        { atoms->net_wm_state_sticky, WINDOW_STATE_FLAG_STICKY },
+        { atoms->net_wm_state_maximized_vert, WINDOW_STATE_FLAG_MAXIMIZED_VERT },
+        { atoms->net_wm_state_maximized_horz, WINDOW_STATE_FLAG_MAXIMIZED_HORZ },
+        { atoms->net_wm_state_fullscreen, WINDOW_STATE_FLAG_FULLSCREEN },
+        { atoms->net_wm_state_above, WINDOW_STATE_FLAG_ABOVE },
+        { atoms->net_wm_state_below, WINDOW_STATE_FLAG_BELOW },
+        { atoms->net_wm_state_skip_taskbar, WINDOW_STATE_FLAG_SKIP_TASKBAR },
+        { atoms->net_wm_state_demands_attention, WINDOW_STATE_FLAG_DEMANDS_ATTENTION },
+    };
+
+    unsigned int state = 0;
+    int n_items = xcb_get_property_value_length(reply) / 4;
+    const uint32_t *values = (const uint32_t *)xcb_get_property_value(reply);
+    for (int i = 0; i < n_items; i++) {
+        for (size_t m = 0; m < sizeof(map) / sizeof(map[0]); m++) {
+            if (map[m].atom != None && values[i] == (uint32_t)map[m].atom) {
+                state |= map[m].flag;
+            }
+        }
+    }
+    return state;
+}
+
+// Queue the requests needed for `fields` of one window (no reply is read here)
+static void request_fields(AppData *app, xcb_connection_t *conn, Window window,
+                           unsigned int fields, bool with_attrs, WindowCookies *c) {
+    c->fields = fields;
+    c->has_attrs = with_attrs;
+
+    if (with_attrs) {
+        c->attrs = xcb_get_window_attributes(conn, (xcb_window_t)window);
+        last_stats.requests_sent++;
+    }
+    if (fields & WINDOW_FIELD_TITLE) {
+        // Both title sources are requested up front; WM_NAME is only used as fallback
+        c->net_wm_name = request_property(conn, window, app->atoms.net_wm_name,
+                                          AnyPropertyType, PROP_LEN_UNLIMITED);
+        c->wm_name = request_property(conn, window, XA_WM_NAME,
+                                      AnyPropertyType, PROP_LEN_UNLIMITED);
+    }
+    if (fields & WINDOW_FIELD_CLASS) {
+        c->wm_class = request_property(conn, window, XA_WM_CLASS,
+                                       XA_STRING, PROP_LEN_WM_CLASS);
+    }
+    if (fields & WINDOW_FIELD_TYPE) {
+        c->window_type = request_property(conn, window, app->atoms.net_wm_window_type,
+                                          XA_ATOM, PROP_LEN_ATOM_LIST);
+    }
+    if (fields & WINDOW_FIELD_PID) {
+        c->pid = request_property(conn, window, app->atoms.net_wm_pid, XA_CARDINAL, 1);
+    }
+    if (fields & WINDOW_FIELD_DESKTOP) {
+        c->desktop = request_property(conn, window, app->atoms.net_wm_desktop, XA_CARDINAL, 1);
+    }
+    if (fields & WINDOW_FIELD_STATE) {
+        c->state = request_property(conn, window, app->atoms.net_wm_state,
+                                    XA_ATOM, PROP_LEN_ATOM_LIST);
+    }
+}
+
+static void discard_window_replies(xcb_connection_t *conn, const WindowCookies *c) {
+    if (c->has_attrs) xcb_discard_reply(conn, c->attrs.sequence);
+    if (c->fields & WINDOW_FIELD_TITLE) {
+        xcb_discard_reply(conn, c->net_wm_name.sequence);
+        xcb_discard_reply(conn, c->wm_name.sequence);
+    }
+    if (c->fields & WINDOW_FIELD_CLASS) xcb_discard_reply(conn, c->wm_class.sequence);
+    if (c->fields & WINDOW_FIELD_TYPE) xcb_discard_reply(conn, c->window_type.sequence);
+    if (c->fields & WINDOW_FIELD_PID) xcb_discard_reply(conn, c->pid.sequence);
+    if (c->fields & WINDOW_FIELD_DESKTOP) xcb_discard_reply(conn, c->desktop.sequence);
+    if (c->fields & WINDOW_FIELD_STATE) xcb_discard_reply(conn, c->state.sequence);
+}
+
+// Read the replies queued by request_fields() into `win`. Returns false if
+// the existence check failed; X errors on property requests are counted in
+// *errors so callers can tell a destroyed window from a missing property.
+static bool collect_fields(AppData *app, xcb_connection_t *conn, const WindowCookies *c,
+                           WindowInfo *win, int *errors) {
+    if (c->has_attrs) {
+        // Validate window exists (like Go code's isValidWindow)
+        xcb_get_window_attributes_reply_t *attrs =
+            await_reply(conn, c->attrs.sequence, NULL);
+        if (!attrs) {
+            WindowCookies rest = *c;
+            rest.has_attrs = false;
+            discard_window_replies(conn, &rest);
+            return false;
+        }
+        free(attrs);
+    }
+
+    if (c->fields & WINDOW_FIELD_TITLE) {
+        // Prefer _NET_WM_NAME, fallback to WM_NAME
+        xcb_get_property_reply_t *net_name = collect_property(conn, c->net_wm_name, errors);
+        xcb_get_property_reply_t *wm_name = collect_property(conn, c->wm_name, errors);
+        char *title = title_from_reply(net_name ? net_name : wm_name);
+        free(net_name);
+        free(wm_name);
+
+        // Store title - use "Untitled window" if empty
+        if (title && strlen(title) > 0) {
+            safe_string_copy(win->title, title, MAX_TITLE_LEN);
+        } else {
+            safe_string_copy(win->title, "Untitled window", MAX_TITLE_LEN);
+        }
+        if (title) g_free(title);
+    }
+    if (c->fields & WINDOW_FIELD_CLASS) {
+        xcb_get_property_reply_t *reply = collect_property(conn, c->wm_class, errors);
+        class_from_reply(reply, win->instance, win->class_name);
+        free(reply);
+    }
+    if (c->fields & WINDOW_FIELD_TYPE) {
+        xcb_get_property_reply_t *reply = collect_property(conn, c->window_type, errors);
+        safe_string_copy(win->type, type_from_reply(reply, &app->atoms), sizeof(win->type));
+        free(reply);
+    }
+    if (c->fields & WINDOW_FIELD_PID) {
+        xcb_get_property_reply_t *reply = collect_property(conn, c->pid, errors);
+        win->pid = cardinal_from_reply(reply, 0);
+        free(reply);
+    }
+    if (c->fields & WINDOW_FIELD_DESKTOP) {
+        xcb_get_property_reply_t *reply = collect_property(conn, c->desktop, errors);
+        win->desktop = cardinal_from_reply(reply, -1);
+        free(reply);
+    }
+    if (c->fields & WINDOW_FIELD_STATE) {
+        xcb_get_property_reply_t *reply = collect_property(conn, c->state, errors);
+        win->state = state_from_reply(reply, &app->atoms);
+        free(reply);
+    }
+    return true;
+}
+
+// Client IDs that are not stored in app->windows on purpose (cofi's own
+// windows). Remembered so the incremental update does not refetch them.
+// Only a handful exist, so a linear scan is fine.
+static Window *skipped_ids = NULL;
+static int skipped_capacity = 0;
+static int skipped_count = 0;
+
+static int is_skipped(Window id) {
+    for (int i = 0; i < skipped_count; i++) {
+        if (skipped_ids[i] == id) return 1;
+    }
+    return 0;
+}
+
+static void remember_skipped(Window id) {
+    if (!is_skipped(id) && GROW_ARRAY(skipped_ids, skipped_capacity, skipped_count + 1)) {
+        skipped_ids[skipped_count++] = id;
+    }
+}
+
+// Fetch _NET_CLIENT_LIST (one round trip). Caller frees the reply.
+static xcb_get_property_reply_t *fetch_client_list(AppData *app, xcb_connection_t *conn) {
+    xcb_get_property_cookie_t list_cookie = request_property(
+        conn, DefaultRootWindow(app->display), app->atoms.net_client_list,
+        XA_WINDOW, PROP_LEN_UNLIMITED);
+    xcb_get_property_reply_t *list_reply = collect_property(conn, list_cookie, NULL);
+    if (!list_reply) {
         log_error("Failed to get window list");
-        return;
     }
-    
-    log_debug("Found %lu windows", n_items);
-    
-    Window *windows = (Window*)prop;
-    app->window_count = 0;
-    
-    // Validate window count
-    if (n_items > MAX_WINDOWS) {
-        log_warn("System has %lu windows, but COFI only supports %d. Some windows will be skipped.", n_items, MAX_WINDOWS);
-    }
-    
-    for (unsigned long i = 0; i < n_items; i++) {
-        Window window = windows[i];
-        
+    return list_reply;
+}
+
+// Acquire properties for the given client IDs and store them in `out`.
+// Every request for every window is queued before any reply is read, so
+// this costs one round trip no matter how many IDs are passed.
+// Returns the number of windows stored.
+static int acquire_windows(AppData *app, xcb_connection_t *conn,
+                           const uint32_t *ids, int n_ids,
+                           WindowInfo *out, int max_out) {
+    if (n_ids <= 0) return 0;
+
+    WindowCookies *cookies = malloc(sizeof(WindowCookies) * n_ids);
+    if (!cookies) {
+        log_error("Failed to allocate request batch for %d windows", n_ids);
+        return 0;
+    }
+
+    // Issue every request for every window before reading any reply
+    for (int i = 0; i < n_ids; i++) {
         // Skip null window IDs (like Go code line 244)
-        if (window == 0) {
+        if (ids[i] == 0) continue;
+        request_fields(app, conn, ids[i], WINDOW_FIELD_ALL, true, &cookies[i]);
+        last_stats.windows_requested++;
+    }
+
+    // Replies arrive back to back, only the first one is waited for
+    xcb_flush(conn);
+
+    int stored = 0;
+    int limit_logged = 0;
+    for (int i = 0; i < n_ids; i++) {
+        Window window = ids[i];
+        if (window == 0) continue;
+
+        const WindowCookies *c = &cookies[i];
+
+        if (stored >= max_out) {
+            if (!limit_logged) {
+                log_error("No room for more than %d windows, skipping remaining windows", max_out);
+                limit_logged = 1;
+            }
+            // Keep draining so no reply is left queued on the connection
+            discard_window_replies(conn, c);
             continue;
         }
-        
-        // Validate window exists (like Go code's isValidWindow)
-        XWindowAttributes attrs;
-        if (XGetWindowAttributes(app->display, window, &attrs) == 0) {
+
+        WindowInfo win = {0};
+        win.id = window;
+        if (!collect_fields(app, conn, c, &win, NULL)) {
             log_trace("Window %lu no longer exists, skipping", window);
-            continue; // Window doesn't exist
-        }
-        
-        // Get window title - prefer _NET_WM_NAME, fallback to WM_NAME
-        char *title = get_window_property(app->display, window, app->atoms.net_wm_name);
-        if (!title) {
-            title = get_window_property(app->display, window, XA_WM_NAME);
-        }
-        // Don't skip windows without titles (Go code has this commented out)
-        
-        log_trace("Window %lu - Title: '%s'", window, title ? title : "(no title)");
-        
-        // Get window class (instance and class)
-        char instance[MAX_CLASS_LEN];
-        char class_name[MAX_CLASS_LEN];
-        get_window_class(app->display, window, instance, class_name);
-        
+            continue;
+        }
+
+        log_trace("Window %lu - Title: '%s'", window, win.title);
+
         // Skip cofi windows
-        if (strcasecmp(class_name, "cofi") == 0) {
-            log_trace("Skipping cofi window: %lu (class: %s)", window, class_name);
+        if (strcasecmp(win.class_name, "cofi") == 0) {
+            log_trace("Skipping cofi window: %lu (class: %s)", window, win.class_name);
+            remember_skipped(window);
             continue;
         }
-        
-        // Get window type
-        char *type = get_window_type_cached(app->display, window, &app->atoms);
-        
-        // Get window PID
-        int pid = get_window_pid_cached(app->display, window, &app->atoms);
-        
-        // Get desktop number
-        int desktop = -1;
-        unsigned char *desk_prop = NULL;
-        int desk_actual_format;
-        unsigned long desk_n_items;
-        
-        if (get_x11_property(app->display, window, app->atoms.net_wm_desktop, XA_CARDINAL,
-                            1, NULL, &desk_actual_format, &desk_n_items, &desk_prop) == COFI_SUCCESS) {
-            desktop = *(long*)desk_prop;
-            XFree(desk_prop);
-        }
-        
-        // Store window info
-        if (app->window_count >= MAX_WINDOWS) {
-            log_error("Maximum window limit reached (%d), skipping remaining windows", MAX_WINDOWS);
-            break;
+
+        out[stored++] = win;
+    }
+
+    free(cookies);
+    return stored;
+}
+
+// Rebuild app->windows_by_id after app->windows changed
+static void index_windows(AppData *app) {
+    window_registry_clear(&app->windows_by_id);
+    for (int i = 0; i < app->window_count; i++) {
+        window_registry_put(&app->windows_by_id, app->windows[i].id, i);
+    }
+}
+
+int find_window_index(const AppData *app, Window id) {
+    int index = window_registry_get(&app->windows_by_id, id);
+    if (index < 0 || index >= app->window_count || app->windows[index].id != id) {
+        return -1;
+    }
+    return index;
+}
+
+// Get list of all windows using _NET_CLIENT_LIST.
+// Costs two round trips (client list + one property batch) no matter how
+// many windows exist.
+void get_window_list(AppData *app) {
+    app->window_count = 0;
+    skipped_count = 0;
+    memset(&last_stats, 0, sizeof(last_stats));
+
+    log_debug("Getting window list...");
+    log_trace("net_client_list atom = %lu", app->atoms.net_client_list);
+
+    xcb_connection_t *conn = XGetXCBConnection(app->display);
+    if (!conn) {
+        log_error("No XCB connection for display");
+        return;
+    }
+
+    xcb_get_property_reply_t *list_reply = fetch_client_list(app, conn);
+    if (!list_reply) return;
+
+    int n_items = xcb_get_property_value_length(list_reply) / 4;
+    const uint32_t *ids = (const uint32_t *)xcb_get_property_value(list_reply);
+
+    log_debug("Found %d windows", n_items);
+
+    ensure_window_capacity(app, n_items);
+    app->window_count = acquire_windows(app, conn, ids, n_items, app->windows,
+                                        app->window_capacity);
+    index_windows(app);
+
+    free(list_reply);
+
+    log_debug("Total windows stored: %d (%d requests, %d round trips)",
+              app->window_count, last_stats.requests_sent, last_stats.round_trips);
+}
+
+static int compare_window_ids(const void *a, const void *b) {
+    Window wa = *(const Window *)a;
+    Window wb = *(const Window *)b;
+    return (wa > wb) - (wa < wb);
+}
+
+static int contains_id(const Window *sorted, int count, Window id) {
+    return bsearch(&id, sorted, count, sizeof(Window), compare_window_ids) != NULL;
+}
+
+// Scratch space for update_window_list(); grows with the client list and
+// is reused across updates
+static WindowInfo *added_windows = NULL;
+static int added_capacity = 0;
+static int *row_sources = NULL;      // per new row: kept rank, or ~added index
+static int row_sources_capacity = 0;
+static int *kept_slots = NULL;       // old index -> kept rank, then kept permutation
+static int kept_slots_capacity = 0;
+
+// Put the kept windows (already compacted to the front) into client-list
+// order: slot r takes the window of rank order[r]. Cycles are followed in
+// place with one spare WindowInfo; order[] is consumed.
+static void permute_kept_windows(AppData *app, int *order, int kept) {
+    for (int start = 0; start < kept; start++) {
+        if (order[start] < 0 || order[start] == start) continue;
+        WindowInfo spare = app->windows[start];
+        int j = start;
+        while (order[j] != start) {
+            int next = order[j];
+            app->windows[j] = app->windows[next];
+            order[j] = -1;
+            j = next;
+        }
+        app->windows[j] = spare;
+        order[j] = -1;
+    }
+}
+
+// Diff _NET_CLIENT_LIST against the windows already known. Only added IDs
+// are fetched from the server; removed ones are dropped and all others keep
+// their current WindowInfo. The resulting app->windows has the same content
+// and order as a full get_window_list() would produce. app->windows is
+// edited in place: windows ahead of the first removal or insertion never
+// move, so the common cases (nothing changed, a window opened at the end)
+// copy no kept window at all.
+void update_window_list(AppData *app, WindowListDelta *delta) {
+    delta->added_count = 0;
+    delta->removed_count = 0;
+    delta->order_changed = false;
+    memset(&last_stats, 0, sizeof(last_stats));
+
+    xcb_connection_t *conn = XGetXCBConnection(app->display);
+    if (!conn) {
+        log_error("No XCB connection for display");
+        return;
+    }
+
+    xcb_get_property_reply_t *list_reply = fetch_client_list(app, conn);
+    if (!list_reply) return;
+
+    int n_items = xcb_get_property_value_length(list_reply) / 4;
+    const uint32_t *ids = (const uint32_t *)xcb_get_property_value(list_reply);
+
+    // Old IDs are looked up through app->windows_by_id (still describing
+    // the old array until rows move below); the new set gets a sorted view
+    int old_count = app->window_count;
+
+    Window *new_sorted = n_items > 0 ? malloc(sizeof(Window) * n_items) : NULL;
+    uint32_t *to_fetch = n_items > 0 ? malloc(sizeof(uint32_t) * n_items) : NULL;
+    if (n_items > 0 && (!new_sorted || !to_fetch)) {
+        log_error("Failed to allocate diff buffers for %d windows", n_items);
+        free(new_sorted);
+        free(to_fetch);
+        free(list_reply);
+        return;
+    }
+
+    int fetch_count = 0;
+    for (int i = 0; i < n_items; i++) {
+        new_sorted[i] = ids[i];
+        if (ids[i] != 0 && find_window_index(app, ids[i]) < 0 && !is_skipped(ids[i])) {
+            to_fetch[fetch_count++] = ids[i];
+        }
+    }
+    qsort(new_sorted, n_items, sizeof(Window), compare_window_ids);
+
+    if (!GROW_ARRAY(delta->removed, delta->removed_capacity, old_count) ||
+        !GROW_ARRAY(delta->added, delta->added_capacity, n_items) ||
+        !GROW_ARRAY(added_windows, added_capacity, fetch_count) ||
+        !GROW_ARRAY(row_sources, row_sources_capacity, n_items) ||
+        !GROW_ARRAY(kept_slots, kept_slots_capacity, old_count) ||
+        !ensure_window_capacity(app, n_items)) {
+        free(new_sorted);
+        free(to_fetch);
+        free(list_reply);
+        return;
+    }
+
+    int kept = 0;
+    for (int i = 0; i < old_count; i++) {
+        Window id = app->windows[i].id;
+        if (contains_id(new_sorted, n_items, id)) {
+            kept_slots[i] = kept++;
         } else {
-            WindowInfo *win = &app->windows[app->window_count];
-            win->id = window;
-            
-            // Store title - use "Untitled window" if empty
-            if (title && strlen(title) > 0) {
-                safe_string_copy(win->title, title, MAX_TITLE_LEN);
-            } else {
-                safe_string_copy(win->title, "Untitled window", MAX_TITLE_LEN);
-            }
-            
-            // Store instance and class
-            safe_string_copy(win->instance, instance, MAX_CLASS_LEN);
-            safe_string_copy(win->class_name, class_name, MAX_CLASS_LEN);
-            
-            // Store type
-            if (type) {
-                safe_string_copy(win->type, type, sizeof(win->type));
-                g_free(type);
-            } else {
-                strcpy(win->type, "Normal");
+            kept_slots[i] = -1;
+            delta->removed[delta->removed_count++] = id;
+        }
+    }
+
+    // Forget skipped IDs that left the client list
+    int write = 0;
+    for (int i = 0; i < skipped_count; i++) {
+        if (contains_id(new_sorted, n_items, skipped_ids[i])) {
+            skipped_ids[write++] = skipped_ids[i];
+        }
+    }
+    skipped_count = write;
+
+    int fetched = acquire_windows(app, conn, to_fetch, fetch_count, added_windows,
+                                  added_capacity);
+
+    // Lay out the new rows in client-list order: each is either a kept
+    // window (by rank among the kept ones) or one from the batch. Both lists
+    // follow ids[] order, so one cursor suffices for the batch.
+    int merged = 0;
+    int added_cursor = 0;
+    int last_rank = -1;
+    for (int i = 0; i < n_items; i++) {
+        Window id = ids[i];
+        if (id == 0) continue;
+
+        if (added_cursor < fetched && added_windows[added_cursor].id == id) {
+            delta->added[delta->added_count++] = merged;
+            row_sources[merged++] = ~added_cursor++;
+            continue;
+        }
+
+        // Kept window: rank -1 means unknown, or a duplicate already placed
+        int idx = find_window_index(app, id);
+        if (idx < 0 || kept_slots[idx] < 0) continue;
+        int rank = kept_slots[idx];
+        kept_slots[idx] = -1;
+        if (rank < last_rank) {
+            delta->order_changed = true;
+        }
+        last_rank = rank;
+        row_sources[merged++] = rank;
+    }
+
+    // Drop removed windows, closing the gaps towards the front
+    write = 0;
+    for (int i = 0; i < old_count; i++) {
+        if (!contains_id(new_sorted, n_items, app->windows[i].id)) continue;
+        if (write != i) app->windows[write] = app->windows[i];
+        write++;
+    }
+
+    if (delta->order_changed) {
+        int r = 0;
+        for (int i = 0; i < merged; i++) {
+            if (row_sources[i] >= 0) {
+                kept_slots[r] = row_sources[i];
+                row_sources[i] = r++;
             }
-            
-            win->desktop = desktop;
-            win->pid = pid;
-            app->window_count++;
         }
-        
-        if (title) g_free(title);
+        permute_kept_windows(app, kept_slots, r);
     }
-    
-    XFree(prop);
-    
-    log_debug("Total windows stored: %d", app->window_count);
-}
\ No newline at end of file
+
+    // Open gaps for added windows from the back, so every kept window moves
+    // at most once and only when something was inserted ahead of it (kept
+    // ranks now ascend, so a kept window's rank is never past its new row)
+    for (int i = merged - 1; i >= 0; i--) {
+        int source = row_sources[i];
+        if (source < 0) {
+            app->windows[i] = added_windows[~source];
+        } else if (source != i) {
+            app->windows[i] = app->windows[source];
+        }
+    }
+    app->window_count = merged;
+    index_windows(app);
+
+    free(new_sorted);
+    free(to_fetch);
+    free(list_reply);
+
+    log_debug("Window list updated: %d added, %d removed, %d total (%d requests, %d round trips)",
+              delta->added_count, delta->removed_count, app->window_count,
+              last_stats.requests_sent, last_stats.round_trips);
+}
+
+// Refetch changed properties of known windows in one pipelined batch.
+// On return updates[i].fields holds the fields whose value actually
+// changed. Returns the number of windows with at least one change.
+int refresh_window_properties(AppData *app, WindowPropertyUpdate *updates, int count) {
+    memset(&last_stats, 0, sizeof(last_stats));
+    if (count <= 0) return 0;
+
+    xcb_connection_t *conn = XGetXCBConnection(app->display);
+    if (!conn) {
+        log_error("No XCB connection for display");
+        return 0;
+    }
+
+    WindowCookies *cookies = malloc(sizeof(WindowCookies) * count);
+    int *indices = malloc(sizeof(int) * count);
+    if (!cookies || !indices) {
+        log_error("Failed to allocate refresh batch for %d windows", count);
+        free(cookies);
+        free(indices);
+        return 0;
+    }
+
+    int requested = 0;
+    for (int i = 0; i < count; i++) {
+        indices[i] = find_window_index(app, updates[i].id);
+        if (indices[i] < 0 || updates[i].fields == 0) {
+            indices[i] = -1;
+            updates[i].fields = 0;
+            continue;
+        }
+        request_fields(app, conn, updates[i].id, updates[i].fields, false, &cookies[i]);
+        last_stats.windows_requested++;
+        requested++;
+    }
+
+    if (requested > 0) {
+        xcb_flush(conn);
+    }
+
+    int changed_windows = 0;
+    for (int i = 0; i < count; i++) {
+        if (indices[i] < 0) continue;
+
+        WindowInfo *cached = &app->windows[indices[i]];
+        WindowInfo fresh = *cached;
+        int errors = 0;
+        collect_fields(app, conn, &cookies[i], &fresh, &errors);
+        if (errors > 0) {
+            // Window is being destroyed; _NET_CLIENT_LIST will drop it
+            updates[i].fields = 0;
+            continue;
+        }
+
+        unsigned int changed = 0;
+        if (strcmp(cached->title, fresh.title) != 0) changed |= WINDOW_FIELD_TITLE;
+        if (strcmp(cached->class_name, fresh.class_name) != 0 ||
+            strcmp(cached->instance, fresh.instance) != 0) changed |= WINDOW_FIELD_CLASS;
+        if (strcmp(cached->type, fresh.type) != 0) changed |= WINDOW_FIELD_TYPE;
+        if (cached->pid != fresh.pid) changed |= WINDOW_FIELD_PID;
+        if (cached->desktop != fresh.desktop) changed |= WINDOW_FIELD_DESKTOP;
+        if (cached->state != fresh.state) changed |= WINDOW_FIELD_STATE;
+
+        if (changed) {
+            log_trace("Cached properties of 0x%lx changed (fields 0x%x)", updates[i].id, changed);
+            *cached = fresh;
+            changed_windows++;
+        }
+        updates[i].fields = changed;
+    }
+
+    free(cookies);
+    free(indices);
+    return changed_windows;
+}
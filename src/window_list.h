@@ -1,13 +1,72 @@
 #ifndef WINDOW_LIST_H
 #define WINDOW_LIST_H
 
+#include <X11/Xlib.h>
+#include <stdbool.h>
+#include "types.h"
+#include "atom_cache.h"
+
 // Forward declaration (avoid duplicate typedef)
 #ifndef APPDATA_TYPEDEF_DEFINED
 #define APPDATA_TYPEDEF_DEFINED
 typedef struct AppData AppData;
 #endif
 
+// Counters for the most recent get_window_list()/update_window_list() call
+typedef struct {
+    int windows_requested;  // client windows whose properties were fetched
+    int requests_sent;      // X requests issued (client list + per-window batch)
+    int round_trips;        // blocking waits on the X server
+} WindowListStats;
+
+// Changes applied by update_window_list(). The arrays grow as needed and
+// are reused across calls, so keep one delta around (zero-initialized).
+typedef struct {
+    int *added;                   // indices into app->windows of new windows
+    int added_count;
+    int added_capacity;
+    Window *removed;              // IDs that left _NET_CLIENT_LIST
+    int removed_count;
+    int removed_capacity;
+    bool order_changed;           // kept windows were reordered
+} WindowListDelta;
+
+// Cached window properties, refreshed field by field on PropertyNotify
+typedef enum {
+    WINDOW_FIELD_TITLE   = 1 << 0,  // _NET_WM_NAME / WM_NAME
+    WINDOW_FIELD_CLASS   = 1 << 1,  // WM_CLASS
+    WINDOW_FIELD_TYPE    = 1 << 2,  // _NET_WM_WINDOW_TYPE
+    WINDOW_FIELD_PID     = 1 << 3,  // _NET_WM_PID
+    WINDOW_FIELD_DESKTOP = 1 << 4,  // _NET_WM_DESKTOP
+    WINDOW_FIELD_STATE   = 1 << 5,  // _NET_WM_STATE
+    WINDOW_FIELD_ALL     = (1 << 6) - 1
+} WindowField;
+
+// Fields to refetch for one window
+typedef struct {
+    Window id;
+    unsigned int fields;  // WindowField mask
+} WindowPropertyUpdate;
+
 // Get list of all windows using _NET_CLIENT_LIST
 void get_window_list(AppData *app);
 
-#endif // WINDOW_LIST_H
\ No newline at end of file
+// Bring app->windows up to date with _NET_CLIENT_LIST, fetching properties
+// only for windows that appeared since the last call
+void update_window_list(AppData *app, WindowListDelta *delta);
+
+// Index of a window in app->windows (-1 when unknown), via app->windows_by_id
+int find_window_index(const AppData *app, Window id);
+
+// Refetch the given fields of windows in app->windows (one round trip for
+// the whole batch). updates[i].fields is rewritten to the fields that
+// actually changed; returns the number of windows with any change.
+int refresh_window_properties(AppData *app, WindowPropertyUpdate *updates, int count);
+
+// Field invalidated by a PropertyNotify on a client window (0 = not cached)
+unsigned int window_field_for_atom(const AtomCache *atoms, Atom atom);
+
+// Statistics of the last acquisition (round trips do not grow with window count)
+const WindowListStats *get_window_list_stats(void);
+
+#endif // WINDOW_LIST_H
@@ -0,0 +1,133 @@
+#include "window_registry.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+
+#define MIN_CAPACITY 16
+
+// Fibonacci hashing: window IDs are clustered per client (base | small
+// counter), so spread the low bits before masking
+static inline int bucket_for(Window id, int mask) {
+    uint64_t h = (uint64_t)id * UINT64_C(11400714819323198485);
+    return (int)((h ^ (h >> 32)) & (uint64_t)mask);
+}
+
+void window_registry_init(WindowRegistry *registry) {
+    memset(registry, 0, sizeof(*registry));
+}
+
+void window_registry_free(WindowRegistry *registry) {
+    free(registry->keys);
+    free(registry->values);
+    window_registry_init(registry);
+}
+
+void window_registry_clear(WindowRegistry *registry) {
+    if (registry->capacity > 0) {
+        memset(registry->keys, 0, sizeof(Window) * (size_t)registry->capacity);
+    }
+    registry->count = 0;
+}
+
+int window_registry_get(const WindowRegistry *registry, Window id) {
+    if (id == 0 || registry->count == 0) return -1;
+
+    int mask = registry->capacity - 1;
+    for (int i = bucket_for(id, mask); registry->keys[i] != 0; i = (i + 1) & mask) {
+        if (registry->keys[i] == id) {
+            return registry->values[i];
+        }
+    }
+    return -1;
+}
+
+// Insert into a table known to have room and not to contain id
+static void insert_new(Window *keys, int *values, int mask, Window id, int value) {
+    int i = bucket_for(id, mask);
+    while (keys[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    keys[i] = id;
+    values[i] = value;
+}
+
+// Keep the load factor at or below 1/2 so probe runs stay short
+static bool reserve(WindowRegistry *registry, int needed) {
+    if (needed * 2 <= registry->capacity) return true;
+
+    int capacity = registry->capacity > 0 ? registry->capacity : MIN_CAPACITY;
+    while (needed * 2 > capacity) {
+        capacity *= 2;
+    }
+
+    Window *keys = calloc((size_t)capacity, sizeof(Window));
+    int *values = malloc(sizeof(int) * (size_t)capacity);
+    if (!keys || !values) {
+        log_error("Failed to grow window registry to %d buckets", capacity);
+        free(keys);
+        free(values);
+        return false;
+    }
+
+    for (int i = 0; i < registry->capacity; i++) {
+        if (registry->keys[i] != 0) {
+            insert_new(keys, values, capacity - 1, registry->keys[i], registry->values[i]);
+        }
+    }
+
+    free(registry->keys);
+    free(registry->values);
+    registry->keys = keys;
+    registry->values = values;
+    registry->capacity = capacity;
+    return true;
+}
+
+bool window_registry_put(WindowRegistry *registry, Window id, int value) {
+    if (id == 0) return false;
+
+    if (registry->count > 0) {
+        int mask = registry->capacity - 1;
+        for (int i = bucket_for(id, mask); registry->keys[i] != 0; i = (i + 1) & mask) {
+            if (registry->keys[i] == id) {
+                registry->values[i] = value;
+                return true;
+            }
+        }
+    }
+
+    if (!reserve(registry, registry->count + 1)) return false;
+    insert_new(registry->keys, registry->values, registry->capacity - 1, id, value);
+    registry->count++;
+    return true;
+}
+
+bool window_registry_remove(WindowRegistry *registry, Window id) {
+    if (id == 0 || registry->count == 0) return false;
+
+    int mask = registry->capacity - 1;
+    int hole = bucket_for(id, mask);
+    while (registry->keys[hole] != id) {
+        if (registry->keys[hole] == 0) return false;
+        hole = (hole + 1) & mask;
+    }
+
+    // Backward shift: pull later members of the probe run into the hole
+    // unless their home bucket lies cyclically after the hole
+    for (int i = (hole + 1) & mask; registry->keys[i] != 0; i = (i + 1) & mask) {
+        int home = bucket_for(registry->keys[i], mask);
+        bool movable = hole <= i ? (home <= hole || home > i)
+                                 : (home <= hole && home > i);
+        if (movable) {
+            registry->keys[hole] = registry->keys[i];
+            registry->values[hole] = registry->values[i];
+            hole = i;
+        }
+    }
+    registry->keys[hole] = 0;
+    registry->count--;
+    return true;
+}
@@ -0,0 +1,42 @@
+#ifndef WINDOW_REGISTRY_H
+#define WINDOW_REGISTRY_H
+
+#include <X11/Xlib.h>
+#include <stdbool.h>
+
+// Hash map from X window ID to a handle (an index into the owner's array).
+// Open addressing with linear probing; deletions shift entries back, so
+// lookups never walk tombstones. The owner keeps handles in sync when it
+// moves entries (e.g. swap-remove). A zeroed registry is valid and empty;
+// buckets are allocated on the first insert.
+typedef struct {
+    Window *keys;       // 0 = empty bucket (X never hands out window 0)
+    int *values;
+    int capacity;       // Power of two (0 until the first insert)
+    int count;
+} WindowRegistry;
+
+// Reset to empty without freeing (for freshly declared structs)
+void window_registry_init(WindowRegistry *registry);
+
+// Release the buckets; the registry stays usable
+void window_registry_free(WindowRegistry *registry);
+
+// Remove all entries, keeping the buckets for reuse
+void window_registry_clear(WindowRegistry *registry);
+
+// Handle stored for id, or -1 when absent
+int window_registry_get(const WindowRegistry *registry, Window id);
+
+// Insert or overwrite (value >= 0); false when id is 0 or the table could
+// not grow
+bool window_registry_put(WindowRegistry *registry, Window id, int value);
+
+// Returns true if id was present
+bool window_registry_remove(WindowRegistry *registry, Window id);
+
+static inline bool window_registry_contains(const WindowRegistry *registry, Window id) {
+    return window_registry_get(registry, id) >= 0;
+}
+
+#endif // WINDOW_REGISTRY_H
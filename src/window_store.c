@@ -0,0 +1,50 @@
+#include "window_store.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "app_data.h"
+#include "log.h"
+
+bool grow_array(void **items, int *capacity, int needed, size_t item_size) {
+    if (needed <= *capacity) return true;
+
+    int grown = *capacity > 0 ? *capacity : WINDOW_STORE_MIN_CAPACITY;
+    while (grown < needed) {
+        if (grown > INT_MAX / 2) {
+            grown = needed;
+            break;
+        }
+        grown *= 2;
+    }
+
+    void *resized = realloc(*items, item_size * (size_t)grown);
+    if (!resized) {
+        log_error("Failed to grow table to %d entries", grown);
+        return false;
+    }
+    *items = resized;
+    *capacity = grown;
+    return true;
+}
+
+bool ensure_window_capacity(AppData *app, int needed) {
+    if (needed <= app->window_capacity) return true;
+
+    // Each array grows from the shared capacity; the shared value only
+    // moves once all of them have room
+    int windows_capacity = app->window_capacity;
+    int history_capacity = app->window_capacity;
+    int filtered_capacity = app->window_capacity;
+    int to_move_capacity = app->window_capacity;
+    if (!GROW_ARRAY(app->windows, windows_capacity, needed) ||
+        !GROW_ARRAY(app->history, history_capacity, needed) ||
+        !GROW_ARRAY(app->filtered, filtered_capacity, needed) ||
+        !GROW_ARRAY(app->windows_to_move, to_move_capacity, needed)) {
+        return false;
+    }
+
+    app->window_capacity = windows_capacity;
+    log_debug("Window store grown to %d windows", app->window_capacity);
+    return true;
+}
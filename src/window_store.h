@@ -0,0 +1,29 @@
+#ifndef WINDOW_STORE_H
+#define WINDOW_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Forward declaration (avoid duplicate typedef)
+#ifndef APPDATA_TYPEDEF_DEFINED
+#define APPDATA_TYPEDEF_DEFINED
+typedef struct AppData AppData;
+#endif
+
+// First allocation for per-window tables
+#define WINDOW_STORE_MIN_CAPACITY 64
+
+// Grow *items to hold at least `needed` elements of item_size bytes.
+// Capacity doubles, so filling a table with n entries reallocates
+// O(log n) times; tables never shrink, so steady-state callers (a filter
+// pass per keystroke) do not allocate. On failure *items is untouched.
+bool grow_array(void **items, int *capacity, int needed, size_t item_size);
+
+#define GROW_ARRAY(items, capacity, needed) \
+    grow_array((void **)&(items), &(capacity), (needed), sizeof(*(items)))
+
+// Make app->windows, history, filtered and windows_to_move hold at least
+// `needed` windows (they share app->window_capacity)
+bool ensure_window_capacity(AppData *app, int needed);
+
+#endif // WINDOW_STORE_H
@@ -311,8 +311,18 @@ static void sort_by_column(WindowPosition *windows, int count) {
                   i, windows[i].id, windows[i].x, windows[i].y);
     }
 
+    if (count <= 1) return;
+
+    int *col_indices = malloc(sizeof(int) * (size_t)count);
+    WindowWithCol *tmp = malloc(sizeof(WindowWithCol) * (size_t)count);
+    if (!col_indices || !tmp) {
+        log_error("Failed to allocate column sort for %d windows, keeping X order", count);
+        free(col_indices);
+        free(tmp);
+        return;
+    }
+
     // Phase 2: assign column indices based on X gaps
-    int col_indices[MAX_WINDOWS];
     assign_column_indices(windows, col_indices, count);
 
     for (int i = 0; i < count; i++) {
@@ -321,13 +331,15 @@ static void sort_by_column(WindowPosition *windows, int count) {
     }
 
     // Phase 3: sort by (col, y)
-    WindowWithCol tmp[MAX_WINDOWS];
     for (int i = 0; i < count; i++) {
         tmp[i].pos = windows[i];
         tmp[i].col = col_indices[i];
     }
     qsort(tmp, count, sizeof(WindowWithCol), compare_by_col_then_y);
     for (int i = 0; i < count; i++) windows[i] = tmp[i].pos;
+
+    free(col_indices);
+    free(tmp);
 }
 
 void init_workspace_slots(WorkspaceSlotManager *manager) {
@@ -351,8 +363,17 @@ void assign_workspace_slots(AppData *app) {
     manager->count = 0;
     manager->workspace = current_desktop;
 
-    // Collect all candidate windows with geometry
-    WindowPosition candidates[MAX_WINDOWS];
+    // Collect all candidate windows with geometry (both tables hold at
+    // most one entry per known window)
+    int max_windows = app->window_count > 0 ? app->window_count : 1;
+    WindowPosition *candidates = malloc(sizeof(WindowPosition) * (size_t)max_windows);
+    WindowPosition *visible = malloc(sizeof(WindowPosition) * (size_t)max_windows);
+    if (!candidates || !visible) {
+        log_error("Failed to allocate slot candidates for %d windows", max_windows);
+        free(candidates);
+        free(visible);
+        return;
+    }
     int cand_count = 0;
 
     for (int i = 0; i < app->window_count; i++) {
@@ -361,8 +382,7 @@ void assign_workspace_slots(AppData *app) {
         if (win->desktop == -1 && strcmp(win->type, "Normal") != 0) continue;
         if (win->desktop != current_desktop && win->desktop != -1) continue;
         if (win->id == app->own_window_id) continue;
-        if (get_window_state(app->display, win->id, "_NET_WM_STATE_HIDDEN")) continue;
-        if (get_window_state(app->display, win->id, "_NET_WM_STATE_SHADED")) continue;
+        if (win->state & (WINDOW_STATE_FLAG_HIDDEN | WINDOW_STATE_FLAG_SHADED)) continue;
 
         int x, y, w, h;
         if (!get_window_geometry(app->display, win->id, &x, &y, &w, &h)) continue;
@@ -386,7 +406,6 @@ void assign_workspace_slots(AppData *app) {
     unsigned long stack_count = 0;
     Window *stack = get_stacking_order(app->display, &stack_count);
 
-    WindowPosition visible[MAX_WINDOWS];
     int vis_count = 0;
 
     for (int i = 0; i < cand_count; i++) {
@@ -446,6 +465,8 @@ void assign_workspace_slots(AppData *app) {
                  i + 1, visible[i].id, visible[i].x, visible[i].y);
     }
     manager->count = assigned_count;
+    free(candidates);
+    free(visible);
 
     // Auto-switch to per-workspace mode when slots are assigned
     if (app->config.digit_slot_mode != DIGIT_MODE_PER_WORKSPACE) {
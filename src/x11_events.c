@@ -18,6 +18,10 @@
 #include "command_api.h"
 #include "window_matcher.h"
 #include "utils.h"
+#include "warm_show.h"
+#include "title_throttle.h"
+#include "window_registry.h"
+#include "window_store.h"
 
 static GIOChannel *x11_channel = NULL;
 static guint x11_watch_id = 0;
@@ -60,107 +64,405 @@ void update_current_workspace(AppData *app) {
     }
 }
 
-// Track which windows we've subscribed to PropertyNotify
-static Window subscribed_windows[MAX_WINDOWS];
-static int subscribed_count = 0;
+// Per-window title refetch throttle (terminals, players, progress titles)
+static TitleThrottle title_throttle;
+static guint title_timer_id = 0;
+static Window *due_titles = NULL;  // Scratch for titles leaving the throttle
+static int due_titles_capacity = 0;
+
+// Property changes seen during the current event drain, merged per window
+static WindowPropertyUpdate *pending_updates = NULL;
+static int pending_update_capacity = 0;
+static int pending_update_count = 0;
+static WindowRegistry pending_update_index;  // Window ID -> index in pending_updates
+
+static void queue_property_update(Window id, unsigned int field) {
+    int index = window_registry_get(&pending_update_index, id);
+    if (index >= 0) {
+        pending_updates[index].fields |= field;
+        return;
+    }
+    if (GROW_ARRAY(pending_updates, pending_update_capacity, pending_update_count + 1)) {
+        pending_updates[pending_update_count].id = id;
+        pending_updates[pending_update_count].fields = field;
+        window_registry_put(&pending_update_index, id, pending_update_count);
+        pending_update_count++;
+    }
+}
 
-static int is_subscribed(Window id) {
-    for (int i = 0; i < subscribed_count; i++) {
-        if (subscribed_windows[i] == id) return 1;
+// Windows we've subscribed to PropertyNotify on (set; values unused)
+static WindowRegistry subscribed_windows;
+
+// Subscribe to PropertyNotify on one window (for title change detection)
+static void subscribe_window(AppData *app, Window w) {
+    if (!window_registry_contains(&subscribed_windows, w)) {
+        XWindowAttributes attrs;
+        if (XGetWindowAttributes(app->display, w, &attrs)) {
+            XSelectInput(app->display, w, attrs.your_event_mask | PropertyChangeMask);
+            window_registry_put(&subscribed_windows, w, 0);
+            log_trace("Subscribed to PropertyNotify on 0x%lx", w);
+        }
     }
-    return 0;
 }
 
-// Subscribe to PropertyNotify on all current windows (for title change detection)
+// Subscribe to PropertyNotify on all current windows, queueing a refetch
+// of each (their properties were fetched before the subscription)
 static void subscribe_to_window_properties(AppData *app) {
     for (int i = 0; i < app->window_count; i++) {
-        Window w = app->windows[i].id;
-        if (!is_subscribed(w) && subscribed_count < MAX_WINDOWS) {
-            XWindowAttributes attrs;
-            if (XGetWindowAttributes(app->display, w, &attrs)) {
-                XSelectInput(app->display, w, attrs.your_event_mask | PropertyChangeMask);
-                subscribed_windows[subscribed_count++] = w;
-                log_trace("Subscribed to PropertyNotify on 0x%lx", w);
-            }
-        }
+        subscribe_window(app, app->windows[i].id);
+        queue_property_update(app->windows[i].id, WINDOW_FIELD_ALL);
     }
 }
 
-// Prune subscribed windows that no longer exist in the window list
-static void prune_subscribed_windows(AppData *app) {
-    int write = 0;
-    for (int i = 0; i < subscribed_count; i++) {
-        int found = 0;
-        for (int j = 0; j < app->window_count; j++) {
-            if (app->windows[j].id == subscribed_windows[i]) {
-                found = 1;
-                break;
-            }
-        }
-        if (found) {
-            subscribed_windows[write++] = subscribed_windows[i];
-        } else {
-            rule_state_remove_window(&app->rule_state, subscribed_windows[i]);
+// Apply rules to one window (checks state machine — only fires on transitions)
+static void apply_rules_to_window(AppData *app, WindowInfo *w) {
+    for (int r = 0; r < app->rules_config.count; r++) {
+        RuleMatch match = check_rule_match(
+            &app->rules_config.rules[r], &app->rule_state, w->id, w->title);
+        if (match.should_fire) {
+            log_info("RULE: '%s' matched window 0x%lx '%s' — executing: %s",
+                     app->rules_config.rules[r].pattern, w->id, w->title, match.commands);
+            execute_command_background(match.commands, app, w);
         }
     }
-    subscribed_count = write;
 }
 
-// Apply rules to all windows (checks state machine — only fires on transitions)
+// Apply rules to all windows
 static void apply_rules_to_windows(AppData *app) {
     if (app->rules_config.count == 0) return;
 
     for (int i = 0; i < app->window_count; i++) {
-        WindowInfo *w = &app->windows[i];
-        for (int r = 0; r < app->rules_config.count; r++) {
-            RuleMatch match = check_rule_match(
-                &app->rules_config.rules[r], &app->rule_state, w->id, w->title);
-            if (match.should_fire) {
-                log_info("RULE: '%s' matched window 0x%lx '%s' — executing: %s",
-                         app->rules_config.rules[r].pattern, w->id, w->title, match.commands);
-                execute_command_background(match.commands, app, w);
-            }
-        }
+        apply_rules_to_window(app, &app->windows[i]);
+    }
+}
+
+// Drop subscription and rule state for windows that left the client list
+static void forget_removed_windows(AppData *app, const WindowListDelta *delta) {
+    for (int r = 0; r < delta->removed_count; r++) {
+        Window id = delta->removed[r];
+        window_registry_remove(&subscribed_windows, id);
+        rule_state_remove_window(&app->rule_state, id);
+        title_throttle_forget(&title_throttle, id);
     }
 }
 
-// Handle title change on a specific window
-static void handle_window_title_change(AppData *app, Window id) {
+// Subscribe to PropertyNotify on windows that just appeared. Their
+// properties were fetched before the subscription, so a change in between
+// sent no event; queue a refetch to pick it up
+static void subscribe_to_added_windows(AppData *app, const WindowListDelta *delta) {
+    for (int i = 0; i < delta->added_count; i++) {
+        Window id = app->windows[delta->added[i]].id;
+        subscribe_window(app, id);
+        queue_property_update(id, WINDOW_FIELD_ALL);
+    }
+}
+
+// Apply rules to windows that just appeared; existing windows only change
+// match state through title changes (handle_window_title_change)
+static void apply_rules_to_added_windows(AppData *app, const WindowListDelta *delta) {
+    for (int i = 0; i < delta->added_count; i++) {
+        apply_rules_to_window(app, &app->windows[delta->added[i]]);
+    }
+}
+
+// Title of a cached window changed: re-check rules against the new title
+static void handle_window_title_change(AppData *app, WindowInfo *w) {
     if (app->rules_config.count == 0) return;
 
-    // Find the window in our list
-    WindowInfo *w = NULL;
-    for (int i = 0; i < app->window_count; i++) {
-        if (app->windows[i].id == id) {
-            w = &app->windows[i];
-            break;
+    log_trace("Title changed for 0x%lx: '%s'", w->id, w->title);
+    apply_rules_to_window(app, w);
+}
+
+// Re-apply the current filter to the window list and redraw if visible.
+// While hidden, only the warm show list is rebuilt (on idle)
+static void refilter_windows(AppData *app) {
+    if (!app->window_visible) {
+        warm_show_invalidate(app);
+        return;
+    }
+
+    // Only process if window still exists and is valid
+    if (app->window && GTK_IS_WIDGET(app->window) &&
+        app->entry && GTK_IS_ENTRY(app->entry)) {
+        // Skip filtering when in command mode
+        if (app->command_mode.state != CMD_MODE_NORMAL) {
+            // In command mode, don't apply entry text as filter
+            filter_windows(app, "");
+        } else {
+            // Get current filter text
+            const char *filter_text = gtk_entry_get_text(GTK_ENTRY(app->entry));
+
+            // Re-apply filter
+            filter_windows(app, filter_text);
         }
+    } else {
+        // Window destroyed or invalid, just update with empty filter
+        filter_windows(app, "");
     }
-    if (!w) return;
 
-    // Re-fetch its title using same approach as window_list.c
-    char *new_title = get_window_property(app->display, id, app->atoms.net_wm_name);
-    if (!new_title) {
-        new_title = get_window_property(app->display, id, XA_WM_NAME);
+    // Update display only if window exists and is visible
+    if (app->window && GTK_IS_WIDGET(app->window) &&
+        gtk_widget_get_visible(app->window)) {
+        update_display(app);
     }
-    if (!new_title) return;
+}
 
-    if (strcmp(w->title, new_title) != 0) {
-        log_trace("Title changed for 0x%lx: '%s' -> '%s'", id, w->title, new_title);
-        safe_string_copy(w->title, new_title, MAX_TITLE_LEN);
+// Refetch all properties queued during this batch in one round trip and
+// update the cached WindowInfo entries field by field. Returns the number
+// of windows that changed.
+static int flush_property_updates(AppData *app) {
+    if (pending_update_count == 0) return 0;
 
-        // Check rules against updated title
-        for (int r = 0; r < app->rules_config.count; r++) {
-            RuleMatch match = check_rule_match(
-                &app->rules_config.rules[r], &app->rule_state, id, w->title);
-            if (match.should_fire) {
-                log_info("RULE: '%s' matched window 0x%lx '%s' — executing: %s",
-                         app->rules_config.rules[r].pattern, id, w->title, match.commands);
-                execute_command_background(match.commands, app, w);
-            }
+    int count = pending_update_count;
+    pending_update_count = 0;
+    window_registry_clear(&pending_update_index);
+
+    int changed = refresh_window_properties(app, pending_updates, count);
+    if (changed == 0) return 0;
+
+    for (int i = 0; i < count; i++) {
+        if (!(pending_updates[i].fields & WINDOW_FIELD_TITLE)) continue;
+        int index = find_window_index(app, pending_updates[i].id);
+        if (index >= 0) {
+            handle_window_title_change(app, &app->windows[index]);
+        }
+    }
+
+    return changed;
+}
+
+// _NET_CLIENT_LIST changed: diff against the known windows (only added ones
+// are fetched) and carry harpoon slots, names and rules over. Returns TRUE
+// when the window list changed.
+static gboolean apply_client_list_change(AppData *app) {
+    log_debug("_NET_CLIENT_LIST changed - updating window list");
+
+    int old_count = app->window_count;
+    static WindowListDelta delta;
+    update_window_list(app, &delta);
+    log_trace("Window count changed from %d to %d (+%d -%d)",
+             old_count, app->window_count, delta.added_count, delta.removed_count);
+
+    if (delta.added_count == 0 && delta.removed_count == 0 && !delta.order_changed) {
+        log_trace("_NET_CLIENT_LIST unchanged, nothing to refresh");
+        return FALSE;
+    }
+
+    // Log added windows for debugging
+    for (int i = 0; i < delta.added_count; i++) {
+        WindowInfo *w = &app->windows[delta.added[i]];
+        log_trace("Added window 0x%lx '%s' (%s)", w->id, w->title, w->class_name);
+    }
+
+    // Check for automatic reassignments
+    log_trace("Calling check_and_reassign_windows_delta()");
+    bool harpoon_changed = check_and_reassign_windows_delta(&app->harpoon, app->windows,
+                                                            app->window_count, &delta);
+    if (harpoon_changed) {
+        save_harpoon_slots(&app->harpoon);
+        log_debug("Saved reassigned harpoon slots after window list change");
+    }
+
+    // Check for named windows reassignments
+    log_trace("Calling check_and_reassign_names_delta()");
+    bool names_changed = check_and_reassign_names_delta(&app->names, app->windows,
+                                                        app->window_count, &delta);
+    if (names_changed) {
+        save_named_windows(&app->names);
+        log_debug("Saved reassigned named windows after window list change");
+    }
+
+    // Subscribe/unsubscribe and apply rules for the delta only
+    forget_removed_windows(app, &delta);
+    subscribe_to_added_windows(app, &delta);
+    apply_rules_to_added_windows(app, &delta);
+    return TRUE;
+}
+
+static void apply_current_desktop_change(AppData *app) {
+    log_debug("_NET_CURRENT_DESKTOP changed - updating current workspace");
+    // Only cancel ripple on external workspace switches — cofi-initiated
+    // switches (WS_SWITCH_SUPPRESS) already have a fresh ripple in flight
+    if (ws_switch_state != WS_SWITCH_SUPPRESS) {
+        destroy_highlight(app);
+    }
+    update_current_workspace(app);
+
+    // Set flag for highlight on next active window change
+    if (ws_switch_state != WS_SWITCH_SUPPRESS) {
+        ws_switch_state = WS_SWITCH_HIGHLIGHT;
+    }
+    if (workspace_switch_timer > 0) {
+        g_source_remove(workspace_switch_timer);
+    }
+    workspace_switch_timer = g_timeout_add(200, workspace_switch_timeout, app);
+}
+
+static void apply_active_window_change(AppData *app) {
+    log_trace("_NET_ACTIVE_WINDOW changed - updating active window");
+
+    // Update active window ID
+    Window new_active_id = get_active_window_id(app->display);
+    app->active_window_id = (int)new_active_id;
+
+    // Highlight active window after workspace switch
+    if (ws_switch_state != WS_SWITCH_NONE && new_active_id &&
+        new_active_id != (Window)app->own_window_id) {
+        WorkspaceSwitchState state = ws_switch_state;
+        ws_switch_state = WS_SWITCH_NONE;
+        if (workspace_switch_timer > 0) {
+            g_source_remove(workspace_switch_timer);
+            workspace_switch_timer = 0;
         }
+        if (state == WS_SWITCH_HIGHLIGHT) {
+            highlight_window(app, new_active_id);
+        }
+        // WS_SWITCH_SUPPRESS: cofi already called highlight_window
+    }
+
+    // We don't need to refresh the whole list, just update history
+    // This will be handled by the next filter operation
+}
+
+// Root window changes seen since the last refresh, applied together by
+// refresh_after_events() so a burst of events costs one refresh
+enum {
+    X11_DIRTY_CLIENT_LIST     = 1 << 0,
+    X11_DIRTY_ACTIVE_WINDOW   = 1 << 1,
+    X11_DIRTY_CURRENT_DESKTOP = 1 << 2,
+    X11_DIRTY_STACKING        = 1 << 3,
+};
+
+static unsigned int dirty_flags = 0;
+static int batch_events = 0;            // Dirtying events since the last refresh
+static guint refresh_idle_id = 0;
+static X11EventStats event_stats = {0};
+
+static void mark_dirty(unsigned int flags) {
+    dirty_flags |= flags;
+    batch_events++;
+}
+
+X11EventStats get_x11_event_stats(void) {
+    return event_stats;
+}
+
+// Apply everything marked dirty since the last refresh: list diff, property
+// refetch, workspace and active window updates, then at most one refilter
+// or redraw
+static void refresh_after_events(AppData *app) {
+    if (refresh_idle_id > 0) {
+        g_source_remove(refresh_idle_id);
+        refresh_idle_id = 0;
+    }
+    if (dirty_flags == 0 && pending_update_count == 0) {
+        return;
+    }
+
+    unsigned int dirty = dirty_flags;
+    int events = batch_events;
+    dirty_flags = 0;
+    batch_events = 0;
+
+    gboolean list_changed = FALSE;
+    if (dirty & X11_DIRTY_CLIENT_LIST) {
+        list_changed = apply_client_list_change(app);
+    }
+    if (flush_property_updates(app) > 0) {
+        list_changed = TRUE;
+    }
+    if (dirty & X11_DIRTY_CURRENT_DESKTOP) {
+        apply_current_desktop_change(app);
     }
-    g_free(new_title);
+    if (dirty & X11_DIRTY_ACTIVE_WINDOW) {
+        apply_active_window_change(app);
+    }
+
+    gboolean refreshed = TRUE;
+    if (list_changed) {
+        refilter_windows(app);
+    } else if ((dirty & X11_DIRTY_CURRENT_DESKTOP) && app->window_visible) {
+        update_display(app);
+    } else if (dirty && !app->window_visible) {
+        // Active window and stacking order only affect the next show
+        warm_show_invalidate(app);
+    } else {
+        refreshed = FALSE;
+    }
+
+    event_stats.events += events;
+    event_stats.batches++;
+    if (refreshed) {
+        event_stats.refreshes++;
+    }
+    int avoided = refreshed ? events - 1 : events;
+    if (avoided > 0) {
+        event_stats.refreshes_avoided += avoided;
+        log_debug("Coalesced %d X events, %d refreshes avoided (%lu so far)",
+                  events, avoided, event_stats.refreshes_avoided);
+    }
+}
+
+static gboolean refresh_after_events_idle(gpointer data) {
+    AppData *app = (AppData *)data;
+    refresh_idle_id = 0;
+    refresh_after_events(app);
+    return FALSE;
+}
+
+static void schedule_deferred_titles(AppData *app);
+
+// Trailing edge of the title throttle: refetch the final title of every
+// window whose interval has ended
+static gboolean deliver_deferred_titles(gpointer data) {
+    AppData *app = (AppData *)data;
+    title_timer_id = 0;
+
+    int n = 0;
+    if (GROW_ARRAY(due_titles, due_titles_capacity, title_throttle.count)) {
+        n = title_throttle_collect_due(&title_throttle, g_get_monotonic_time(),
+                                       due_titles, due_titles_capacity);
+    }
+    for (int i = 0; i < n; i++) {
+        queue_property_update(due_titles[i], WINDOW_FIELD_TITLE);
+        batch_events++;
+    }
+    refresh_after_events(app);
+
+    schedule_deferred_titles(app);
+    return FALSE;
+}
+
+static void schedule_deferred_titles(AppData *app) {
+    if (title_timer_id > 0) return;
+
+    gint64 due = title_throttle_next_due(&title_throttle);
+    if (due == 0) return;
+
+    gint64 wait_us = due - g_get_monotonic_time();
+    guint wait_ms = wait_us > 0 ? (guint)((wait_us + 999) / 1000) : 0;
+    title_timer_id = g_timeout_add(wait_ms, deliver_deferred_titles, app);
+}
+
+int get_title_update_stats(TitleThrottleEntry *out, int max_out) {
+    return title_throttle_stats(&title_throttle, out, max_out);
+}
+
+// Read every queued X event, only recording what changed
+static void read_x11_events(AppData *app) {
+    Display *display = app->display;
+
+    while (XPending(display) > 0) {
+        XEvent event;
+        XNextEvent(display, &event);
+        handle_x11_event(app, &event);
+    }
+}
+
+static gboolean event_monitoring_active = FALSE;
+
+gboolean x11_event_monitoring_active(void) {
+    return event_monitoring_active;
 }
 
 void setup_x11_event_monitoring(AppData *app) {
@@ -177,9 +479,17 @@ void setup_x11_event_monitoring(AppData *app) {
     // Add watch for X11 events
     x11_watch_id = g_io_add_watch(x11_channel, G_IO_IN, process_x11_events, app);
 
-    // Subscribe to property changes on existing windows (for title change rules)
+    // Subscribe to property changes on existing windows (keeps the cached
+    // window properties current and drives title change rules)
     subscribe_to_window_properties(app);
+
+    // The startup list was fetched before these subscriptions; anything
+    // that changed in between sent no event
+    if (flush_property_updates(app) > 0) {
+        refilter_windows(app);
+    }
     apply_rules_to_windows(app);
+    event_monitoring_active = TRUE;
 
     log_debug("X11 event monitoring setup complete");
 }
@@ -194,6 +504,24 @@ void cleanup_x11_event_monitoring(void) {
         g_io_channel_unref(x11_channel);
         x11_channel = NULL;
     }
+
+    if (refresh_idle_id > 0) {
+        g_source_remove(refresh_idle_id);
+        refresh_idle_id = 0;
+    }
+
+    if (title_timer_id > 0) {
+        g_source_remove(title_timer_id);
+        title_timer_id = 0;
+    }
+    cleanup_title_throttle(&title_throttle);
+    window_registry_free(&subscribed_windows);
+
+    event_monitoring_active = FALSE;
+    pending_update_count = 0;
+    window_registry_free(&pending_update_index);
+    dirty_flags = 0;
+    batch_events = 0;
     
     log_debug("X11 event monitoring cleaned up");
 }
@@ -203,141 +531,81 @@ gboolean process_x11_events(GIOChannel *source, GIOCondition condition, gpointer
     (void)condition;  // Unused
     
     AppData *app = (AppData *)data;
-    Display *display = app->display;
-    
-    // Process all pending X11 events
-    while (XPending(display) > 0) {
-        XEvent event;
-        XNextEvent(display, &event);
-        handle_x11_event(app, &event);
+    read_x11_events(app);
+    schedule_deferred_titles(app);
+
+    // Refresh once the current burst has been read: the idle runs after
+    // pending X input (default priority) and before GTK resizes and redraws,
+    // so every frame sees at most one refresh
+    if ((dirty_flags != 0 || pending_update_count > 0) && refresh_idle_id == 0) {
+        refresh_idle_id = g_idle_add_full(G_PRIORITY_HIGH_IDLE, refresh_after_events_idle,
+                                          app, NULL);
     }
     
     // Keep the event source active
     return TRUE;
 }
 
+void drain_x11_events(AppData *app) {
+    read_x11_events(app);
+
+    // Titles held back by the throttle are due now: the caller wants
+    // the current state
+    int n = 0;
+    if (GROW_ARRAY(due_titles, due_titles_capacity, title_throttle.count)) {
+        n = title_throttle_collect_all(&title_throttle, g_get_monotonic_time(),
+                                       due_titles, due_titles_capacity);
+    }
+    for (int i = 0; i < n; i++) {
+        queue_property_update(due_titles[i], WINDOW_FIELD_TITLE);
+        batch_events++;
+    }
+    if (title_timer_id > 0) {
+        g_source_remove(title_timer_id);
+        title_timer_id = 0;
+    }
+
+    refresh_after_events(app);
+}
+
 void handle_x11_event(AppData *app, XEvent *event) {
     switch (event->type) {
         case PropertyNotify: {
             XPropertyEvent *prop_event = &event->xproperty;
             Window root = DefaultRootWindow(app->display);
 
-            // Handle per-window title changes (for rules)
+            // Per-window property changes: queue a refetch of the changed
+            // field, flushed as one batch with the other changes
             if (prop_event->window != root) {
-                if (prop_event->atom == app->atoms.net_wm_name ||
-                    prop_event->atom == XA_WM_NAME) {
-                    handle_window_title_change(app, prop_event->window);
+                unsigned int field = window_field_for_atom(&app->atoms, prop_event->atom);
+                // Title refetches are throttled per window; a deferred
+                // title is delivered when its interval ends
+                if ((field & WINDOW_FIELD_TITLE) &&
+                    !title_throttle_event(&title_throttle, prop_event->window,
+                                          g_get_monotonic_time())) {
+                    field &= ~WINDOW_FIELD_TITLE;
+                }
+                if (field) {
+                    queue_property_update(prop_event->window, field);
+                    batch_events++;
                 }
                 break;
             }
 
-            // Check which root window property changed
+            // Root window changes only mark what is stale; the refresh runs
+            // once for the whole batch (refresh_after_events)
             if (prop_event->atom == app->atoms.net_client_list) {
-                log_debug("_NET_CLIENT_LIST changed - updating window list");
-                
-                // Get new window list
-                int old_count = app->window_count;
-                get_window_list(app);
-                log_trace("Window count changed from %d to %d", old_count, app->window_count);
-
-                // Log current windows for debugging
-                for (int i = 0; i < app->window_count; i++) {
-                    log_trace("Current window %d: 0x%lx '%s' (%s)",
-                             i, app->windows[i].id, app->windows[i].title, app->windows[i].class_name);
-                }
-
-                // Check for automatic reassignments
-                log_trace("Calling check_and_reassign_windows()");
-                bool harpoon_changed = check_and_reassign_windows(&app->harpoon, app->windows, app->window_count);
-                if (harpoon_changed) {
-                    save_harpoon_slots(&app->harpoon);
-                    log_debug("Saved reassigned harpoon slots after window list change");
-                }
-                
-                // Check for named windows reassignments
-                log_trace("Calling check_and_reassign_names()");
-                bool names_changed = check_and_reassign_names(&app->names, app->windows, app->window_count);
-                if (names_changed) {
-                    save_named_windows(&app->names);
-                    log_debug("Saved reassigned named windows after window list change");
-                }
-
-                // Subscribe to per-window property changes and apply rules
-                prune_subscribed_windows(app);
-                subscribe_to_window_properties(app);
-                apply_rules_to_windows(app);
-
-                // Only process if window still exists and is valid
-                if (app->window && GTK_IS_WIDGET(app->window) &&
-                    app->entry && GTK_IS_ENTRY(app->entry)) {
-                    // Skip filtering when in command mode
-                    if (app->command_mode.state != CMD_MODE_NORMAL) {
-                        // In command mode, don't apply entry text as filter
-                        filter_windows(app, "");
-                    } else {
-                        // Get current filter text
-                        const char *filter_text = gtk_entry_get_text(GTK_ENTRY(app->entry));
-
-                        // Re-apply filter
-                        filter_windows(app, filter_text);
-                    }
-                } else {
-                    // Window destroyed or invalid, just update with empty filter
-                    filter_windows(app, "");
-                }
-                
-                // Update display only if window exists and is visible
-                if (app->window && GTK_IS_WIDGET(app->window) && 
-                    gtk_widget_get_visible(app->window)) {
-                    update_display(app);
-                }
+                mark_dirty(X11_DIRTY_CLIENT_LIST);
             }
             else if (prop_event->atom == app->atoms.net_active_window) {
-                log_trace("_NET_ACTIVE_WINDOW changed - updating active window");
-
-                // Update active window ID
-                Window new_active_id = get_active_window_id(app->display);
-                app->active_window_id = (int)new_active_id;
-
-                // Highlight active window after workspace switch
-                if (ws_switch_state != WS_SWITCH_NONE && new_active_id &&
-                    new_active_id != (Window)app->own_window_id) {
-                    WorkspaceSwitchState state = ws_switch_state;
-                    ws_switch_state = WS_SWITCH_NONE;
-                    if (workspace_switch_timer > 0) {
-                        g_source_remove(workspace_switch_timer);
-                        workspace_switch_timer = 0;
-                    }
-                    if (state == WS_SWITCH_HIGHLIGHT) {
-                        highlight_window(app, new_active_id);
-                    }
-                    // WS_SWITCH_SUPPRESS: cofi already called highlight_window
-                }
-
-                // We don't need to refresh the whole list, just update history
-                // This will be handled by the next filter operation
+                mark_dirty(X11_DIRTY_ACTIVE_WINDOW);
             }
             else if (prop_event->atom == app->atoms.net_current_desktop) {
-                log_debug("_NET_CURRENT_DESKTOP changed - updating current workspace");
-                // Only cancel ripple on external workspace switches — cofi-initiated
-                // switches (WS_SWITCH_SUPPRESS) already have a fresh ripple in flight
-                if (ws_switch_state != WS_SWITCH_SUPPRESS) {
-                    destroy_highlight(app);
-                }
-                update_current_workspace(app);
-
-                // Set flag for highlight on next active window change
-                if (ws_switch_state != WS_SWITCH_SUPPRESS) {
-                    ws_switch_state = WS_SWITCH_HIGHLIGHT;
-                }
-                if (workspace_switch_timer > 0) {
-                    g_source_remove(workspace_switch_timer);
-                }
-                workspace_switch_timer = g_timeout_add(200, workspace_switch_timeout, app);
-
-                if (app->window) {
-                    update_display(app);
-                }
+                mark_dirty(X11_DIRTY_CURRENT_DESKTOP);
+            }
+            else if (prop_event->atom == app->atoms.net_client_list_stacking) {
+                // Stacking order drives the native window order mode
+                mark_dirty(X11_DIRTY_STACKING);
             }
             break;
         }
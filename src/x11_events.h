@@ -3,6 +3,7 @@
 
 #include <X11/Xlib.h>
 #include <glib.h>
+#include "title_throttle.h"
 
 // Forward declaration (avoid duplicate typedef)
 #ifndef APPDATA_TYPEDEF_DEFINED
@@ -10,6 +11,15 @@
 typedef struct AppData AppData;
 #endif
 
+// Coalescing counters: every dirtying event that shared a refresh with
+// another one (or needed none) is a refresh avoided
+typedef struct {
+    unsigned long events;               // Events that marked something stale
+    unsigned long batches;              // Coalesced refresh passes run
+    unsigned long refreshes;            // Passes that refiltered or redrew
+    unsigned long refreshes_avoided;    // events - refreshes
+} X11EventStats;
+
 // Function to update the current workspace
 void update_current_workspace(AppData *app);
 
@@ -19,9 +29,22 @@ void setup_x11_event_monitoring(AppData *app);
 // Cleanup X11 event monitoring
 void cleanup_x11_event_monitoring(void);
 
-// Process X11 events (called by GLib)
+// Process X11 events (called by GLib). Events only mark state dirty; one
+// coalesced refresh runs on idle before the next frame
 gboolean process_x11_events(GIOChannel *source, GIOCondition condition, gpointer data);
 
+// Process every queued X11 event and apply the pending refresh right away
+// (no blocking round trip when nothing changed)
+void drain_x11_events(AppData *app);
+
+X11EventStats get_x11_event_stats(void);
+
+// Per-window title update rates, noisiest first; returns the number copied
+int get_title_update_stats(TitleThrottleEntry *out, int max_out);
+
+// TRUE while PropertyNotify subscriptions keep app->windows current
+gboolean x11_event_monitoring_active(void);
+
 // Handle individual X11 events
 void handle_x11_event(AppData *app, XEvent *event);
 
@@ -50,11 +50,7 @@ run_test() {
 # Compile new unit tests if needed
 echo "Compiling unit tests..."
 if [ -f "test/test_filter.c" ]; then
-    gcc -o test/test_filter test/test_filter.c src/filter.c src/match.c src/log.c $(pkg-config --cflags --libs gtk+-3.0 x11) -lm 2>/dev/null || echo "Warning: Failed to compile test_filter"
-fi
-
-if [ -f "test/test_history.c" ]; then
-    gcc -o test/test_history test/test_history.c src/history.c src/log.c $(pkg-config --cflags --libs gtk+-3.0 x11) -lm 2>/dev/null || echo "Warning: Failed to compile test_history"
+    gcc -o test/test_filter test/test_filter.c src/filter.c src/match.c src/simd_scan.c src/log.c $(pkg-config --cflags --libs gtk+-3.0 x11) -lm 2>/dev/null || echo "Warning: Failed to compile test_filter"
 fi
 
 # Run unit tests
@@ -65,10 +61,6 @@ if [ -f "test/test_filter" ]; then
     run_test "Filter (multi-stage matching)" "test/test_filter"
 fi
 
-if [ -f "test/test_history" ]; then
-    run_test "History (MRU and Alt-Tab)" "test/test_history"
-fi
-
 # Matching algorithm tests
 if [ -f "test/test_fuzzy" ]; then
     run_test "Fuzzy matching" "test/test_fuzzy"
@@ -320,6 +320,206 @@ if [ -f test_filter_ranking ]; then
     fi
 fi
 
+# Run pipelined window-list acquisition tests if they exist
+if [ -f test_window_list_pipeline ]; then
+    echo ""
+    echo "Running window list pipeline tests..."
+    ./test_window_list_pipeline
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run warm show path tests if they exist
+if [ -f test_warm_show ]; then
+    echo ""
+    echo "Running warm show path tests..."
+    ./test_warm_show
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run coalesced X event processing tests if they exist
+if [ -f test_x11_event_coalescing ]; then
+    echo ""
+    echo "Running X event coalescing tests..."
+    ./test_x11_event_coalescing
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run title throttle tests if they exist
+if [ -f test_title_throttle ]; then
+    echo ""
+    echo "Running title throttle tests..."
+    ./test_title_throttle
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run window registry tests if they exist
+if [ -f test_window_registry ]; then
+    echo ""
+    echo "Running window registry tests..."
+    ./test_window_registry
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run window store tests if they exist
+if [ -f test_window_store ]; then
+    echo ""
+    echo "Running window store tests..."
+    ./test_window_store
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run partition benchmark tests if they exist
+if [ -f test_partition_and_reorder ]; then
+    echo ""
+    echo "Running partition benchmark tests..."
+    ./test_partition_and_reorder
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run history tests if they exist
+if [ -f test_history ]; then
+    echo ""
+    echo "Running history tests..."
+    ./test_history
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run search cache tests if they exist
+if [ -f test_search_cache ]; then
+    echo ""
+    echo "Running search cache tests..."
+    ./test_search_cache
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run SIMD prefilter tests if they exist
+if [ -f test_simd_scan ]; then
+    echo ""
+    echo "Running SIMD prefilter tests..."
+    ./test_simd_scan
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run top-k selection tests if they exist
+if [ -f test_top_k ]; then
+    echo ""
+    echo "Running top-k selection tests..."
+    ./test_top_k
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run parallel name scorer tests if they exist
+if [ -f test_name_scorer ]; then
+    echo ""
+    echo "Running parallel name scorer tests..."
+    ./test_name_scorer
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run ranked-match engine tests if they exist
+if [ -f test_rank_match ]; then
+    echo ""
+    echo "Running ranked-match engine tests..."
+    ./test_rank_match
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run extended query syntax tests if they exist
+if [ -f test_query_plan ]; then
+    echo ""
+    echo "Running extended query syntax tests..."
+    ./test_query_plan
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run match highlight tests if they exist
+if [ -f test_match_highlight ]; then
+    echo ""
+    echo "Running match highlight tests..."
+    ./test_match_highlight
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run display line diff tests if they exist
+if [ -f test_line_diff ]; then
+    echo ""
+    echo "Running display line diff tests..."
+    ./test_line_diff
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run results view layout cache tests if they exist
+if [ -f test_layout_cache ]; then
+    echo ""
+    echo "Running results view layout cache tests..."
+    ./test_layout_cache
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run display render fingerprint tests if they exist
+if [ -f test_render_fingerprint ]; then
+    echo ""
+    echo "Running display render fingerprint tests..."
+    ./test_render_fingerprint
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run windows row cache tests if they exist
+if [ -f test_row_cache ]; then
+    echo ""
+    echo "Running windows row cache tests..."
+    ./test_row_cache
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
+# Run display frame scheduling tests if they exist
+if [ -f test_display_frames ]; then
+    echo ""
+    echo "Running display frame scheduling tests..."
+    ./test_display_frames
+    if [ $? -ne 0 ]; then
+        overall_exit=1
+    fi
+fi
+
 # Run apps tab behavioral tests if they exist
 if [ -f test_apps ]; then
     echo ""
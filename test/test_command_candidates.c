@@ -4,6 +4,12 @@
 #include "../src/app_data.h"
 #include "../src/command_api.h"
 #include "../src/display_pipeline.h"
+#include "../src/match_highlight.h"
+#include "../src/line_diff.h"
+#include "../src/results_view.h"
+#include "../src/render_fingerprint.h"
+#include "../src/search_cache.h"
+#include "../src/row_cache.h"
 
 static int tests_passed = 0;
 static int tests_failed = 0;
@@ -56,6 +62,46 @@ CofiResult get_x11_property(Display *display, Window window, Atom property, Atom
 gboolean path_binaries_is_scanning(void) {
     return FALSE;
 }
+void ensure_filtered_order(AppData *app, int count) { (void)app; (void)count; }
+int find_filtered_row(AppData *app, Window id) { (void)app; (void)id; return -1; }
+const char *get_windows_filter(void) { return ""; }
+void match_highlight_begin(MatchHighlighter *hl, const char *query) { (void)query; hl->count = 0; }
+void match_highlight_row(MatchHighlighter *hl, const char *text, int len, int offset) {
+    (void)hl; (void)text; (void)len; (void)offset;
+}
+bool match_highlight_changed(const MatchHighlighter *hl) { (void)hl; return false; }
+int line_diff_update(LineDiff *diff, const char *text) { (void)diff; (void)text; return -1; }
+void line_diff_invalidate(LineDiff *diff) { (void)diff; }
+GtkTextTag *results_view_match_tag(GtkTextBuffer *buffer) { (void)buffer; return NULL; }
+GtkTextTag *results_view_selected_tag(GtkTextBuffer *buffer) { (void)buffer; return NULL; }
+void calculate_display_range(gint total_count, gint max_lines, gint scroll_offset,
+                             gint *start_idx_out, gint *end_idx_out) {
+    (void)total_count; (void)max_lines; (void)scroll_offset;
+    *start_idx_out = 0;
+    *end_idx_out = 0;
+}
+uint64_t search_key_fingerprint(const WindowInfo *win) { (void)win; return 0; }
+uint64_t render_fingerprint_int(uint64_t hash, int64_t value) { (void)value; return hash; }
+uint64_t render_fingerprint_string(uint64_t hash, const char *text) { (void)text; return hash; }
+bool render_fingerprint_unchanged(RenderFingerprint *state, uint64_t fingerprint) {
+    (void)state; (void)fingerprint;
+    return false;
+}
+void render_fingerprint_invalidate(RenderFingerprint *state) { (void)state; }
+int find_window_index(const AppData *app, Window id) { (void)app; (void)id; return -1; }
+uint64_t row_cache_key(uint64_t fingerprint, int harpoon_slot, Window display_id) {
+    (void)harpoon_slot; (void)display_id;
+    return fingerprint;
+}
+const CachedRow *row_cache_lookup(RowCache *cache, Window id, uint64_t key) {
+    (void)cache; (void)id; (void)key;
+    return NULL;
+}
+CachedRow *row_cache_store(RowCache *cache, Window id, uint64_t key) {
+    (void)cache; (void)id; (void)key;
+    return NULL;
+}
+void row_cache_forget(RowCache *cache, Window id) { (void)cache; (void)id; }
 
 #include "../src/command_parser.c"
 #include "../src/command_mode.c"
@@ -29,6 +29,12 @@ int get_display_columns(AppData *app) { (void)app; return 80; }
 int get_max_display_lines_dynamic(AppData *app) { (void)app; return 20; }
 void overlay_scrollbar(GString *s, int t, int v, int o, int c)
     { (void)s; (void)t; (void)v; (void)o; (void)c; }
+int find_filtered_row(AppData *app, Window id) {
+    for (int i = 0; i < app->filtered_count; i++) {
+        if (app->filtered[i].id == id) return i;
+    }
+    return -1;
+}
 
 #include "../src/command_parser.c"
 #include "../src/command_mode.c"
@@ -38,6 +44,7 @@ static GtkWidget *g_fake_label = NULL;
 
 static AppData make_app_with_windows(int count) {
     AppData app = {0};
+    ensure_window_capacity(&app, count);
     app.current_tab = TAB_WINDOWS;
     app.filtered_count = count;
     for (int i = 0; i < count; i++) {
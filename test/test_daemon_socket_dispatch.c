@@ -38,6 +38,11 @@ void show_window(AppData *app) {
     show_window_calls++;
     focus_timestamp_at_show = app->focus_timestamp;
     show_window_sequence = ++call_sequence;
+    app->window_visible = TRUE;
+}
+
+void warm_show_mark_request(AppData *app) {
+    (void)app;
 }
 
 void switch_to_tab(AppData *app, TabMode tab) {
@@ -220,10 +225,9 @@ static void test_tab_opcode_dispatch(void) {
         ASSERT_TRUE(label, user_time_property_value_at_set == fresh_focus_timestamp_stub);
 
         if (cases[i].opcode == COFI_OPCODE_WINDOWS) {
-            ASSERT_TRUE("windows opcode clears entry text", gtk_entry_set_text_calls == 1);
-            ASSERT_TRUE("windows opcode resets selection", reset_selection_calls == 1);
-            ASSERT_TRUE("windows opcode refilters", filter_windows_calls == 1);
-            ASSERT_TRUE("windows opcode refreshes display", update_display_calls == 1);
+            // show_window already filtered and rendered the hidden window
+            ASSERT_TRUE("windows opcode leaves fresh show alone",
+                        filter_windows_calls == 0 && update_display_calls == 0);
             ASSERT_TRUE("windows opcode does not switch tab helper", switch_tab_calls == 0);
         } else {
             ASSERT_TRUE("non-windows opcode uses tab switch helper", switch_tab_calls == 1);
@@ -233,6 +237,21 @@ static void test_tab_opcode_dispatch(void) {
     }
 }
 
+static void test_windows_opcode_when_visible(void) {
+    AppData app = make_app();
+    reset_mocks();
+
+    app.window_visible = TRUE;
+    app.current_tab = TAB_HARPOON;
+    daemon_socket_dispatch_opcode(&app, COFI_OPCODE_WINDOWS);
+
+    ASSERT_TRUE("visible windows opcode sets windows tab", app.current_tab == TAB_WINDOWS);
+    ASSERT_TRUE("visible windows opcode clears entry text", gtk_entry_set_text_calls == 1);
+    ASSERT_TRUE("visible windows opcode resets selection", reset_selection_calls == 1);
+    ASSERT_TRUE("visible windows opcode refilters", filter_windows_calls == 1);
+    ASSERT_TRUE("visible windows opcode refreshes display", update_display_calls == 1);
+}
+
 static void test_command_opcode_dispatch(void) {
     AppData app = make_app();
     reset_mocks();
@@ -277,6 +296,7 @@ static void test_run_opcode_dispatch(void) {
 
 int main(void) {
     test_tab_opcode_dispatch();
+    test_windows_opcode_when_visible();
     test_command_opcode_dispatch();
     test_run_opcode_dispatch();
 
@@ -0,0 +1,333 @@
+/*
+ * Behavioral test: update_display() renders once per frame.
+ *
+ * display.c is included with a fake frame clock: connecting to "update"
+ * records the handler, which the test then runs as the clock's update
+ * phase would. Checks that requests made while the window is mapped
+ * render nothing until that phase and then render once however many came,
+ * that flush_display() renders a queued frame right away, that help or a
+ * message written after the request drops the queued frame, that a
+ * destroyed window (its clock finalized) leaves nothing queued, and that an
+ * unmapped window renders synchronously.
+ */
+
+#define G_DISABLE_CAST_CHECKS
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/app_data.h"
+#include "../src/command_api.h"
+#include "../src/display_pipeline.h"
+#include "../src/match_highlight.h"
+#include "../src/line_diff.h"
+#include "../src/results_view.h"
+#include "../src/render_fingerprint.h"
+#include "../src/search_cache.h"
+#include "../src/row_cache.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- Fake widgets, buffer and frame clock ---- */
+
+static char fake_view[64];
+static char fake_buffer[64];
+static char fake_clock[64];
+
+static gboolean view_mapped = TRUE;
+static gboolean buffer_modified = FALSE;
+static gpointer frame_mark = NULL;
+static int set_text_calls = 0;
+static int phase_requests = 0;
+static int disconnects = 0;
+
+static GCallback update_handler = NULL;
+static gpointer update_data = NULL;
+static gpointer *weak_location = NULL;
+
+gboolean gtk_widget_get_mapped(GtkWidget *widget) {
+    (void)widget;
+    return view_mapped;
+}
+
+GdkFrameClock *gtk_widget_get_frame_clock(GtkWidget *widget) {
+    (void)widget;
+    return (GdkFrameClock *)fake_clock;
+}
+
+gulong g_signal_connect_data(gpointer instance, const gchar *signal, GCallback handler,
+                             gpointer data, GClosureNotify notify, GConnectFlags flags) {
+    (void)instance; (void)notify; (void)flags;
+    if (strcmp(signal, "update") != 0) return 0;
+    update_handler = handler;
+    update_data = data;
+    return 17;
+}
+
+void g_signal_handler_disconnect(gpointer instance, gulong handler_id) {
+    (void)instance;
+    if (handler_id == 17) {
+        update_handler = NULL;
+        disconnects++;
+    }
+}
+
+void gdk_frame_clock_request_phase(GdkFrameClock *clock, GdkFrameClockPhase phase) {
+    (void)clock;
+    if (phase == GDK_FRAME_CLOCK_PHASE_UPDATE) phase_requests++;
+}
+
+void g_object_add_weak_pointer(GObject *object, gpointer *location) {
+    (void)object;
+    weak_location = location;
+}
+
+void g_object_remove_weak_pointer(GObject *object, gpointer *location) {
+    (void)object;
+    if (weak_location == location) weak_location = NULL;
+}
+
+gpointer g_object_get_data(GObject *object, const gchar *key) {
+    (void)object; (void)key;
+    return frame_mark;
+}
+
+void g_object_set_data(GObject *object, const gchar *key, gpointer data) {
+    (void)object; (void)key;
+    frame_mark = data;
+}
+
+gboolean gtk_text_buffer_get_modified(GtkTextBuffer *buffer) {
+    (void)buffer;
+    return buffer_modified;
+}
+
+void gtk_text_buffer_set_modified(GtkTextBuffer *buffer, gboolean setting) {
+    (void)buffer;
+    buffer_modified = setting;
+}
+
+void gtk_text_buffer_set_text(GtkTextBuffer *buffer, const gchar *text, gint len) {
+    (void)buffer; (void)text; (void)len;
+    set_text_calls++;
+    buffer_modified = TRUE;
+}
+
+// No rows are formatted here, so every frame only clears the selection
+gint gtk_text_buffer_get_line_count(GtkTextBuffer *buffer) {
+    (void)buffer;
+    return 1;
+}
+
+void gtk_text_buffer_get_bounds(GtkTextBuffer *buffer, GtkTextIter *start, GtkTextIter *end) {
+    (void)buffer; (void)start; (void)end;
+}
+
+void gtk_text_buffer_remove_tag(GtkTextBuffer *buffer, GtkTextTag *tag,
+                                const GtkTextIter *start, const GtkTextIter *end) {
+    (void)buffer; (void)tag; (void)start; (void)end;
+}
+
+/* ---- Inert collaborators ---- */
+
+void log_log(int level, const char *file, int line, const char *fmt, ...) {
+    (void)level; (void)file; (void)line; (void)fmt;
+}
+int get_display_columns(AppData *app) { (void)app; return 80; }
+int get_dynamic_max_display_lines(AppData *app) { (void)app; return 20; }
+int get_scroll_offset(AppData *app) { (void)app; return 0; }
+int get_selected_index(AppData *app) { (void)app; return 0; }
+gboolean render_display_pipeline(const DisplayPipelineRequest *request, GString *text) {
+    (void)request; (void)text;
+    return TRUE;
+}
+void calculate_display_range(gint total_count, gint max_lines, gint scroll_offset,
+                             gint *start_idx_out, gint *end_idx_out) {
+    (void)total_count; (void)max_lines; (void)scroll_offset;
+    *start_idx_out = 0;
+    *end_idx_out = 0;
+}
+gint get_window_slot(const HarpoonManager *manager, Window id) {
+    (void)manager; (void)id;
+    return -1;
+}
+gboolean tab_is_visible(AppData *app, TabMode tab) {
+    (void)app; (void)tab;
+    return TRUE;
+}
+CofiResult get_x11_property(Display *display, Window window, Atom property, Atom expected_type,
+                            unsigned long max_items, Atom *actual_type, int *actual_format,
+                            unsigned long *n_items, unsigned char **prop_return) {
+    (void)display; (void)window; (void)property; (void)expected_type;
+    (void)max_items; (void)actual_type; (void)actual_format; (void)n_items; (void)prop_return;
+    return COFI_ERROR;
+}
+gboolean path_binaries_is_scanning(void) { return FALSE; }
+void ensure_filtered_order(AppData *app, int count) { (void)app; (void)count; }
+int find_window_index(const AppData *app, Window id) { (void)app; (void)id; return -1; }
+const char *get_windows_filter(void) { return ""; }
+void match_highlight_begin(MatchHighlighter *hl, const char *query) { (void)query; hl->count = 0; }
+void match_highlight_row(MatchHighlighter *hl, const char *text, int len, int offset) {
+    (void)hl; (void)text; (void)len; (void)offset;
+}
+bool match_highlight_changed(const MatchHighlighter *hl) { (void)hl; return false; }
+int line_diff_update(LineDiff *diff, const char *text) { (void)diff; (void)text; return -1; }
+void line_diff_invalidate(LineDiff *diff) { (void)diff; }
+GtkTextTag *results_view_match_tag(GtkTextBuffer *buffer) { (void)buffer; return NULL; }
+GtkTextTag *results_view_selected_tag(GtkTextBuffer *buffer) { (void)buffer; return NULL; }
+uint64_t search_key_fingerprint(const WindowInfo *win) { (void)win; return 0; }
+uint64_t render_fingerprint_int(uint64_t hash, int64_t value) { (void)value; return hash; }
+uint64_t render_fingerprint_string(uint64_t hash, const char *text) { (void)text; return hash; }
+bool render_fingerprint_unchanged(RenderFingerprint *state, uint64_t fingerprint) {
+    (void)state; (void)fingerprint;
+    return false;
+}
+void render_fingerprint_invalidate(RenderFingerprint *state) { (void)state; }
+uint64_t row_cache_key(uint64_t fingerprint, int harpoon_slot, Window display_id) {
+    (void)harpoon_slot; (void)display_id;
+    return fingerprint;
+}
+const CachedRow *row_cache_lookup(RowCache *cache, Window id, uint64_t key) {
+    (void)cache; (void)id; (void)key;
+    return NULL;
+}
+CachedRow *row_cache_store(RowCache *cache, Window id, uint64_t key) {
+    (void)cache; (void)id; (void)key;
+    return NULL;
+}
+void row_cache_forget(RowCache *cache, Window id) { (void)cache; (void)id; }
+
+/* ---- Module under test ---- */
+#include "../src/display.c"
+
+/* ---- Helpers ---- */
+
+static AppData app;
+
+static void reset(void) {
+    // Nothing queued from the previous test
+    flush_display(&app);
+
+    memset(&app, 0, sizeof(app));
+    app.current_tab = TAB_WINDOWS;
+    app.textview = (GtkWidget *)fake_view;
+    app.textbuffer = (GtkTextBuffer *)fake_buffer;
+
+    view_mapped = TRUE;
+    buffer_modified = FALSE;
+    frame_mark = GINT_TO_POINTER(1);   // The buffer holds a painted frame
+    set_text_calls = 0;
+    phase_requests = 0;
+    disconnects = 0;
+}
+
+// What the frame clock does in its update phase
+static void run_update_phase(void) {
+    if (update_handler) {
+        ((void (*)(GdkFrameClock *, gpointer))update_handler)((GdkFrameClock *)fake_clock,
+                                                               update_data);
+    }
+}
+
+/* ---- Tests ---- */
+
+static void test_requests_render_once_per_frame(void) {
+    reset();
+    unsigned coalesced = get_coalesced_display_updates();
+
+    for (int i = 0; i < 5; i++) update_display(&app);
+    ASSERT_TRUE("requests render nothing before the update phase", set_text_calls == 0);
+    ASSERT_TRUE("one update phase requested", phase_requests == 1 && update_handler != NULL);
+    ASSERT_TRUE("four requests folded into the queued frame",
+                get_coalesced_display_updates() - coalesced == 4);
+
+    run_update_phase();
+    ASSERT_TRUE("update phase renders once", set_text_calls == 1);
+    ASSERT_TRUE("handler disconnected after its frame",
+                update_handler == NULL && queued_clock == NULL && weak_location == NULL);
+
+    run_update_phase();
+    ASSERT_TRUE("next phase renders nothing new", set_text_calls == 1);
+
+    update_display(&app);
+    ASSERT_TRUE("a later request queues a new frame", phase_requests == 2 && update_handler != NULL);
+    run_update_phase();
+    ASSERT_TRUE("and renders it", set_text_calls == 2);
+}
+
+static void test_flush_renders_queued_frame(void) {
+    reset();
+
+    flush_display(&app);
+    ASSERT_TRUE("flush with nothing queued renders nothing", set_text_calls == 0);
+
+    update_display(&app);
+    flush_display(&app);
+    ASSERT_TRUE("flush renders the queued frame now", set_text_calls == 1);
+    ASSERT_TRUE("flush unqueues it", update_handler == NULL && queued_clock == NULL);
+
+    run_update_phase();
+    ASSERT_TRUE("update phase after a flush renders nothing", set_text_calls == 1);
+}
+
+static void test_later_write_drops_queued_frame(void) {
+    reset();
+
+    update_display(&app);
+    buffer_modified = TRUE;     // Help or a message written after the request
+    run_update_phase();
+    ASSERT_TRUE("write after the request drops the queued frame", set_text_calls == 0);
+    ASSERT_TRUE("dropped frame leaves nothing queued", queued_clock == NULL);
+
+    update_display(&app);
+    run_update_phase();
+    ASSERT_TRUE("request after the write paints over it", set_text_calls == 1);
+}
+
+static void test_destroyed_window_clears_queue(void) {
+    reset();
+
+    update_display(&app);
+    ASSERT_TRUE("queued frame waits on the clock", queued_clock == (GdkFrameClock *)fake_clock);
+    ASSERT_TRUE("clock is held weakly", weak_location == (gpointer *)&queued_clock);
+
+    // Destroying the window finalizes its clock, clearing weak pointers
+    // (and its signal handlers with it)
+    *weak_location = NULL;
+    weak_location = NULL;
+    update_handler = NULL;
+    ASSERT_TRUE("destroyed window clears queued_clock", queued_clock == NULL);
+
+    update_display(&app);
+    ASSERT_TRUE("next request queues on the new clock",
+                phase_requests == 2 && queued_clock != NULL && disconnects == 0);
+    run_update_phase();
+    ASSERT_TRUE("and renders", set_text_calls == 1);
+}
+
+static void test_unmapped_window_renders_now(void) {
+    reset();
+    view_mapped = FALSE;
+
+    update_display(&app);
+    update_display(&app);
+    ASSERT_TRUE("unmapped: every request renders right away", set_text_calls == 2);
+    ASSERT_TRUE("unmapped: no frame queued", phase_requests == 0 && queued_clock == NULL);
+}
+
+int main(void) {
+    test_requests_render_once_per_frame();
+    test_flush_renders_queued_frame();
+    test_later_write_drops_queued_frame();
+    test_destroyed_window_clears_queue();
+    test_unmapped_window_renders_now();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -9,7 +9,7 @@
 void update_history(AppData *app) {
     // Simple mock: copy windows to history
     for (int i = 0; i < app->window_count; i++) {
-        app->history[i] = app->windows[i];
+        app->history[i] = app->windows[i].id;
     }
     app->history_count = app->window_count;
 }
@@ -26,9 +26,9 @@ void filter_windows_mock(AppData *app, const char *filter) {
     update_history(app);
     partition_and_reorder(app);
     
-    // Now filter the processed history
+    // Now filter the processed history (the mock keeps history in window order)
     for (int i = 0; i < app->history_count; i++) {
-        WindowInfo *win = &app->history[i];
+        WindowInfo *win = &app->windows[i];
         
         // Simple case-insensitive substring search in title, class, and instance
         if (strlen(filter) == 0 ||
@@ -36,7 +36,7 @@ void filter_windows_mock(AppData *app, const char *filter) {
             strstr(win->class_name, filter) ||
             strstr(win->instance, filter)) {
             
-            if (app->filtered_count < MAX_WINDOWS) {
+            if (ensure_window_capacity(app, app->filtered_count + 1)) {
                 app->filtered[app->filtered_count] = *win;
                 app->filtered_count++;
             }
@@ -65,6 +65,7 @@ int test_full_event_sequence() {
     printf("\n=== Simulating full X11 event sequence ===\n");
     
     AppData app = {0};
+    ensure_window_capacity(&app, WINDOW_STORE_MIN_CAPACITY);
     init_harpoon_manager(&app.harpoon);
     
     // Step 1: Initial state - window assigned to harpoon slot
@@ -168,6 +169,7 @@ int test_matching_failure() {
     printf("\n=== Testing matching failure scenario ===\n");
     
     AppData app = {0};
+    ensure_window_capacity(&app, WINDOW_STORE_MIN_CAPACITY);
     init_harpoon_manager(&app.harpoon);
     
     // Initial assignment
@@ -38,6 +38,18 @@ const char *get_window_custom_name(const NamedWindowManager *manager, Window id)
     (void)manager; (void)id; return NULL;
 }
 
+/* window_list.c */
+int find_window_index(const AppData *app, Window id) {
+    int index = window_registry_get(&app->windows_by_id, id);
+    if (index < 0 || index >= app->window_count || app->windows[index].id != id) {
+        return -1;
+    }
+    return index;
+}
+
+/* dynamic_display.c */
+gint get_dynamic_max_display_lines(struct AppData *app) { (void)app; return 20; }
+
 /* selection.c */
 void preserve_selection(AppData *app)  { (void)app; }
 void restore_selection(AppData *app)   { (void)app; }
@@ -50,6 +62,7 @@ void validate_selection(AppData *app)  { (void)app; }
 
 static void reset_app(AppData *app) {
     memset(app, 0, sizeof(*app));
+    ensure_window_capacity(app, 16);
     /* TAB_WINDOWS = 0 already from memset */
     /* WINDOW_ORDER_COFI = 0 already from memset */
 }
@@ -57,26 +70,32 @@ static void reset_app(AppData *app) {
 static void add_win(AppData *app, Window id, int desktop,
                     const char *instance, const char *title,
                     const char *class_name) {
-    int i = app->history_count;
-    app->history[i].id = id;
-    app->history[i].desktop = desktop;
-    strncpy(app->history[i].instance, instance,   sizeof(app->history[i].instance)   - 1);
-    strncpy(app->history[i].title,    title,       sizeof(app->history[i].title)       - 1);
-    strncpy(app->history[i].class_name, class_name, sizeof(app->history[i].class_name) - 1);
-    strncpy(app->history[i].type, "Normal", sizeof(app->history[i].type) - 1);
-    app->history_count++;
+    int i = app->window_count;
+    WindowInfo *win = &app->windows[i];
+    memset(win, 0, sizeof(*win));
+    win->id = id;
+    win->desktop = desktop;
+    strncpy(win->instance, instance,     sizeof(win->instance)   - 1);
+    strncpy(win->title,    title,        sizeof(win->title)      - 1);
+    strncpy(win->class_name, class_name, sizeof(win->class_name) - 1);
+    strncpy(win->type, "Normal", sizeof(win->type) - 1);
+    window_registry_put(&app->windows_by_id, id, i);
+    app->window_count++;
+    app->history[app->history_count++] = id;
 }
 
-/* ---- Score probe: compose display string + run match_window ---- */
-/* match_window() is static inside filter.c — accessible because we #include it */
+/* ---- Score probe: compose display string + run match_search_key ---- */
+/* match_search_key() is static inside filter.c — accessible because we #include it */
 
 static void print_scores(AppData *app, const char *query) {
     char display[1024];
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, query);
     printf("\n-- Scores for query '%s' --\n", query);
-    for (int i = 0; i < app->history_count; i++) {
-        compose_display_string(&app->history[i], display, sizeof(display));
-        score_t s = match_window(query, &app->history[i]);
-        int bonus = (app->history[i].desktop == mock_current_desktop) ? 5 : 0;
+    for (int i = 0; i < app->window_count; i++) {
+        compose_display_string(&app->windows[i], display, sizeof(display));
+        score_t s = match_search_key(&pattern, search_key_for(&app->windows[i]), false);
+        int bonus = (app->windows[i].desktop == mock_current_desktop) ? 5 : 0;
         printf("  raw=%.0f  bonus=%d  final=%.0f  '%s'\n",
                s, bonus, (s > SCORE_MIN ? s + bonus : s), display);
     }
@@ -153,6 +172,32 @@ static void test_pgl_exact_match_beats_workspace_bonus(void) {
                 app.filtered_count >= 1 && app.filtered[0].id == 0x100);
 }
 
+static void test_extended_query_narrows_and_resets_refinement(void) {
+    AppData app;
+    reset_app(&app);
+
+    add_win(&app, 0x100, 0, "Navigator", "notes - Mozilla Firefox", "firefox");
+    add_win(&app, 0x200, 1, "kitty", "vim notes.md", "kitty");
+
+    filter_windows(&app, "notes c:kitty");
+    ASSERT_TRUE("extended: class scope keeps only kitty",
+                app.filtered_count == 1 && app.filtered[0].id == 0x200);
+
+    filter_windows(&app, "notes !vim");
+    ASSERT_TRUE("extended: negation drops kitty",
+                app.filtered_count == 1 && app.filtered[0].id == 0x100);
+
+    /* Plain "fire" rejects kitty; the OR query after it must not inherit that */
+    filter_windows(&app, "fire");
+    filter_windows(&app, "fire | vim");
+    ASSERT_TRUE("extended: OR after a plain query sees every window",
+                app.filtered_count == 2);
+    filter_windows(&app, "fire");
+    filter_windows(&app, "firef");
+    ASSERT_TRUE("extended: plain typing after it refines again",
+                app.filtered_count == 1 && app.filtered[0].id == 0x100);
+}
+
 /* ---- Main ---- */
 
 int main(void) {
@@ -161,6 +206,7 @@ int main(void) {
     test_pgl_twitch_ranks_above_kraken();
     test_pgl_twitch_ranks_above_same_desktop_terminal();
     test_pgl_exact_match_beats_workspace_bonus();
+    test_extended_query_narrows_and_resets_refinement();
 
     printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
     return (fail == 0) ? 0 : 1;
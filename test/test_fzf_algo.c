@@ -7,12 +7,14 @@
  * Plus additional tests for cofi-specific requirements.
  *
  * Compile and run:
- *   gcc -o test/test_fzf_algo test/test_fzf_algo.c src/fzf_algo.c -lm && ./test/test_fzf_algo
+ *   gcc -o test/test_fzf_algo test/test_fzf_algo.c src/fzf_algo.c src/simd_scan.c -lm && ./test/test_fzf_algo
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 #include "../src/fzf_algo.h"
 
 /* --- Scoring constants (must match fzf_algo.c) --- */
@@ -408,6 +410,258 @@ static void test_fzf_real_world(void) {
         "'gnome-characters' > 'google-chrome' for 'gc' (shorter gap)");
 }
 
+static void test_fzf_compiled_matches_plain(void) {
+    printf("\n--- Precompiled Haystacks ---\n");
+
+    static const char *cases[][2] = {
+        { "foo-bar", "o-ba" },
+        { "Firefox - Google Search", "fire" },
+        { "[3] kitty zsh ~/projects/gl-tools kitty", "pgl" },
+        { "[1] google-chrome PGL - Twitch - Google Chrome Google-chrome", "pgl" },
+        { "fooBarBaz", "FBB" },
+        { "Terminal - bash", "t" },
+        { "abc", "abcd" },
+        { "abc", "xyz" },
+        { "gnome-characters", "gc" },
+        { "", "a" },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        FzfHaystack hs = {0};
+        FzfPattern pattern;
+        fzf_haystack_compile(&hs, cases[i][0]);
+        fzf_pattern_compile(&pattern, cases[i][1]);
+
+        score_t plain = fzf_fuzzy_match(cases[i][1], cases[i][0]);
+        score_t compiled = fzf_match_compiled(&pattern, &hs);
+        tests_run++;
+        if (fabs(plain - compiled) < 0.001 || (plain == SCORE_MIN && compiled == SCORE_MIN)) {
+            tests_passed++;
+            printf("  PASS: compiled score matches for '%s' in '%s'\n", cases[i][1], cases[i][0]);
+        } else {
+            tests_failed++;
+            printf("  FAIL: '%s' in '%s': plain %.0f, compiled %.0f\n",
+                   cases[i][1], cases[i][0], plain, compiled);
+        }
+        fzf_haystack_free(&hs);
+    }
+
+    /* Over-long text is rejected on both paths instead of truncated */
+    static char long_text[FZF_MAX_LEN + 64];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    memcpy(long_text, "firefox ", 8);
+    FzfHaystack long_hs = {0};
+    FzfPattern fire;
+    fzf_haystack_compile(&long_hs, long_text);
+    fzf_pattern_compile(&fire, "fire");
+    tests_run++;
+    if (fzf_fuzzy_match("fire", long_text) == SCORE_MIN &&
+        fzf_match_compiled(&fire, &long_hs) == SCORE_MIN) {
+        tests_passed++;
+        printf("  PASS: text over FZF_MAX_LEN matches on neither path\n");
+    } else {
+        tests_failed++;
+        printf("  FAIL: over-long text: plain %.0f, compiled %.0f\n",
+               fzf_fuzzy_match("fire", long_text), fzf_match_compiled(&fire, &long_hs));
+    }
+    fzf_haystack_free(&long_hs);
+
+    /* Recompiling reuses the haystack and drops the old text */
+    FzfHaystack hs = {0};
+    FzfPattern pattern;
+    fzf_haystack_compile(&hs, "Terminal");
+    fzf_haystack_compile(&hs, "Browser");
+    fzf_pattern_compile(&pattern, "term");
+    tests_run++;
+    if (fzf_match_compiled(&pattern, &hs) == SCORE_MIN && strcmp(hs.text, "browser") == 0) {
+        tests_passed++;
+        printf("  PASS: recompiled haystack replaces the old text\n");
+    } else {
+        tests_failed++;
+        printf("  FAIL: recompiled haystack kept stale text '%s'\n", hs.text);
+    }
+    fzf_haystack_free(&hs);
+
+    /* The presence mask is case-insensitive and covers every character */
+    tests_run++;
+    if (fzf_char_mask("ABC") == fzf_char_mask("cab") &&
+        (fzf_char_mask("term") & ~fzf_char_mask("terminal")) == 0 &&
+        (fzf_char_mask("xz") & ~fzf_char_mask("terminal")) != 0) {
+        tests_passed++;
+        printf("  PASS: character masks\n");
+    } else {
+        tests_failed++;
+        printf("  FAIL: character masks\n");
+    }
+}
+
+static void test_fzf_resumed_match_is_exact(void) {
+    printf("\n--- Resuming at the First Match ---\n");
+
+    /* Typing on: each query extends the previous one, so its first char
+     * occurs where the previous match reported it */
+    static const char *haystacks[] = {
+        "[2] firefox Mozilla Firefox - Release Notes firefox",
+        "[1] kitty ~/projects/fire-tools kitty",
+        "[S] conky conky conky",
+    };
+    static const char *queries[] = { "f", "fi", "fir", "fire", "firef", "fireft" };
+
+    for (size_t h = 0; h < sizeof(haystacks) / sizeof(haystacks[0]); h++) {
+        FzfHaystack hs = {0};
+        fzf_haystack_compile(&hs, haystacks[h]);
+
+        int start = 0;
+        int ok = 1;
+        for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+            FzfPattern pattern;
+            fzf_pattern_compile(&pattern, queries[q]);
+            score_t full = fzf_match_compiled(&pattern, &hs);
+            score_t resumed = fzf_match_compiled_from(&pattern, &hs, &start);
+            ok &= fabs(full - resumed) < 0.001 || (full == SCORE_MIN && resumed == SCORE_MIN);
+            if (resumed == SCORE_MIN) break;
+        }
+
+        tests_run++;
+        if (ok) {
+            tests_passed++;
+            printf("  PASS: resumed scores match for '%s'\n", haystacks[h]);
+        } else {
+            tests_failed++;
+            printf("  FAIL: resumed score differs for '%s'\n", haystacks[h]);
+        }
+        fzf_haystack_free(&hs);
+    }
+
+    /* The reported position is the first occurrence of the first char */
+    FzfHaystack hs = {0};
+    FzfPattern pattern;
+    fzf_haystack_compile(&hs, "xx fire");
+    fzf_pattern_compile(&pattern, "fi");
+    int start = 0;
+    fzf_match_compiled_from(&pattern, &hs, &start);
+    tests_run++;
+    if (start == 3) {
+        tests_passed++;
+        printf("  PASS: first match position reported\n");
+    } else {
+        tests_failed++;
+        printf("  FAIL: first match position %d, expected 3\n", start);
+    }
+    fzf_haystack_free(&hs);
+}
+
+/* Random text from an alphabet heavy in word boundaries, case changes and
+ * repeats, so runs, restarts and long gaps all show up */
+static void random_text(char *out, int len) {
+    static const char alphabet[] = "aabcdeefiiklmnooprsttuzAEFKT019 -_/.:|()";
+    for (int i = 0; i < len; i++)
+        out[i] = alphabet[rand() % (int)(sizeof(alphabet) - 1)];
+    out[len] = '\0';
+}
+
+/* Needle taken as a subsequence of the haystack, so most pairs match */
+static void random_subsequence(const char *haystack, char *out, int len) {
+    int n = (int)strlen(haystack);
+    int pos = 0;
+    int count = 0;
+    while (count < len && pos < n) {
+        pos += rand() % 4;
+        if (pos >= n) break;
+        out[count++] = haystack[pos++];
+    }
+    out[count] = '\0';
+}
+
+static void test_fzf_vector_kernel_matches_scalar(void) {
+    printf("\n--- Vector Kernel vs Scalar Reference ---\n");
+
+    static char haystack[FZF_MAX_LEN + 1];
+    static char needle[FZF_MAX_LEN + 1];
+    int mismatches = 0;
+    int matched = 0;
+    int pairs = 0;
+
+    srand(1234);
+    for (int round = 0; round < 20000; round++) {
+        /* Mostly title-sized, some long haystacks and patterns over 32
+         * chars (the scalar heap path) */
+        int n = round % 10 == 0 ? 100 + rand() % (FZF_MAX_LEN - 100) : 1 + rand() % 120;
+        int m = round % 50 == 0 ? 33 + rand() % 64 : 1 + rand() % 8;
+        random_text(haystack, n);
+        if (rand() % 4 == 0)
+            random_text(needle, m < n ? m : n);
+        else
+            random_subsequence(haystack, needle, m);
+        if (!needle[0])
+            continue;
+
+        score_t fast = fzf_fuzzy_match(needle, haystack);
+        score_t reference = fzf_fuzzy_match_scalar(needle, haystack);
+        pairs++;
+        if (reference > SCORE_MIN)
+            matched++;
+        if (fast != reference) {
+            if (mismatches++ < 5)
+                printf("        needle=\"%s\" haystack=\"%s\": %.0f vs %.0f\n",
+                       needle, haystack, fast, reference);
+        }
+    }
+
+    tests_run++;
+    if (mismatches == 0) {
+        tests_passed++;
+        printf("  PASS: identical scores on %d random pairs (%d matching)\n", pairs, matched);
+    } else {
+        tests_failed++;
+        printf("  FAIL: %d of %d random pairs differ\n", mismatches, pairs);
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void test_fzf_vector_kernel_benchmark(void) {
+    printf("\n--- Vector Kernel Benchmark ---\n");
+
+    /* Matching queries: rejected pairs stop before the score matrix */
+    enum { TITLES = 2000, QUERIES = 6 };
+    static char titles[TITLES][160];
+    static char queries[QUERIES][TITLES][16];
+    srand(99);
+    for (int i = 0; i < TITLES; i++) {
+        random_text(titles[i], 40 + rand() % 110);
+        for (int q = 0; q < QUERIES; q++)
+            random_subsequence(titles[i], queries[q][i], 2 + q * 2);
+    }
+
+    double times[2];
+    score_t (*fns[2])(const char *, const char *) = { fzf_fuzzy_match_scalar, fzf_fuzzy_match };
+    for (int f = 0; f < 2; f++) {
+        double best = 1e9;
+        volatile double sink = 0;
+        for (int attempt = 0; attempt < 3; attempt++) {
+            double start = now_seconds();
+            for (int q = 0; q < QUERIES; q++)
+                for (int i = 0; i < TITLES; i++)
+                    sink += fns[f](queries[q][i], titles[i]);
+            double elapsed = now_seconds() - start;
+            if (elapsed < best)
+                best = elapsed;
+        }
+        (void)sink;
+        times[f] = best;
+    }
+
+    /* Reported only: wall-clock time on a loaded machine is no test result */
+    double calls = (double)TITLES * QUERIES;
+    printf("  scalar: %.0f ns/call, vector: %.0f ns/call (%.2fx)\n",
+           times[0] * 1e9 / calls, times[1] * 1e9 / calls, times[0] / times[1]);
+}
+
 int main(void) {
     printf("=== fzf FuzzyMatchV2 Algorithm Tests ===\n");
 
@@ -422,6 +676,10 @@ int main(void) {
     test_fzf_comparison_with_expected_order();
     test_fzf_specific_scores();
     test_fzf_real_world();
+    test_fzf_compiled_matches_plain();
+    test_fzf_resumed_match_is_exact();
+    test_fzf_vector_kernel_matches_scalar();
+    test_fzf_vector_kernel_benchmark();
 
     printf("\n=== Results: %d/%d passed, %d failed ===\n",
            tests_passed, tests_run, tests_failed);
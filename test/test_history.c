@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <X11/Xlib.h>
-#include "test_utils.h"
+#include "../src/app_data.h"
 #include "../src/history.h"
 #include "../src/x11_utils.h"
 
@@ -13,6 +13,30 @@ int get_active_window_id(Display *display) {
     return mock_active_window_id;
 }
 
+int get_current_desktop(Display *display) {
+    (void)display;
+    return 0;
+}
+
+// window_list.c (the tests add windows without indexing them)
+int find_window_index(const AppData *app, Window id) {
+    for (int i = 0; i < app->window_count; i++) {
+        if (app->windows[i].id == id) return i;
+    }
+    return -1;
+}
+
+// Module under test
+#include "../src/window_store.c"
+#include "../src/history.c"
+
+#include "test_utils.h"
+
+// Window behind a history entry (history holds window IDs)
+static const WindowInfo *history_window(const AppData *app, int position) {
+    return &app->windows[find_window_index(app, app->history[position])];
+}
+
 // Test basic history update (window list synchronization)
 void test_update_history_basic() {
     printf("\n=== Testing Basic History Update ===\n");
@@ -29,9 +53,9 @@ void test_update_history_basic() {
     update_history(&app);
     
     ASSERT_EQ(app.history_count, 3, "History should have 3 windows");
-    ASSERT_EQ(app.history[0].id, 1, "First window should be Firefox");
-    ASSERT_EQ(app.history[1].id, 2, "Second window should be Terminal");
-    ASSERT_EQ(app.history[2].id, 3, "Third window should be Editor");
+    ASSERT_EQ(app.history[0], 1, "First window should be Firefox");
+    ASSERT_EQ(app.history[1], 2, "Second window should be Terminal");
+    ASSERT_EQ(app.history[2], 3, "Third window should be Editor");
 }
 
 // Test window removal from history when closed
@@ -54,13 +78,13 @@ void test_window_removal() {
     update_history(&app);
     
     ASSERT_EQ(app.history_count, 2, "History should have 2 windows after removal");
-    ASSERT_EQ(app.history[0].id, 1, "Firefox should still be first");
-    ASSERT_EQ(app.history[1].id, 3, "Editor should be second");
+    ASSERT_EQ(app.history[0], 1, "Firefox should still be first");
+    ASSERT_EQ(app.history[1], 3, "Editor should be second");
     
     // Verify Terminal was removed
     int terminal_found = 0;
     for (int i = 0; i < app.history_count; i++) {
-        if (app.history[i].id == 2) terminal_found = 1;
+        if (app.history[i] == 2) terminal_found = 1;
     }
     ASSERT(!terminal_found, "Terminal should be removed from history");
 }
@@ -77,10 +101,10 @@ void test_mru_ordering() {
     add_history_window(&app, create_test_window(2, "Terminal", "Terminal", "terminal", "Normal", 0));
     add_history_window(&app, create_test_window(3, "Editor", "Code", "code", "Normal", 0));
     
-    // Copy to window list
-    for (int i = 0; i < app.history_count; i++) {
-        add_test_window(&app, app.history[i]);
-    }
+    // Same windows in the window list
+    add_test_window(&app, create_test_window(1, "Firefox", "Firefox", "firefox", "Normal", 0));
+    add_test_window(&app, create_test_window(2, "Terminal", "Terminal", "terminal", "Normal", 0));
+    add_test_window(&app, create_test_window(3, "Editor", "Code", "code", "Normal", 0));
     
     // Initially, Firefox (id=1) is active
     app.active_window_id = 1;
@@ -90,17 +114,17 @@ void test_mru_ordering() {
     mock_active_window_id = 2;
     update_history(&app);
     
-    ASSERT_EQ(app.history[0].id, 2, "Terminal should move to front");
-    ASSERT_EQ(app.history[1].id, 1, "Firefox should move to second");
-    ASSERT_EQ(app.history[2].id, 3, "Editor should stay third");
+    ASSERT_EQ(app.history[0], 2, "Terminal should move to front");
+    ASSERT_EQ(app.history[1], 1, "Firefox should move to second");
+    ASSERT_EQ(app.history[2], 3, "Editor should stay third");
     
     // Now Editor (id=3) becomes active
     mock_active_window_id = 3;
     update_history(&app);
     
-    ASSERT_EQ(app.history[0].id, 3, "Editor should move to front");
-    ASSERT_EQ(app.history[1].id, 2, "Terminal should move to second");
-    ASSERT_EQ(app.history[2].id, 1, "Firefox should move to third");
+    ASSERT_EQ(app.history[0], 3, "Editor should move to front");
+    ASSERT_EQ(app.history[1], 2, "Terminal should move to second");
+    ASSERT_EQ(app.history[2], 1, "Firefox should move to third");
 }
 
 // Test cofi window exclusion
@@ -115,10 +139,10 @@ void test_cofi_exclusion() {
     add_history_window(&app, create_test_window(2, "cofi", "cofi", "cofi", "Normal", 0));
     add_history_window(&app, create_test_window(3, "Editor", "Code", "code", "Normal", 0));
     
-    // Copy to window list
-    for (int i = 0; i < app.history_count; i++) {
-        add_test_window(&app, app.history[i]);
-    }
+    // Same windows in the window list
+    add_test_window(&app, create_test_window(1, "Firefox", "Firefox", "firefox", "Normal", 0));
+    add_test_window(&app, create_test_window(2, "cofi", "cofi", "cofi", "Normal", 0));
+    add_test_window(&app, create_test_window(3, "Editor", "Code", "code", "Normal", 0));
     
     // Firefox is active initially
     app.active_window_id = 1;
@@ -129,9 +153,9 @@ void test_cofi_exclusion() {
     update_history(&app);
     
     // Cofi window should NOT move to front
-    ASSERT_EQ(app.history[0].id, 1, "Firefox should stay at front");
-    ASSERT_EQ(app.history[1].id, 2, "Cofi should stay in place");
-    ASSERT_STR_EQ(app.history[1].class_name, "cofi", "Verify it's the cofi window");
+    ASSERT_EQ(app.history[0], 1, "Firefox should stay at front");
+    ASSERT_EQ(app.history[1], 2, "Cofi should stay in place");
+    ASSERT_STR_EQ(history_window(&app, 1)->class_name, "cofi", "Verify it's the cofi window");
 }
 
 // Test window type partitioning
@@ -142,29 +166,35 @@ void test_partition_and_reorder() {
     init_test_app_data(&app);
     
     // Mix of Normal and Special windows
-    add_history_window(&app, create_test_window(1, "Dialog", "Dialog", "dialog", "Special", 0));
-    add_history_window(&app, create_test_window(2, "Firefox", "Firefox", "firefox", "Normal", 0));
-    add_history_window(&app, create_test_window(3, "Popup", "Popup", "popup", "Special", 0));
-    add_history_window(&app, create_test_window(4, "Terminal", "Terminal", "terminal", "Normal", 0));
-    add_history_window(&app, create_test_window(5, "Editor", "Code", "code", "Normal", 0));
+    WindowInfo windows[] = {
+        create_test_window(1, "Dialog", "Dialog", "dialog", "Special", 0),
+        create_test_window(2, "Firefox", "Firefox", "firefox", "Normal", 0),
+        create_test_window(3, "Popup", "Popup", "popup", "Special", 0),
+        create_test_window(4, "Terminal", "Terminal", "terminal", "Normal", 0),
+        create_test_window(5, "Editor", "Code", "code", "Normal", 0),
+    };
+    for (int i = 0; i < 5; i++) {
+        add_test_window(&app, windows[i]);
+        add_history_window(&app, windows[i]);
+    }
     
     // Partition and reorder
     partition_and_reorder(&app);
     
     ASSERT_EQ(app.history_count, 5, "Should still have 5 windows");
     
-    // Check Normal windows come first
-    ASSERT_STR_EQ(app.history[0].type, "Normal", "First window should be Normal");
-    ASSERT_STR_EQ(app.history[1].type, "Normal", "Second window should be Normal");
-    ASSERT_STR_EQ(app.history[2].type, "Normal", "Third window should be Normal");
+    // The first two stay in place for Alt-Tab
+    ASSERT_EQ(app.history[0], 1, "Active window stays first");
+    ASSERT_EQ(app.history[1], 2, "Previous window stays second");
     
-    // Check Special windows come last
-    ASSERT_STR_EQ(app.history[3].type, "Special", "Fourth window should be Special");
-    ASSERT_STR_EQ(app.history[4].type, "Special", "Fifth window should be Special");
+    // Then Normal windows, then Special windows
+    ASSERT_STR_EQ(history_window(&app, 2)->type, "Normal", "Third window should be Normal");
+    ASSERT_STR_EQ(history_window(&app, 3)->type, "Normal", "Fourth window should be Normal");
+    ASSERT_STR_EQ(history_window(&app, 4)->type, "Special", "Fifth window should be Special");
     
     // Verify specific windows
-    ASSERT_EQ(app.history[0].id, 2, "Firefox should be first Normal");
-    ASSERT_EQ(app.history[3].id, 1, "Dialog should be first Special");
+    ASSERT_EQ(app.history[2], 4, "Terminal should be first Normal after the two");
+    ASSERT_EQ(app.history[4], 3, "Popup should be the Special window at the end");
 }
 
 // Test adding new windows to history
@@ -191,15 +221,16 @@ void test_add_new_windows() {
     // New window should be added at the end
     int editor_found = 0;
     for (int i = 0; i < app.history_count; i++) {
-        if (app.history[i].id == 3) {
+        if (app.history[i] == 3) {
             editor_found = 1;
-            ASSERT_STR_EQ(app.history[i].title, "Editor", "Editor should be in history");
+            ASSERT_STR_EQ(history_window(&app, i)->title, "Editor", "Editor should be in history");
         }
     }
     ASSERT(editor_found, "Editor should be added to history");
 }
 
 int main() {
+    log_set_quiet(true);   // suppress log output during tests
     printf("=== Running History Unit Tests ===\n");
     
     test_update_history_basic();
@@ -60,6 +60,8 @@ void init_harpoon_manager(HarpoonManager *harpoon) { (void)harpoon; }
 void init_workspace_slots(WorkspaceSlotManager *manager) { (void)manager; }
 void init_slot_overlay_state(SlotOverlayState *state) { (void)state; }
 void init_window_highlight(WindowHighlight *highlight) { (void)highlight; }
+void init_warm_show_state(WarmShowState *state) { (void)state; }
+bool ensure_window_capacity(AppData *app, int needed) { (void)app; (void)needed; return true; }
 void init_hotkey_config(HotkeyConfig *config) { config->count = 0; }
 gboolean load_hotkey_config(HotkeyConfig *config) { (void)config; return TRUE; }
 int add_hotkey_binding(HotkeyConfig *config, const char *key, const char *command) {
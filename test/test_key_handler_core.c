@@ -4,6 +4,7 @@
 
 #include "../src/app_data.h"
 #include "../src/key_handler.h"
+#include "test_utils.h"
 #include "../src/constants.h"
 
 /*
@@ -281,6 +282,19 @@ void filter_apps(AppData *app, const char *query) {
     strncpy(g_last_filter_apps, query ? query : "", sizeof(g_last_filter_apps) - 1);
 }
 
+static int g_path_filter_async_calls;
+static char g_last_path_filter_async[64];
+gboolean filter_apps_async(AppData *app, const char *query, gint64 keystroke_us) {
+    (void)keystroke_us;
+    if (!query || query[0] != '$') {
+        filter_apps(app, query);
+        return FALSE;
+    }
+    g_path_filter_async_calls++;
+    strncpy(g_last_path_filter_async, query + 1, sizeof(g_last_path_filter_async) - 1);
+    return TRUE;
+}
+
 void reset_selection(AppData *app) { (void)app; g_reset_selection_calls++; }
 void update_display(AppData *app) { (void)app; g_update_display_calls++; }
 
@@ -336,6 +350,7 @@ static void reset_captures(void) {
 
 static void init_app(AppData *app) {
     memset(app, 0, sizeof(*app));
+    attach_window_tables(app);
     app->entry = gtk_entry_new();
     app->mode_indicator = gtk_label_new(">");
     app->window_visible = TRUE;
@@ -675,6 +690,19 @@ static void test_on_entry_changed_routes_per_tab_filters(void) {
         ASSERT_TRUE("APPS filter routing",
                     tabs[i] != TAB_APPS || (g_filter_apps_calls == 1 && strcmp(g_last_filter_apps, "query") == 0));
     }
+
+    // PATH queries go to the worker and leave the rows on screen alone
+    g_filter_apps_calls = 0;
+    g_reset_selection_calls = 0;
+    g_update_display_calls = 0;
+    g_path_filter_async_calls = 0;
+    app.current_tab = TAB_APPS;
+    gtk_entry_set_text(GTK_ENTRY(app.entry), "$git");
+    on_entry_changed(GTK_ENTRY(app.entry), &app);
+    ASSERT_TRUE("$ query is scored asynchronously",
+                g_path_filter_async_calls == 1 && strcmp(g_last_path_filter_async, "git") == 0);
+    ASSERT_TRUE("$ query does not filter or redraw synchronously",
+                g_filter_apps_calls == 0 && g_reset_selection_calls == 0 && g_update_display_calls == 0);
 }
 
 int main(int argc, char **argv) {
@@ -4,6 +4,7 @@
 
 #include "../src/app_data.h"
 #include "../src/key_handler.h"
+#include "test_utils.h"
 
 /*
  * Testability strategy:
@@ -282,6 +283,8 @@ void filter_windows(AppData *app, const char *query) { (void)app; (void)query; }
 void filter_workspaces(AppData *app, const char *query) { (void)app; (void)query; }
 void filter_harpoon(AppData *app, const char *filter) { (void)app; (void)filter; }
 void filter_apps(AppData *app, const char *query) { (void)app; (void)query; }
+gboolean filter_apps_async(AppData *app, const char *query, gint64 keystroke_us)
+    { (void)app; (void)query; (void)keystroke_us; return FALSE; }
 void reset_selection(AppData *app) { (void)app; }
 void apps_launch(const AppEntry *entry) { (void)entry; }
 
@@ -321,6 +324,7 @@ static void reset_captures(void) {
 
 static void init_app(AppData *app) {
     memset(app, 0, sizeof(*app));
+    attach_window_tables(app);
     app->entry = gtk_entry_new();
     app->mode_indicator = gtk_label_new(">");
 }
@@ -0,0 +1,122 @@
+/*
+ * layout_cache: laid-out rows of the results view, kept across frames.
+ *
+ * Layouts are stand-in heap strings here. Checks hits and misses by row
+ * text, that replacing and evicting free the old layout, that eviction
+ * takes the least recently drawn row, and that drawing frames of a 40-row
+ * list lays out only rows whose text changed: none for a selection move
+ * (the marker is drawn over the row, not part of its text) or for rows
+ * that only moved to another line.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/layout_cache.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static int freed = 0;
+
+static void free_layout(void *layout) {
+    freed++;
+    free(layout);
+}
+
+static char *make_layout(const char *text) {
+    return strdup(text);
+}
+
+// Draw rows through the cache like the results view; returns how many
+// had to be laid out
+static int draw_frame(LayoutCache *cache, char rows[][64], int count) {
+    unsigned misses = cache->misses;
+    for (int i = 0; i < count; i++) {
+        if (!layout_cache_lookup(cache, rows[i])) {
+            layout_cache_store(cache, rows[i], make_layout(rows[i]));
+        }
+    }
+    return (int)(cache->misses - misses);
+}
+
+// Rows as the display formats them: a blank selection gutter whichever
+// row is selected
+static void list_frame(char rows[][64], int count, int first) {
+    for (int i = 0; i < count; i++) {
+        snprintf(rows[i], 64, "  [%d] kitty  window %d", (first + i) % 9 + 1, first + i);
+    }
+}
+
+/* ---- Tests ---- */
+
+static void test_lookup_and_store(void) {
+    LayoutCache cache = { .free_layout = free_layout };
+    ASSERT_TRUE("unknown row misses", !layout_cache_lookup(&cache, "firefox") && cache.misses == 1);
+
+    char *layout = make_layout("firefox");
+    layout_cache_store(&cache, "firefox", layout);
+    ASSERT_TRUE("stored row hits", layout_cache_lookup(&cache, "firefox") == layout && cache.hits == 1);
+    ASSERT_TRUE("highlights are part of the key", !layout_cache_lookup(&cache, "firefox\x1f" "0-4"));
+
+    freed = 0;
+    layout_cache_store(&cache, "firefox", make_layout("firefox"));
+    ASSERT_TRUE("storing a row again frees the old layout", freed == 1 && cache.count == 1);
+
+    layout_cache_clear(&cache);
+    ASSERT_TRUE("clearing frees every layout",
+                freed == 2 && cache.count == 0 && !layout_cache_lookup(&cache, "firefox"));
+    layout_cache_cleanup(&cache);
+}
+
+static void test_evicts_least_recently_drawn(void) {
+    LayoutCache cache = { .free_layout = free_layout };
+    char key[32];
+    for (int i = 0; i < LAYOUT_CACHE_MAX_ENTRIES; i++) {
+        snprintf(key, sizeof(key), "row %d", i);
+        layout_cache_store(&cache, key, make_layout(key));
+    }
+    layout_cache_lookup(&cache, "row 0");
+
+    freed = 0;
+    layout_cache_store(&cache, "row new", make_layout("row new"));
+    ASSERT_TRUE("a full cache stays at its size", cache.count == LAYOUT_CACHE_MAX_ENTRIES && freed == 1);
+    ASSERT_TRUE("the least recently drawn row goes",
+                layout_cache_lookup(&cache, "row 0") && !layout_cache_lookup(&cache, "row 1") &&
+                layout_cache_lookup(&cache, "row new"));
+    layout_cache_cleanup(&cache);
+}
+
+static void test_frames_lay_out_changed_rows_only(void) {
+    static char rows[40][64];
+    LayoutCache cache = { .free_layout = free_layout };
+
+    list_frame(rows, 40, 0);
+    ASSERT_TRUE("first frame lays out every row", draw_frame(&cache, rows, 40) == 40);
+
+    // Moving the selection only moves the selected tag
+    list_frame(rows, 40, 0);
+    ASSERT_TRUE("moving the selection lays out nothing", draw_frame(&cache, rows, 40) == 0);
+
+    // Scrolling by one: every row moves a line and one is new
+    list_frame(rows, 40, 1);
+    int laid_out = draw_frame(&cache, rows, 40);
+    printf("  scrolling one row: %d of 40 rows laid out\n", laid_out);
+    ASSERT_TRUE("scrolling lays out only rows not drawn before", laid_out == 1);
+    layout_cache_cleanup(&cache);
+}
+
+int main(void) {
+    test_lookup_and_store();
+    test_evicts_least_recently_drawn();
+    test_frames_lay_out_changed_rows_only();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/*
+ * line_diff: line edits between two frames of the results buffer.
+ *
+ * Applies the edits to a plain string the way update_display() applies
+ * them to the GtkTextBuffer and checks that the result is the new frame,
+ * for random frames and for the cases the display produces: moving the
+ * selection, narrowing and widening the list, trailing newlines, and a
+ * buffer that was written by someone else.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/line_diff.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+#define BUFFER_SIZE 16384
+
+// A text buffer: the string plus line arithmetic on it
+static char buffer[BUFFER_SIZE];
+
+static int line_count(void) {
+    int count = 1;
+    for (const char *p = buffer; *p; p++) count += *p == '\n';
+    return count;
+}
+
+// Byte offset of the start of line (the end of the buffer past the last)
+static int line_offset(int line) {
+    int offset = 0;
+    for (int l = 0; l < line; l++) {
+        const char *newline = strchr(buffer + offset, '\n');
+        if (!newline) return (int)strlen(buffer);
+        offset = (int)(newline - buffer) + 1;
+    }
+    return offset;
+}
+
+static void splice(int start, int end, const char *text, int len) {
+    memmove(buffer + start + len, buffer + end, strlen(buffer + end) + 1);
+    memcpy(buffer + start, text, (size_t)len);
+}
+
+static void apply_edit(const LineEdit *edit) {
+    int lines = line_count();
+    int start = line_offset(edit->line);
+    switch (edit->kind) {
+        case LINE_EDIT_REPLACE: {
+            const char *newline = strchr(buffer + start, '\n');
+            int end = newline ? (int)(newline - buffer) : (int)strlen(buffer);
+            splice(start, end, edit->text, edit->len);
+            break;
+        }
+        case LINE_EDIT_INSERT:
+            if (edit->line < lines) {
+                splice(start, start, "\n", 1);
+                splice(start, start, edit->text, edit->len);
+            } else {
+                int end = (int)strlen(buffer);
+                splice(end, end, edit->text, edit->len);
+                splice(end, end, "\n", 1);
+            }
+            break;
+        case LINE_EDIT_DELETE:
+            if (edit->line + edit->count < lines) {
+                splice(start, line_offset(edit->line + edit->count), "", 0);
+            } else {
+                splice(start - 1, (int)strlen(buffer), "", 0);
+            }
+            break;
+    }
+}
+
+// Put text into the buffer through the diff; returns the edit count or -1
+static int render(LineDiff *diff, const char *text) {
+    int edits = line_diff_update(diff, text);
+    if (edits < 0) {
+        snprintf(buffer, sizeof(buffer), "%s", text);
+    }
+    for (int i = 0; i < edits; i++) apply_edit(&diff->edits[i]);
+    return edits;
+}
+
+// A results frame: rows top to bottom behind their blank selection gutter
+// (the marker is a tag, not text), then the tab header
+static void frame(char *out, size_t size, int rows, int first) {
+    size_t used = 0;
+    out[0] = '\0';
+    for (int r = 0; r < rows; r++) {
+        used += (size_t)snprintf(out + used, size - used, "  [%d] kitty  window %d\n",
+                                 (first + r) % 9 + 1, first + r);
+    }
+    snprintf(out + used, size - used, "\n  WINDOWS    Workspaces    Harpoon");
+}
+
+/* ---- Tests ---- */
+
+static void test_first_frame_sets_everything(void) {
+    LineDiff diff = {0};
+    ASSERT_TRUE("nothing to diff against the first time", render(&diff, "a\nb") == -1);
+    ASSERT_TRUE("same text needs no edits", render(&diff, "a\nb") == 0 && strcmp(buffer, "a\nb") == 0);
+
+    line_diff_invalidate(&diff);
+    ASSERT_TRUE("an invalidated diff sets the whole text again", render(&diff, "a\nb") == -1);
+    line_diff_cleanup(&diff);
+}
+
+static void test_selection_move_touches_no_lines(void) {
+    static char text[BUFFER_SIZE];
+    LineDiff diff = {0};
+    frame(text, sizeof(text), 40, 0);
+    render(&diff, text);
+
+    // An arrow key formats the same rows again
+    frame(text, sizeof(text), 40, 0);
+    int edits = render(&diff, text);
+    ASSERT_TRUE("arrow key rewrites no lines", edits == 0);
+    ASSERT_TRUE("buffer matches the new frame", strcmp(buffer, text) == 0);
+    line_diff_cleanup(&diff);
+}
+
+static void test_list_grows_and_shrinks(void) {
+    static char text[BUFFER_SIZE];
+    LineDiff diff = {0};
+    frame(text, sizeof(text), 40, 0);
+    render(&diff, text);
+
+    frame(text, sizeof(text), 12, 0);
+    int edits = render(&diff, text);
+    ASSERT_TRUE("narrowing deletes the missing rows in one edit",
+                edits >= 1 && diff.edits[edits - 1].kind == LINE_EDIT_DELETE &&
+                strcmp(buffer, text) == 0);
+
+    frame(text, sizeof(text), 30, 0);
+    edits = render(&diff, text);
+    ASSERT_TRUE("widening inserts the new rows in one edit",
+                edits >= 1 && diff.edits[edits - 1].kind == LINE_EDIT_INSERT &&
+                diff.edits[edits - 1].count == 18 && strcmp(buffer, text) == 0);
+
+    render(&diff, "No matching windows found\n\n  WINDOWS    Workspaces    Harpoon");
+    ASSERT_TRUE("empty result keeps only the header lines",
+                strcmp(buffer, "No matching windows found\n\n  WINDOWS    Workspaces    Harpoon") == 0);
+    line_diff_cleanup(&diff);
+}
+
+static void test_edges_of_the_buffer(void) {
+    static const char *frames[] = { "a\nb\n", "a\nb\nc\nd", "a", "", "\n\n", "x\na\nb",
+                                    "a\nb\n", "a\nb\nc\n", "a" };
+    LineDiff diff = {0};
+    int ok = 1;
+    for (int i = 0; i < 9; i++) {
+        render(&diff, frames[i]);
+        ok &= strcmp(buffer, frames[i]) == 0;
+    }
+    ASSERT_TRUE("trailing newlines, empty text and edits at either end", ok);
+    line_diff_cleanup(&diff);
+}
+
+static void test_random_frames(void) {
+    static const char *words[] = { "kitty", "firefox", "", "emacs", "> kitty", "  vim" };
+    static char text[BUFFER_SIZE];
+    LineDiff diff = {0};
+    int ok = 1;
+    srand(7);
+    for (int round = 0; round < 500; round++) {
+        int lines = rand() % 12;
+        size_t used = 0;
+        text[0] = '\0';
+        for (int l = 0; l < lines; l++) {
+            used += (size_t)snprintf(text + used, sizeof(text) - used, "%s%s",
+                                     l ? "\n" : "", words[rand() % 6]);
+        }
+        render(&diff, text);
+        ok &= strcmp(buffer, text) == 0;
+    }
+    ASSERT_TRUE("random frames end up in the buffer unchanged", ok);
+    line_diff_cleanup(&diff);
+}
+
+int main(void) {
+    test_first_frame_sets_everything();
+    test_selection_move_touches_no_lines();
+    test_list_grows_and_shrinks();
+    test_edges_of_the_buffer();
+    test_random_frames();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
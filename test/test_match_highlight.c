@@ -0,0 +1,178 @@
+/*
+ * match_highlight: matched characters of the rows a frame draws.
+ *
+ * Checks that positions computed in a reused scratch agree with
+ * match_positions(), that fuzzy, exact and OR terms turn into merged spans
+ * at the right line and byte offsets, that negated and workspace terms and
+ * multibyte characters add nothing, that every drawn row advances the
+ * line and that a frame tells whether its spans changed; then reports the
+ * time of highlighting one screen of rows against computing positions for
+ * every match.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/match_highlight.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static MatchHighlighter hl;
+
+static void add_row(const char *row, int offset) {
+    match_highlight_row(&hl, row, (int)strlen(row), offset);
+}
+
+static int has_span(int line, int start, int len) {
+    for (int i = 0; i < hl.count; i++) {
+        if (hl.spans[i].line == line && hl.spans[i].start == start && hl.spans[i].len == len) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* ---- Tests ---- */
+
+static void test_scratch_positions_match_allocating_version(void) {
+    static const char *needles[] = { "ffx", "moz", "a", "gitst", "firefox" };
+    static const char *haystacks[] = { "Firefox - Mozilla", "git status --short",
+                                       "firefox", "[2] Navigator GitHub firefox" };
+    MatchScratch scratch = {0};
+    int ok = 1;
+    for (int n = 0; n < 5; n++) {
+        for (int h = 0; h < 4; h++) {
+            if (!has_match(needles[n], haystacks[h])) continue;
+            size_t expected[MATCH_MAX_LEN];
+            size_t positions[MATCH_MAX_LEN];
+            score_t want = match_positions(needles[n], haystacks[h], expected);
+            score_t got = match_positions_scratch(&scratch, needles[n], haystacks[h], positions);
+            ok &= want == got;
+            for (size_t i = 0; i < strlen(needles[n]); i++) ok &= expected[i] == positions[i];
+        }
+    }
+    ASSERT_TRUE("scratch positions equal match_positions()", ok);
+
+    score_t *rows = scratch.rows;
+    size_t capacity = scratch.capacity;
+    size_t positions[MATCH_MAX_LEN];
+    match_positions_scratch(&scratch, "ff", "Firefox", positions);
+    ASSERT_TRUE("smaller matches reuse the scratch",
+                scratch.rows == rows && scratch.capacity == capacity);
+    match_scratch_free(&scratch);
+}
+
+static void test_fuzzy_spans(void) {
+    match_highlight_begin(&hl, "fox");
+    add_row("[1] kitty    vim", 4);
+    add_row("[2] Navigator Firefox", 4);
+    ASSERT_TRUE("rows without a match still take a line", hl.lines == 2);
+    ASSERT_TRUE("consecutive matched characters merge into one span",
+                hl.count == 1 && has_span(1, 4 + 18, 3));
+
+    match_highlight_begin(&hl, "nf");
+    add_row("[2] Navigator Firefox", 4);
+    ASSERT_TRUE("word starts win over earlier characters",
+                hl.count == 2 && has_span(0, 8, 1) && has_span(0, 18, 1));
+
+    match_highlight_begin(&hl, "fzz");
+    add_row("[2] Navigator Firefox", 4);
+    ASSERT_TRUE("no span for a query the drawn row cannot match", hl.count == 0);
+}
+
+static void test_extended_spans(void) {
+    match_highlight_begin(&hl, "'MOZ !kitty w:2");
+    add_row("[2] Navigator Mozilla Firefox", 2);
+    ASSERT_TRUE("exact term tags its substring, negated and workspace terms nothing",
+                hl.count == 1 && has_span(0, 2 + 14, 3));
+
+    match_highlight_begin(&hl, "c:chrome | c:firefox");
+    add_row("[2] Navigator Mozilla Firefox", 0);
+    ASSERT_TRUE("OR terms tag whichever alternative is visible",
+                hl.count == 1 && has_span(0, 22, 7));
+
+    match_highlight_begin(&hl, "!kitty");
+    ASSERT_TRUE("only negated terms highlight nothing", !hl.active);
+    match_highlight_begin(&hl, "");
+    ASSERT_TRUE("empty query highlights nothing", !hl.active);
+}
+
+static void test_changed_against_previous_frame(void) {
+    match_highlight_begin(&hl, "fox");
+    add_row("[2] Navigator Firefox", 4);
+    match_highlight_begin(&hl, "fox");
+    add_row("[2] Navigator Firefox", 4);
+    ASSERT_TRUE("same rows and query are unchanged", !match_highlight_changed(&hl));
+    match_highlight_begin(&hl, "fo");
+    add_row("[2] Navigator Firefox", 4);
+    ASSERT_TRUE("a different query changes the spans", match_highlight_changed(&hl));
+}
+
+static void test_multibyte_characters_are_skipped(void) {
+    match_highlight_begin(&hl, "\xc3\xa9t");
+    add_row("caf\xc3\xa9 table", 0);
+    ASSERT_TRUE("bytes inside multibyte characters get no span",
+                hl.count == 1 && has_span(0, 6, 1));
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#define BENCH_MATCHES 2000
+#define BENCH_VISIBLE 40
+
+static void test_benchmark_visible_rows_only(void) {
+    static char rows[BENCH_MATCHES][128];
+    static const char *classes[] = { "kitty", "firefox", "Google-chrome", "Emacs", "Thunderbird" };
+    for (int i = 0; i < BENCH_MATCHES; i++) {
+        snprintf(rows[i], sizeof(rows[i]), "[%d] %-20s project %d - issue tracker %-20s",
+                 i % 9 + 1, classes[i % 5], i, classes[i % 5]);
+    }
+
+    double visible = 1e9;
+    double all = 1e9;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        match_highlight_begin(&hl, "issue");
+        for (int i = 0; i < BENCH_VISIBLE; i++) add_row(rows[i], 4);
+        double elapsed = now_seconds() - start;
+        if (elapsed < visible) visible = elapsed;
+
+        // Positions for every match, as if scoring computed them
+        start = now_seconds();
+        size_t positions[MATCH_MAX_LEN];
+        int matched = 0;
+        for (int i = 0; i < BENCH_MATCHES; i++) {
+            matched += match_positions("issue", rows[i], positions) > SCORE_MIN;
+        }
+        elapsed = now_seconds() - start;
+        if (elapsed < all && matched == BENCH_MATCHES) all = elapsed;
+    }
+    printf("  %d visible rows %.0f us, positions for all %d matches %.0f us\n",
+           BENCH_VISIBLE, visible * 1e6, BENCH_MATCHES, all * 1e6);
+    // Timings are reported only; comparing them would race on a loaded machine
+    ASSERT_TRUE("one span per visible row", hl.count == BENCH_VISIBLE && hl.lines == BENCH_VISIBLE);
+}
+
+int main(void) {
+    test_scratch_positions_match_allocating_version();
+    test_fuzzy_spans();
+    test_extended_spans();
+    test_changed_against_previous_frame();
+    test_multibyte_characters_are_skipped();
+    test_benchmark_visible_rows_only();
+    match_highlight_cleanup(&hl);
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+/*
+ * name_scorer_run(): chunked parallel scoring with per-thread top-K.
+ *
+ * Checks that 2, 4 and 8 threads give exactly the single-thread survivors
+ * and ranked front over a synthetic 50k-name corpus (full and subset
+ * candidate lists), that cancellation is reported, then reports the time
+ * of 1/2/4/8 threads over the same corpus.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/fzf_algo.h"
+#include "../src/name_scorer.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- Corpus ---- */
+
+#define CORPUS_SIZE 50000
+#define TOP_K 512
+
+static const char *stems[] = {
+    "git", "python", "lib", "xdg", "gnome", "kde", "perl", "ruby", "node", "cargo",
+    "systemd", "pulse", "pipe", "wire", "grep", "sed", "awk", "ssh", "gpg", "vim",
+    "config", "update", "desktop", "mime", "font", "x11", "wayland", "dbus", "gtk", "qt",
+};
+static const char *joins[] = { "-", "_", "", "." };
+
+static char corpus_text[CORPUS_SIZE][48];
+static const char *names[CORPUS_SIZE];
+static guint64 masks[CORPUS_SIZE];
+
+static void build_corpus(void) {
+    srand(2024);
+    int stem_count = (int)(sizeof(stems) / sizeof(stems[0]));
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        // Names are unique through the trailing number, like PATH basenames
+        snprintf(corpus_text[i], sizeof(corpus_text[i]), "%s%s%s%d",
+                 stems[rand() % stem_count], joins[rand() % 4],
+                 stems[rand() % stem_count], i);
+        names[i] = corpus_text[i];
+        masks[i] = fzf_char_mask(names[i]);
+    }
+}
+
+static const char *queries[] = { "git", "e", "py", "lib-", "conf", "x11", "9", "zzz", "gtk_qt" };
+#define QUERY_COUNT (int)(sizeof(queries) / sizeof(queries[0]))
+
+/* ---- Tests ---- */
+
+static ScoredName expected_scored[CORPUS_SIZE];
+static int expected_survivors[CORPUS_SIZE];
+static ScoredName scored[CORPUS_SIZE];
+static int survivors[CORPUS_SIZE];
+
+static int same_run(int expected_count, int count) {
+    if (count != expected_count) return 0;
+    if (memcmp(survivors, expected_survivors, (size_t)count * sizeof(int)) != 0) return 0;
+    int front = count < TOP_K ? count : TOP_K;
+    for (int i = 0; i < front; i++) {
+        if (scored[i].index != expected_scored[i].index ||
+            scored[i].score != expected_scored[i].score) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void check_threads_agree(const int *candidates, int candidate_count, const char *label) {
+    int ok = 1;
+    for (int q = 0; q < QUERY_COUNT; q++) {
+        int expected = name_scorer_run(queries[q], names, masks, candidates, candidate_count,
+                                       1, TOP_K, expected_scored, expected_survivors, NULL);
+        for (int threads = 2; threads <= NAME_SCORER_MAX_THREADS; threads *= 2) {
+            int count = name_scorer_run(queries[q], names, masks, candidates, candidate_count,
+                                        threads, TOP_K, scored, survivors, NULL);
+            ok &= same_run(expected, count);
+        }
+    }
+    ASSERT_TRUE(label, ok);
+}
+
+static void test_threads_match_single_thread(void) {
+    check_threads_agree(NULL, CORPUS_SIZE, "2/4/8 threads rank exactly like one thread");
+
+    // Refinement passes a subset of indices instead of the whole list
+    static int subset[CORPUS_SIZE];
+    int subset_count = 0;
+    for (int i = 0; i < CORPUS_SIZE; i += 3) subset[subset_count++] = i;
+    check_threads_agree(subset, subset_count, "candidate subsets agree across thread counts");
+
+    int count = name_scorer_run("git", names, masks, NULL, CORPUS_SIZE,
+                                1, TOP_K, scored, survivors, NULL);
+    int ordered = count > 0;
+    for (int i = 1; i < count && i < TOP_K; i++) ordered &= scored[i - 1].score >= scored[i].score;
+    ASSERT_TRUE("front is ranked best first", ordered);
+    ASSERT_TRUE("no match gives no survivors",
+                name_scorer_run("zzz", names, masks, NULL, CORPUS_SIZE,
+                                4, TOP_K, scored, survivors, NULL) == 0);
+}
+
+static void test_cancelled_run_reports_it(void) {
+    GCancellable *cancellable = g_cancellable_new();
+    g_cancellable_cancel(cancellable);
+    ASSERT_TRUE("cancelled single-thread run returns -1",
+                name_scorer_run("e", names, masks, NULL, CORPUS_SIZE,
+                                1, TOP_K, scored, survivors, cancellable) == -1);
+    ASSERT_TRUE("cancelled parallel run returns -1",
+                name_scorer_run("e", names, masks, NULL, CORPUS_SIZE,
+                                4, TOP_K, scored, survivors, cancellable) == -1);
+    g_object_unref(cancellable);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Best-of-5 time for every query over the corpus
+static double time_queries(int threads) {
+    double best = 1e9;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        for (int q = 0; q < QUERY_COUNT; q++) {
+            name_scorer_run(queries[q], names, masks, NULL, CORPUS_SIZE,
+                            threads, TOP_K, scored, survivors, NULL);
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+static void test_benchmark_scaling(void) {
+    double single = time_queries(1);
+    printf("  %d names, %d queries, %u cores\n", CORPUS_SIZE, QUERY_COUNT, g_get_num_processors());
+    printf("  1 thread:  %.2f ms/query\n", single * 1000 / QUERY_COUNT);
+
+    // Reported only: shared or throttled runners make any speedup assert flaky
+    for (int threads = 2; threads <= NAME_SCORER_MAX_THREADS; threads *= 2) {
+        double elapsed = time_queries(threads);
+        printf("  %d threads: %.2f ms/query (x%.1f)\n", threads,
+               elapsed * 1000 / QUERY_COUNT, elapsed > 0 ? single / elapsed : 0);
+    }
+}
+
+int main(void) {
+    build_corpus();
+
+    test_threads_match_single_thread();
+    test_cancelled_run_reports_it();
+    test_benchmark_scaling();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
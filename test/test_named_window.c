@@ -309,6 +309,43 @@ static void test_reassign_skip_already_named(void) {
     ASSERT_INT("tab1 orphaned", 0, mgr.entries[0].assigned);
 }
 
+static void test_reassign_names_delta(void) {
+    printf("\n--- check_and_reassign_names_delta ---\n");
+
+    NamedWindowManager mgr;
+    init_named_window_manager(&mgr);
+
+    WindowInfo w_orig = make_window(100, "Terminal - bash", "gnome-terminal", "gnome-terminal-server", "Normal");
+    assign_custom_name(&mgr, &w_orig, "term");
+
+    WindowInfo windows[2];
+    windows[0] = make_window(300, "Firefox", "Firefox", "Navigator", "Normal");
+    windows[1] = make_window(200, "Terminal - bash", "gnome-terminal", "gnome-terminal-server", "Normal");
+
+    // Only a window was added: the named window 100 is not part of the delta
+    static WindowListDelta delta;
+    static int added[1];
+    static Window removed[1];
+    memset(&delta, 0, sizeof(delta));
+    delta.added = added;
+    delta.added[0] = 0;
+    delta.added_count = 1;
+    int changed = check_and_reassign_names_delta(&mgr, windows, 2, &delta);
+    ASSERT_INT("unrelated delta: no change", 0, changed);
+    ASSERT_INT("unrelated delta: still on 100", 1, (mgr.entries[0].id == 100));
+
+    // Window 100 removed: any current window may take the name over
+    memset(&delta, 0, sizeof(delta));
+    delta.removed = removed;
+    delta.removed[0] = 100;
+    delta.removed_count = 1;
+    changed = check_and_reassign_names_delta(&mgr, windows, 2, &delta);
+    ASSERT_INT("removed: reassignment happened", 1, changed);
+    ASSERT_INT("removed: reassigned to 200", 1, (mgr.entries[0].id == 200));
+
+    ASSERT_INT("NULL delta", 0, (int)check_and_reassign_names_delta(&mgr, windows, 2, NULL));
+}
+
 static void test_wildcard_in_title(void) {
     printf("\n--- wildcard matching in title storage ---\n");
 
@@ -337,6 +374,7 @@ int main(void) {
     test_reassign_names();
     test_reassign_no_match();
     test_reassign_skip_already_named();
+    test_reassign_names_delta();
     test_wildcard_in_title();
 
     printf("\n=====================================\n");
@@ -163,6 +163,20 @@ void filter_names(AppData *app, const char *filter) {
     }
 }
 
+// Backing store for the name tables (AppData only holds pointers)
+#define TEST_NAME_CAPACITY 8
+static NamedWindow test_name_entries[TEST_NAME_CAPACITY];
+static NamedWindow test_filtered_names[TEST_NAME_CAPACITY];
+
+static void attach_name_tables(AppData *app) {
+    memset(test_name_entries, 0, sizeof(test_name_entries));
+    memset(test_filtered_names, 0, sizeof(test_filtered_names));
+    app->names.entries = test_name_entries;
+    app->names.capacity = TEST_NAME_CAPACITY;
+    app->filtered_names = test_filtered_names;
+    app->filtered_names_capacity = TEST_NAME_CAPACITY;
+}
+
 static void reset_captures(void) {
     g_hide_overlay_calls = 0;
     g_update_display_calls = 0;
@@ -184,6 +198,7 @@ static GdkEventKey make_key(guint keyval, GdkModifierType state) {
 static void test_harpoon_delete_confirm_y_clears_state_and_hides_overlay(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_HARPOON;
     app.overlay_active = TRUE;
@@ -207,6 +222,7 @@ static void test_harpoon_delete_confirm_y_clears_state_and_hides_overlay(void) {
 static void test_harpoon_delete_cancel_n_clears_state_and_hides_overlay(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_HARPOON;
     app.overlay_active = TRUE;
@@ -230,6 +246,7 @@ static void test_harpoon_delete_cancel_n_clears_state_and_hides_overlay(void) {
 static void test_name_delete_confirm_y_deletes_and_clamps_last_row(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_NAMES;
     app.overlay_active = TRUE;
@@ -265,6 +282,7 @@ static void test_name_delete_confirm_y_deletes_and_clamps_last_row(void) {
 static void test_name_delete_confirm_ctrl_d_deletes_and_hides_overlay(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_NAMES;
     app.overlay_active = TRUE;
@@ -294,6 +312,7 @@ static void test_name_delete_confirm_ctrl_d_deletes_and_hides_overlay(void) {
 static void test_name_delete_confirm_ctrl_d_works_for_orphan_fallback(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_NAMES;
     app.overlay_active = TRUE;
@@ -321,6 +340,7 @@ static void test_name_delete_confirm_ctrl_d_works_for_orphan_fallback(void) {
 static void test_name_delete_cancel_n_clears_state_and_hides_overlay(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_NAMES;
     app.overlay_active = TRUE;
@@ -358,6 +378,7 @@ static gboolean handle_overlay_escape_for_test(AppData *app, GdkEventKey *event)
 static void test_name_delete_cancel_esc_clears_state_via_overlay_manager(void) {
     AppData app;
     memset(&app, 0, sizeof(app));
+    attach_name_tables(&app);
     app.entry = gtk_entry_new();
     app.current_tab = TAB_NAMES;
     app.overlay_active = TRUE;
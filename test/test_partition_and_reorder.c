@@ -0,0 +1,249 @@
+/*
+ * partition_and_reorder(): stable counting sort over window IDs.
+ *
+ * Checks the new partition against the previous by-value implementation
+ * (five WindowInfo[256] stack arrays, kept below as the reference) and
+ * reports per-call time and stack high-water mark for both.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/app_data.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- Stubs ---- */
+
+static int mock_current_desktop = 1;
+
+/* x11_utils.c */
+int get_active_window_id(Display *d)  { (void)d; return 0; }
+int get_current_desktop(Display *d)   { (void)d; return mock_current_desktop; }
+
+/* window_list.c */
+int find_window_index(const AppData *app, Window id) {
+    int index = window_registry_get(&app->windows_by_id, id);
+    if (index < 0 || index >= app->window_count || app->windows[index].id != id) {
+        return -1;
+    }
+    return index;
+}
+
+/* ---- Module under test ---- */
+#include "../src/window_store.c"
+#include "../src/history.c"
+
+/* ---- Reference: the by-value partition this replaced ---- */
+
+#define REF_MAX_WINDOWS 256
+
+__attribute__((noinline))
+static void reference_partition(WindowInfo *history, int count, int current_desktop) {
+    if (count <= 2) return;
+
+    WindowInfo first_window = history[0];
+    WindowInfo second_window = history[1];
+    WindowInfo current_normal[REF_MAX_WINDOWS];
+    WindowInfo other_normal[REF_MAX_WINDOWS];
+    WindowInfo current_special[REF_MAX_WINDOWS];
+    WindowInfo other_special[REF_MAX_WINDOWS];
+    WindowInfo sticky_windows[REF_MAX_WINDOWS];
+    int cn = 0, on = 0, cs = 0, os = 0, st = 0;
+
+    for (int i = 2; i < count; i++) {
+        WindowInfo *win = &history[i];
+        if (win->desktop == -1) {
+            sticky_windows[st++] = *win;
+        } else if (strcmp(win->type, "Normal") == 0) {
+            if (win->desktop == current_desktop) current_normal[cn++] = *win;
+            else other_normal[on++] = *win;
+        } else {
+            if (win->desktop == current_desktop) current_special[cs++] = *win;
+            else other_special[os++] = *win;
+        }
+    }
+
+    int n = 0;
+    history[n++] = first_window;
+    history[n++] = second_window;
+    for (int i = 0; i < cn; i++) history[n++] = current_normal[i];
+    for (int i = 0; i < on; i++) history[n++] = other_normal[i];
+    for (int i = 0; i < cs; i++) history[n++] = current_special[i];
+    for (int i = 0; i < os; i++) history[n++] = other_special[i];
+    for (int i = 0; i < st; i++) history[n++] = sticky_windows[i];
+}
+
+/* ---- Stack high-water mark ---- */
+
+// Paint a stack region, run the function from the same depth, then count
+// how much of the paint was overwritten
+#define STACK_PROBE_BYTES (4 * 1024 * 1024)
+#define STACK_PAINT 0xA5
+
+__attribute__((noinline))
+static void paint_stack(void) {
+    volatile unsigned char probe[STACK_PROBE_BYTES];
+    for (size_t i = 0; i < sizeof(probe); i++) probe[i] = STACK_PAINT;
+}
+
+__attribute__((noinline))
+static size_t painted_stack_used(void) {
+    volatile unsigned char probe[STACK_PROBE_BYTES];
+    size_t untouched = 0;
+    while (untouched < sizeof(probe) && probe[untouched] == STACK_PAINT) untouched++;
+    return sizeof(probe) - untouched;
+}
+
+/* ---- Helpers ---- */
+
+static WindowInfo ref_history[REF_MAX_WINDOWS];
+
+static void fill_app(AppData *app, int count, unsigned seed) {
+    memset(app, 0, sizeof(*app));
+    window_registry_init(&app->windows_by_id);
+    ensure_window_capacity(app, count);
+
+    srand(seed);
+    for (int i = 0; i < count; i++) {
+        WindowInfo *win = &app->windows[i];
+        memset(win, 0, sizeof(*win));
+        win->id = 0x2000000 + (Window)i;
+        win->desktop = rand() % 5 - 1;  // -1 (sticky) .. 3
+        snprintf(win->title, sizeof(win->title), "window %d", i);
+        snprintf(win->type, sizeof(win->type), "%s", rand() % 4 == 0 ? "Dialog" : "Normal");
+        window_registry_put(&app->windows_by_id, win->id, i);
+        app->history[i] = win->id;
+    }
+    app->window_count = count;
+    app->history_count = count;
+}
+
+static void free_app(AppData *app) {
+    free(app->windows);
+    free(app->history);
+    free(app->filtered);
+    free(app->windows_to_move);
+    window_registry_free(&app->windows_by_id);
+}
+
+static void load_reference(const AppData *app) {
+    for (int i = 0; i < app->history_count; i++) {
+        ref_history[i] = app->windows[find_window_index(app, app->history[i])];
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* ---- Tests ---- */
+
+static void test_matches_reference_order(void) {
+    int ok = 1;
+    for (unsigned seed = 1; seed <= 20 && ok; seed++) {
+        AppData app;
+        fill_app(&app, REF_MAX_WINDOWS, seed);
+        load_reference(&app);
+
+        reference_partition(ref_history, app.history_count, mock_current_desktop);
+        partition_and_reorder(&app);
+
+        for (int i = 0; i < app.history_count; i++) {
+            ok &= app.history[i] == ref_history[i].id;
+        }
+        free_app(&app);
+    }
+    ASSERT_TRUE("order matches the by-value reference", ok);
+}
+
+static void test_keeps_first_two_and_group_order(void) {
+    AppData app;
+    fill_app(&app, 8, 7);
+    // Sticky dialog up front must stay put; the rest sorts by group
+    int desktops[] = { -1, 3, -1, 2, 1, 1, 0, 1 };
+    const char *types[] = { "Dialog", "Normal", "Normal", "Dialog", "Dialog", "Normal", "Normal", "Normal" };
+    for (int i = 0; i < 8; i++) {
+        app.windows[i].desktop = desktops[i];
+        snprintf(app.windows[i].type, sizeof(app.windows[i].type), "%s", types[i]);
+    }
+
+    partition_and_reorder(&app);
+
+    // current Normal (5, 7), other Normal (6), current Special (4),
+    // other Special (3), sticky (2)
+    int expected[] = { 0, 1, 5, 7, 6, 4, 3, 2 };
+    int ok = 1;
+    for (int i = 0; i < 8; i++) ok &= app.history[i] == app.windows[expected[i]].id;
+    ASSERT_TRUE("first two kept, groups stable", ok);
+    free_app(&app);
+}
+
+static void test_benchmark_time_and_stack(void) {
+    enum { ROUNDS = 2000 };
+    AppData app;
+    fill_app(&app, REF_MAX_WINDOWS, 99);
+    load_reference(&app);
+    partition_and_reorder(&app);  // Grow the scratch tables up front
+
+    paint_stack();
+    reference_partition(ref_history, REF_MAX_WINDOWS, mock_current_desktop);
+    size_t before_stack = painted_stack_used();
+
+    paint_stack();
+    partition_and_reorder(&app);
+    size_t after_stack = painted_stack_used();
+
+    double start = now_seconds();
+    for (int r = 0; r < ROUNDS; r++) {
+        reference_partition(ref_history, REF_MAX_WINDOWS, mock_current_desktop);
+    }
+    double before_time = (now_seconds() - start) / ROUNDS;
+
+    start = now_seconds();
+    for (int r = 0; r < ROUNDS; r++) {
+        partition_and_reorder(&app);
+    }
+    double after_time = (now_seconds() - start) / ROUNDS;
+    free_app(&app);
+
+    fill_app(&app, 2000, 99);
+    partition_and_reorder(&app);
+    start = now_seconds();
+    for (int r = 0; r < ROUNDS; r++) {
+        partition_and_reorder(&app);
+    }
+    double large_time = (now_seconds() - start) / ROUNDS;
+    free_app(&app);
+
+    printf("  256 windows before: %.1f us/call, stack %zu bytes\n",
+           before_time * 1e6, before_stack);
+    printf("  256 windows after:  %.1f us/call, stack %zu bytes\n",
+           after_time * 1e6, after_stack);
+    printf("  2000 windows after: %.1f us/call\n", large_time * 1e6);
+
+    // The reference reserves 1.7 MB; only the slots it fills get touched
+    ASSERT_TRUE("by-value reference touches hundreds of KB of stack",
+                before_stack > 512 * 1024);
+    ASSERT_TRUE("partition stays under 8 KB of stack", after_stack < 8 * 1024);
+}
+
+int main(void) {
+    log_set_quiet(true);   /* suppress log output during tests */
+
+    test_matches_reference_order();
+    test_keeps_first_two_and_group_order();
+    test_benchmark_time_and_stack();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
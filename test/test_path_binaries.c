@@ -391,6 +391,97 @@ static void test_large_match_set_prefers_high_score(void) {
     ASSERT_STR_EQ("exact match 'e' tops the sorted list", "e", out[0].name);
 }
 
+static void test_extended_query_rescans_only_survivors(void) {
+    path_binaries_reset_for_tests();
+
+    AppEntry chunk[] = {
+        make_path_entry("git", "/bin/git"),
+        make_path_entry("gitk", "/bin/gitk"),
+        make_path_entry("git-lfs", "/bin/git-lfs"),
+        make_path_entry("grep", "/bin/grep"),
+        make_path_entry("awk", "/bin/awk"),
+        make_path_entry("sed", "/bin/sed"),
+    };
+    path_binaries_merge_entries_test_hook(NULL, chunk, 6, TRUE);
+
+    AppEntry out[MAX_PATH_BINS];
+    int out_count = 0;
+    path_binaries_filter("g", out, &out_count);
+    ASSERT_EQ_INT("first query scans the whole cache", 6, path_binaries_last_scan_count_for_tests());
+    ASSERT_EQ_INT("query g count", 4, out_count);
+
+    path_binaries_filter("gi", out, &out_count);
+    ASSERT_EQ_INT("extended query scans only survivors", 4, path_binaries_last_scan_count_for_tests());
+    ASSERT_EQ_INT("query gi count", 3, out_count);
+
+    path_binaries_filter("git-", out, &out_count);
+    ASSERT_EQ_INT("further extension narrows again", 3, path_binaries_last_scan_count_for_tests());
+    ASSERT_EQ_INT("query git- count", 1, out_count);
+    ASSERT_STR_EQ("query git- match", "git-lfs", out[0].name);
+
+    /* Backspace: not an extension, so everything is a candidate again */
+    path_binaries_filter("git", out, &out_count);
+    ASSERT_EQ_INT("shortened query rescans the cache", 6, path_binaries_last_scan_count_for_tests());
+    ASSERT_EQ_INT("query git count", 3, out_count);
+
+    /* Cache changes drop the survivors */
+    AppEntry more[] = { make_path_entry("gitui", "/bin/gitui") };
+    path_binaries_merge_entries_test_hook(NULL, more, 1, TRUE);
+    path_binaries_filter("gitu", out, &out_count);
+    ASSERT_EQ_INT("merge forces a full scan", 7, path_binaries_last_scan_count_for_tests());
+    ASSERT_EQ_INT("new entry found", 1, out_count);
+    ASSERT_STR_EQ("new entry name", "gitui", out[0].name);
+}
+
+static void wait_for_filter_results(void) {
+    while (path_binaries_filter_pending_for_tests()) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+}
+
+static void test_async_filter_publishes_latest_query(void) {
+    path_binaries_reset_for_tests();
+
+    AppEntry chunk[] = {
+        make_path_entry("git", "/bin/git"),
+        make_path_entry("gitk", "/bin/gitk"),
+        make_path_entry("git-lfs", "/bin/git-lfs"),
+        make_path_entry("grep", "/bin/grep"),
+    };
+    path_binaries_merge_entries_test_hook(NULL, chunk, 4, TRUE);
+
+    AppData app;
+    memset(&app, 0, sizeof(app));
+    app.current_tab = TAB_APPS;
+    app.filtered_apps[0] = make_path_entry("previous", "/bin/previous");
+    app.filtered_apps_count = 1;
+
+    path_binaries_filter_async(&app, "g", g_get_monotonic_time());
+    path_binaries_filter_async(&app, "git-", g_get_monotonic_time());
+    ASSERT_TRUE("previous rows stay until the result lands",
+                app.filtered_apps_count == 1 && strcmp(app.filtered_apps[0].name, "previous") == 0);
+
+    wait_for_filter_results();
+    ASSERT_EQ_INT("only the newest query is published", 1, app.filtered_apps_count);
+    ASSERT_STR_EQ("newest query result", "git-lfs", app.filtered_apps[0].name);
+
+    /* A cache change while the worker runs rescores the new cache */
+    path_binaries_filter_async(&app, "gitu", g_get_monotonic_time());
+    AppEntry more[] = { make_path_entry("gitui", "/bin/gitui") };
+    path_binaries_merge_entries_test_hook(NULL, more, 1, TRUE);
+    wait_for_filter_results();
+    ASSERT_EQ_INT("stale snapshot is rescored", 1, app.filtered_apps_count);
+    ASSERT_STR_EQ("rescored result sees the new entry", "gitui", app.filtered_apps[0].name);
+
+    /* A synchronous filter supersedes a pending result */
+    path_binaries_filter_async(&app, "grep", g_get_monotonic_time());
+    AppEntry out[MAX_PATH_BINS];
+    int out_count = 0;
+    path_binaries_filter("gitk", out, &out_count);
+    wait_for_filter_results();
+    ASSERT_STR_EQ("cancelled result is not published", "gitui", app.filtered_apps[0].name);
+}
+
 int main(void) {
     test_dedupe_first_in_path_wins();
     test_filter_by_query();
@@ -404,6 +495,8 @@ int main(void) {
     test_cap_warning_emits_once();
     test_tig_ranked_above_loose_matches();
     test_large_match_set_prefers_high_score();
+    test_extended_query_rescans_only_survivors();
+    test_async_filter_publishes_latest_query();
 
     printf("\nResults: %d/%d tests passed\n", tests_passed, tests_run);
     return (tests_passed == tests_run) ? 0 : 1;
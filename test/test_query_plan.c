@@ -0,0 +1,205 @@
+/*
+ * query_plan: fzf extended-search syntax for the windows tab.
+ *
+ * Checks how queries parse (plain vs extended, operators, scopes, OR
+ * groups, cheap groups ordered first), what each term kind accepts against
+ * a few windows, and that scores add up over AND groups; then reports the
+ * time of a class-scoped query over 300 windows with the plan's cheap-first
+ * order against the same plan evaluated fuzzy-first.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/query_plan.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static WindowInfo make_window(int desktop, const char *instance, const char *title,
+                              const char *class_name) {
+    WindowInfo win;
+    memset(&win, 0, sizeof(win));
+    win.desktop = desktop;
+    snprintf(win.instance, sizeof(win.instance), "%s", instance);
+    snprintf(win.title, sizeof(win.title), "%s", title);
+    snprintf(win.class_name, sizeof(win.class_name), "%s", class_name);
+    return win;
+}
+
+// Display string as filter.c composes it (desktop, instance, title, class)
+static void compile_display(const WindowInfo *win, FzfHaystack *display) {
+    char text[1024];
+    snprintf(text, sizeof(text), "[%d] %s %s %s",
+             win->desktop + 1, win->instance, win->title, win->class_name);
+    fzf_haystack_compile(display, text);
+}
+
+static int plan_matches(const char *query, const WindowInfo *win) {
+    static QueryPlan plan;
+    FzfHaystack display = {0};
+    query_plan_parse(&plan, query);
+    compile_display(win, &display);
+    int matched = query_plan_match(&plan, win, &display) > SCORE_MIN;
+    fzf_haystack_free(&display);
+    return matched;
+}
+
+/* ---- Tests ---- */
+
+static void test_parse(void) {
+    static QueryPlan plan;
+
+    ASSERT_TRUE("single fuzzy term stays plain", !query_plan_parse(&plan, "firefox"));
+    ASSERT_TRUE("empty query stays plain", !query_plan_parse(&plan, ""));
+    ASSERT_TRUE("two terms are extended",
+                query_plan_parse(&plan, "fire moz") && plan.group_count == 2);
+    ASSERT_TRUE("an operator makes one term extended", query_plan_parse(&plan, "'fire"));
+    ASSERT_TRUE("a scope makes one term extended", query_plan_parse(&plan, "c:kitty"));
+    ASSERT_TRUE("escaped space is extended", query_plan_parse(&plan, "mail\\ client"));
+    ASSERT_TRUE("escaped space joins one term",
+                plan.term_count == 1 && strcmp(plan.terms[0].pattern.text, "mail client") == 0);
+
+    query_plan_parse(&plan, "!C:^Fire$");
+    ASSERT_TRUE("negation, scope and anchors combine",
+                plan.term_count == 1 && plan.terms[0].negated &&
+                plan.terms[0].field == QUERY_FIELD_CLASS && plan.terms[0].kind == QUERY_EQUAL &&
+                strcmp(plan.terms[0].pattern.text, "fire") == 0);
+
+    query_plan_parse(&plan, "!fire");
+    ASSERT_TRUE("negated term without anchors is exact", plan.terms[0].kind == QUERY_EXACT);
+    query_plan_parse(&plan, "w:1");
+    ASSERT_TRUE("workspace scope compares whole numbers", plan.terms[0].kind == QUERY_EQUAL);
+
+    query_plan_parse(&plan, "! ^ x");
+    ASSERT_TRUE("operators without text are skipped while typing",
+                plan.term_count == 1 && strcmp(plan.terms[0].pattern.text, "x") == 0);
+
+    query_plan_parse(&plan, "tab c:firefox | c:chrome !private");
+    ASSERT_TRUE("'|' joins neighbouring terms into one group",
+                plan.group_count == 3 && plan.term_count == 4);
+    ASSERT_TRUE("cheap groups are evaluated before fuzzy ones",
+                !plan.groups[0].fuzzy && plan.groups[0].count == 2 &&
+                !plan.groups[1].fuzzy && plan.terms[plan.groups[1].first].negated &&
+                plan.groups[2].fuzzy);
+}
+
+static void test_term_kinds(void) {
+    WindowInfo firefox = make_window(2, "Navigator", "GitHub - Mozilla Firefox", "firefox");
+    WindowInfo kitty = make_window(0, "kitty", "vim ~/fire.c", "kitty");
+    WindowInfo sticky = make_window(-1, "panel", "Panel", "xfce4-panel");
+
+    ASSERT_TRUE("AND terms in any order", plan_matches("firefox git", &firefox));
+    ASSERT_TRUE("AND needs every term", !plan_matches("firefox zsh", &firefox));
+    ASSERT_TRUE("exact needs a substring", !plan_matches("'gthb", &firefox) &&
+                                           plan_matches("'thub", &firefox));
+    ASSERT_TRUE("prefix anchors a field start", plan_matches("^moz x", &kitty) == 0 &&
+                                                plan_matches("^git ^fire", &firefox));
+    ASSERT_TRUE("suffix anchors a field end", plan_matches("firefox$ ^vim", &firefox) == 0 &&
+                                              plan_matches("fire.c$", &kitty));
+    ASSERT_TRUE("equal needs a whole field", plan_matches("^kitty$ vim", &kitty) &&
+                                             !plan_matches("^kitt$ vim", &kitty));
+    ASSERT_TRUE("negation excludes", !plan_matches("!fire", &kitty) &&
+                                     plan_matches("!fire", &sticky));
+    ASSERT_TRUE("OR accepts either side", plan_matches("c:chrome | c:kitty", &kitty) &&
+                                          !plan_matches("c:chrome | c:kitty", &firefox));
+    ASSERT_TRUE("class scope checks class and instance",
+                plan_matches("c:navig", &firefox) && !plan_matches("c:github", &firefox));
+    ASSERT_TRUE("title scope checks only the title, as a substring",
+                plan_matches("t:vim", &kitty) && !plan_matches("t:kitty", &kitty) &&
+                !plan_matches("t:vmfire", &kitty));
+    ASSERT_TRUE("workspace scope matches the shown number",
+                plan_matches("w:3", &firefox) && !plan_matches("w:1", &firefox) &&
+                plan_matches("w:s", &sticky));
+    ASSERT_TRUE("terms match case-insensitively", plan_matches("'GITHUB c:FIREFOX", &firefox));
+}
+
+static void test_scores_add_up(void) {
+    static QueryPlan plan;
+    WindowInfo firefox = make_window(2, "Navigator", "GitHub - Mozilla Firefox", "firefox");
+    FzfHaystack display = {0};
+    compile_display(&firefox, &display);
+
+    query_plan_parse(&plan, "git");
+    score_t git = fzf_match_compiled(&plan.terms[0].pattern, &display);
+    query_plan_parse(&plan, "git 'mozilla !chrome");
+    score_t combined = query_plan_match(&plan, &firefox, &display);
+    ASSERT_TRUE("score sums fuzzy and exact terms, negation adds nothing",
+                combined == git + 7 * 16);
+    fzf_haystack_free(&display);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#define BENCH_WINDOWS 300
+
+// Best-of-5 time for scoring every window with plan, in microseconds
+static double time_plan(const QueryPlan *plan, const WindowInfo *windows,
+                        const FzfHaystack *displays, int *matches) {
+    double best = 1e9;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        *matches = 0;
+        for (int r = 0; r < 20; r++) {
+            for (int i = 0; i < BENCH_WINDOWS; i++) {
+                *matches += query_plan_match(plan, &windows[i], &displays[i]) > SCORE_MIN;
+            }
+        }
+        double elapsed = (now_seconds() - start) / 20;
+        if (elapsed < best) best = elapsed;
+    }
+    return best * 1e6;
+}
+
+static void test_benchmark_cheap_terms_first(void) {
+    static const char *classes[] = { "kitty", "firefox", "Google-chrome", "Emacs", "Thunderbird" };
+    static WindowInfo windows[BENCH_WINDOWS];
+    static FzfHaystack displays[BENCH_WINDOWS];
+    static QueryPlan plan;
+    static QueryPlan fuzzy_first;
+
+    for (int i = 0; i < BENCH_WINDOWS; i++) {
+        char title[128];
+        snprintf(title, sizeof(title), "project %d - issue tracker and review board %d", i, i * 7);
+        windows[i] = make_window(i % 9, classes[i % 5], title, classes[i % 5]);
+        compile_display(&windows[i], &displays[i]);
+    }
+
+    query_plan_parse(&plan, "issue review c:firefox");
+    fuzzy_first = plan;
+    QueryGroup scoped = fuzzy_first.groups[0];
+    fuzzy_first.groups[0] = fuzzy_first.groups[2];
+    fuzzy_first.groups[2] = scoped;
+
+    int cheap_matches = 0;
+    int fuzzy_matches = 0;
+    double cheap = time_plan(&plan, windows, displays, &cheap_matches);
+    double fuzzy = time_plan(&fuzzy_first, windows, displays, &fuzzy_matches);
+    // Timings are reported only; which order wins on a loaded machine is a race
+    printf("  %d windows: class scope first %.0f us, fuzzy first %.0f us\n",
+           BENCH_WINDOWS, cheap, fuzzy);
+    ASSERT_TRUE("either order finds the same windows",
+                cheap_matches == fuzzy_matches && cheap_matches == 20 * BENCH_WINDOWS / 5);
+
+    for (int i = 0; i < BENCH_WINDOWS; i++) fzf_haystack_free(&displays[i]);
+}
+
+int main(void) {
+    test_parse();
+    test_term_kinds();
+    test_scores_add_up();
+    test_benchmark_cheap_terms_first();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
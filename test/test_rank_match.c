@@ -0,0 +1,251 @@
+/*
+ * rank_match: cached multi-field candidates ranked for the tabs.
+ *
+ * Checks that a candidate matches exactly when its joined fields do, that
+ * weighted fields, word starts and initials rank as documented, that
+ * candidates only recompile when their text changes, that ranking orders
+ * by score then position and that refining a typed query ranks like a
+ * fresh pass; then reports the time of cached ranking against building and
+ * matching the joined string on every keystroke.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/constants.h"
+#include "../src/rank_match.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static score_t score_fields(RankCache *cache, const RankField *fields, int count,
+                            const char *query) {
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, query);
+    const RankCandidate *candidate = rank_cache_update(cache, 0, fields, count);
+    return candidate ? rank_candidate_score(&pattern, candidate) : SCORE_MIN;
+}
+
+/* ---- Tests ---- */
+
+static void test_matches_like_joined_text(void) {
+    static const char *words[] = { "kitty", "Firefox", "ctrl+alt+t", "launch terminal",
+                                   "vim", "", "Mozilla", "[2] Main" };
+    static const char *queries[] = { "k", "kf", "fire moz", "ctrlt", "vmoz", "zzz",
+                                     "t t", "2main", "lt" };
+    RankCache cache = {0};
+    int ok = 1;
+    srand(21);
+    for (int round = 0; round < 400; round++) {
+        RankField fields[3];
+        char joined[256] = "";
+        int count = 1 + rand() % 3;
+        for (int f = 0; f < count; f++) {
+            fields[f] = (RankField){ words[rand() % 8], rand() % 300, rand() % 2 };
+            if (f > 0) strcat(joined, " ");
+            strcat(joined, fields[f].text);
+        }
+        const char *query = queries[rand() % 9];
+        int matched = score_fields(&cache, fields, count, query) > SCORE_MIN;
+        ok &= matched == fzf_has_match(query, joined);
+    }
+    ASSERT_TRUE("matches exactly when the joined fields match", ok);
+    rank_cache_cleanup(&cache);
+}
+
+static void test_weights_tokens_and_initials(void) {
+    RankCache cache = {0};
+
+    RankField in_text[] = { { "browser", 200, 1 }, { "open git log", 100, 1 } };
+    RankField in_label[] = { { "git", 200, 1 }, { "status", 100, 1 } };
+    ASSERT_TRUE("heavier field ranks its match higher",
+                score_fields(&cache, in_label, 2, "git") > score_fields(&cache, in_text, 2, "git"));
+
+    RankField inside[] = { { "xterminal", 0, 1 } };
+    RankField word[] = { { "my terminal", 0, 1 } };
+    RankField word_no_bonus[] = { { "my terminal", 0, 0 } };
+    score_t with_bonus = score_fields(&cache, word, 1, "term");
+    ASSERT_TRUE("query starting a word beats one inside a word",
+                with_bonus > score_fields(&cache, inside, 1, "term"));
+    ASSERT_TRUE("token bonus only where the field asks for it",
+                with_bonus == score_fields(&cache, word_no_bonus, 1, "term") + RANK_TOKEN_BONUS);
+
+    RankField person[] = { { "Daniel Dario Lukic", 0, 0 } };
+    ASSERT_TRUE("initials match scores SCORE_INITIALS_MATCH",
+                score_fields(&cache, person, 1, "ddl") == SCORE_INITIALS_MATCH);
+
+    RankField empty[] = { { NULL, 0, 0 } };
+    ASSERT_TRUE("no fields match nothing", score_fields(&cache, empty, 0, "a") == SCORE_MIN);
+    ASSERT_TRUE("NULL field counts as empty", score_fields(&cache, empty, 1, "a") == SCORE_MIN);
+    rank_cache_cleanup(&cache);
+}
+
+static void test_recompiles_only_on_change(void) {
+    RankCache cache = {0};
+    char title[32] = "Firefox";
+    RankField fields[] = { { "1", 200, 0 }, { title, 100, 1 } };
+
+    const RankCandidate *first = rank_cache_update(&cache, 3, fields, 2);
+    uint64_t fingerprint = first ? first->fingerprint : 0;
+    const char *compiled_text = first ? first->text.text : NULL;
+    ASSERT_TRUE("entries below the index start uncompiled",
+                cache.count == 4 && !cache.entries[0].compiled);
+    ASSERT_TRUE("fields are joined by spaces",
+                first && strcmp(first->text.text, "1 firefox") == 0 &&
+                strcmp(first->initials, "1f") == 0);
+
+    const RankCandidate *again = rank_cache_update(&cache, 3, fields, 2);
+    ASSERT_TRUE("same fields keep the compiled candidate",
+                again && again->fingerprint == fingerprint && again->text.text == compiled_text);
+
+    strcpy(title, "Thunderbird");
+    const RankCandidate *changed = rank_cache_update(&cache, 3, fields, 2);
+    ASSERT_TRUE("changed text recompiles",
+                changed && strcmp(changed->text.text, "1 thunderbird") == 0);
+
+    fields[1].weight = 50;
+    changed = rank_cache_update(&cache, 3, fields, 2);
+    ASSERT_TRUE("changed weight recompiles", changed && changed->weights[1] == 50);
+    rank_cache_cleanup(&cache);
+}
+
+static void test_rank_orders_by_score_then_index(void) {
+    static const char *titles[] = { "mail", "gmail", "mail", "terminal", "email client", "mail" };
+    RankCache cache = {0};
+    for (int i = 0; i < 6; i++) {
+        RankField fields[] = { { titles[i], 0, 1 } };
+        rank_cache_update(&cache, i, fields, 1);
+    }
+
+    FzfPattern pattern;
+    fzf_pattern_compile(&pattern, "mail");
+    RankedMatch ranked[6];
+    int matched = rank_cache_rank(&cache, 6, &pattern, 6, ranked);
+    int ordered = matched == 5;
+    for (int i = 1; i < matched; i++) {
+        ordered &= ranked[i - 1].score > ranked[i].score ||
+                   (ranked[i - 1].score == ranked[i].score && ranked[i - 1].index < ranked[i].index);
+    }
+    ASSERT_TRUE("ranked by score, ties by position", ordered);
+    ASSERT_TRUE("equal titles keep list order",
+                ranked[0].index == 0 && ranked[1].index == 2 && ranked[2].index == 5);
+
+    RankedMatch front[6];
+    int front_matched = rank_cache_rank(&cache, 6, &pattern, 2, front);
+    ASSERT_TRUE("top k front agrees with the full ranking",
+                front_matched == matched && front[0].index == ranked[0].index &&
+                front[1].index == ranked[1].index);
+
+    ASSERT_TRUE("only the first count entries are ranked",
+                rank_cache_rank(&cache, 2, &pattern, 2, ranked) == 2);
+    rank_cache_cleanup(&cache);
+}
+
+static void test_refined_pass_matches_fresh_pass(void) {
+    static const char *titles[] = { "Firefox", "Files", "fish shell", "Thunderbird",
+                                    "offline first", "kitty", "fire alarm", "Foot" };
+    static const char *typed[] = { "f", "fi", "fir", "fire", "firef", "fi", "fis", "x" };
+    RankCache typing = {0};
+    int ok = 1;
+    for (int q = 0; q < 8; q++) {
+        RankCache fresh = {0};
+        for (int i = 0; i < 8; i++) {
+            // Retitle one entry mid-typing; it must be scored again
+            const char *title = q >= 3 && i == 5 ? "firefly" : titles[i];
+            RankField fields[] = { { title, 0, 1 } };
+            rank_cache_update(&typing, i, fields, 1);
+            rank_cache_update(&fresh, i, fields, 1);
+        }
+        FzfPattern pattern;
+        fzf_pattern_compile(&pattern, typed[q]);
+        RankedMatch expected[8];
+        RankedMatch ranked[8];
+        int expected_count = rank_cache_rank(&fresh, 8, &pattern, 8, expected);
+        int count = rank_cache_rank(&typing, 8, &pattern, 8, ranked);
+        ok &= count == expected_count;
+        for (int i = 0; i < count && i < expected_count; i++) {
+            ok &= ranked[i].index == expected[i].index && ranked[i].score == expected[i].score;
+        }
+        rank_cache_cleanup(&fresh);
+    }
+    ASSERT_TRUE("typing a query ranks like scoring each prefix afresh", ok);
+    rank_cache_cleanup(&typing);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+#define BENCH_ENTRIES 2000
+
+static void test_benchmark_cached_ranking(void) {
+    static char keys[BENCH_ENTRIES][24];
+    static char commands[BENCH_ENTRIES][64];
+    static RankedMatch ranked[BENCH_ENTRIES];
+    static const char *programs[] = { "kitty", "alacritty", "firefox", "thunderbird",
+                                      "nautilus", "pavucontrol", "gimp", "emacs" };
+    // Typing one query, a key at a time
+    static const char *queries[] = { "f", "fi", "fir", "fire", "firef" };
+    RankCache cache = {0};
+    for (int i = 0; i < BENCH_ENTRIES; i++) {
+        snprintf(keys[i], sizeof(keys[i]), "mod+shift+%c%d", 'a' + i % 26, i);
+        snprintf(commands[i], sizeof(commands[i]), "launch %s --name slot%d",
+                 programs[i % 8], i);
+    }
+
+    double cached = 1e9;
+    double rebuilt = 1e9;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        for (int q = 0; q < 5; q++) {
+            for (int i = 0; i < BENCH_ENTRIES; i++) {
+                RankField fields[] = { { keys[i], 200, 1 }, { commands[i], 100, 1 } };
+                rank_cache_update(&cache, i, fields, 2);
+            }
+            FzfPattern pattern;
+            fzf_pattern_compile(&pattern, queries[q]);
+            rank_cache_rank(&cache, BENCH_ENTRIES, &pattern, BENCH_ENTRIES, ranked);
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed < cached) cached = elapsed;
+
+        // What every keystroke used to cost: build, lowercase and scan the
+        // joined string (and that only filtered, without ranking)
+        start = now_seconds();
+        int matches = 0;
+        for (int q = 0; q < 5; q++) {
+            for (int i = 0; i < BENCH_ENTRIES; i++) {
+                char searchable[128];
+                snprintf(searchable, sizeof(searchable), "%s %s", keys[i], commands[i]);
+                matches += fzf_fuzzy_match(queries[q], searchable) > SCORE_MIN;
+            }
+        }
+        elapsed = now_seconds() - start;
+        if (elapsed < rebuilt && matches > 0) rebuilt = elapsed;
+    }
+    // Reported only; comparing wall-clock times in a unit test is a race
+    printf("  %d entries: rebuilt %.0f us/query, cached+ranked %.0f us/query\n",
+           BENCH_ENTRIES, rebuilt * 1e6 / 5, cached * 1e6 / 5);
+    rank_cache_cleanup(&cache);
+}
+
+int main(void) {
+    test_matches_like_joined_text();
+    test_weights_tokens_and_initials();
+    test_recompiles_only_on_change();
+    test_rank_orders_by_score_then_index();
+    test_refined_pass_matches_fresh_pass();
+    test_benchmark_cached_ranking();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * render_fingerprint: skipping frames that would paint what is on screen.
+ *
+ * Frames here hash a window list the way update_display() hashes the
+ * windows tab: the rows on screen, the selection and the scroll offset.
+ * Checks that repeating a frame is skipped and counted, that a change on a
+ * row off screen is skipped while one on screen paints, that selection and
+ * scrolling paint, and that an overwritten buffer always paints again.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/render_fingerprint.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+#define ROW_COUNT 100
+#define VISIBLE_ROWS 20
+
+static char titles[ROW_COUNT][32];
+
+static uint64_t frame(int selected, int scroll_offset) {
+    uint64_t h = RENDER_FINGERPRINT_SEED;
+    h = render_fingerprint_int(h, selected);
+    h = render_fingerprint_int(h, scroll_offset);
+    for (int i = scroll_offset; i < scroll_offset + VISIBLE_ROWS && i < ROW_COUNT; i++) {
+        h = render_fingerprint_int(h, 0x1000 + i);
+        h = render_fingerprint_string(h, titles[i]);
+    }
+    return h;
+}
+
+static bool paint(RenderFingerprint *state, int selected, int scroll_offset) {
+    return !render_fingerprint_unchanged(state, frame(selected, scroll_offset));
+}
+
+/* ---- Tests ---- */
+
+static void test_strings_hash_their_end(void) {
+    uint64_t ab_c = render_fingerprint_string(render_fingerprint_string(RENDER_FINGERPRINT_SEED, "ab"), "c");
+    uint64_t a_bc = render_fingerprint_string(render_fingerprint_string(RENDER_FINGERPRINT_SEED, "a"), "bc");
+    ASSERT_TRUE("moving text between fields changes the hash", ab_c != a_bc);
+    ASSERT_TRUE("NULL hashes like an empty string",
+                render_fingerprint_string(RENDER_FINGERPRINT_SEED, NULL) ==
+                render_fingerprint_string(RENDER_FINGERPRINT_SEED, ""));
+}
+
+static void test_repeated_frames_are_skipped(void) {
+    RenderFingerprint state = {0};
+    for (int i = 0; i < ROW_COUNT; i++) snprintf(titles[i], sizeof(titles[i]), "window %d", i);
+
+    ASSERT_TRUE("first frame paints", paint(&state, 0, 0));
+    ASSERT_TRUE("same frame again is skipped", !paint(&state, 0, 0));
+    ASSERT_TRUE("counters: one painted, one skipped", state.performed == 1 && state.skipped == 1);
+
+    strcpy(titles[50], "window 50 - renamed");
+    ASSERT_TRUE("title change off screen is skipped", !paint(&state, 0, 0));
+    strcpy(titles[5], "window 5 - renamed");
+    ASSERT_TRUE("title change on screen paints", paint(&state, 0, 0));
+
+    ASSERT_TRUE("moving the selection paints", paint(&state, 1, 0));
+    ASSERT_TRUE("scrolling paints", paint(&state, 1, 1));
+    ASSERT_TRUE("scrolling back paints", paint(&state, 1, 0));
+    ASSERT_TRUE("counters add up", state.performed == 5 && state.skipped == 2);
+}
+
+static void test_invalidate_forces_paint(void) {
+    RenderFingerprint state = {0};
+    paint(&state, 0, 0);
+
+    render_fingerprint_invalidate(&state);
+    ASSERT_TRUE("frame after an overwrite paints", paint(&state, 0, 0));
+    ASSERT_TRUE("and the one after that is skipped", !paint(&state, 0, 0));
+}
+
+int main(void) {
+    test_strings_hash_their_end();
+    test_repeated_frames_are_skipped();
+    test_invalidate_forces_paint();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
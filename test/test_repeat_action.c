@@ -60,6 +60,7 @@ WindowInfo *get_selected_window(AppData *app) {
 
 static void reset_state(AppData *app) {
     memset(app, 0, sizeof(*app));
+    ensure_window_capacity(app, 16);
     activate_calls  = 0;
     last_activated  = 0;
     hide_calls      = 0;
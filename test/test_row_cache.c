@@ -0,0 +1,115 @@
+/*
+ * row_cache: formatted windows tab rows, kept per window across frames.
+ *
+ * Rows are stand-in strings here. Checks that a row is found only for the
+ * key it was formatted for (content fingerprint, harpoon slot, shown ID),
+ * that forgetting a window keeps the other rows reachable after the
+ * swap-remove, and that repeating a frame of 40 rows formats none of them
+ * while a title change formats only its own row.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/row_cache.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static void format_row(CachedRow *row, const char *text) {
+    row->len = snprintf(row->line, sizeof(row->line), "%s", text);
+    row->match_start = 0;
+    row->match_len = row->len;
+}
+
+// Draw rows for windows 0x100.. through the cache like render_windows_item();
+// returns how many had to be formatted
+static int draw_frame(RowCache *cache, const uint64_t *fingerprints, int count) {
+    unsigned misses = cache->misses;
+    for (int i = 0; i < count; i++) {
+        Window id = 0x100 + (Window)i;
+        uint64_t key = row_cache_key(fingerprints[i], -1, id);
+        if (!row_cache_lookup(cache, id, key)) {
+            char text[32];
+            snprintf(text, sizeof(text), "window %d", i);
+            format_row(row_cache_store(cache, id, key), text);
+        }
+    }
+    return (int)(cache->misses - misses);
+}
+
+/* ---- Tests ---- */
+
+static void test_rows_match_their_key(void) {
+    RowCache cache = {0};
+    uint64_t key = row_cache_key(42, -1, 0x100);
+    ASSERT_TRUE("unknown window misses", !row_cache_lookup(&cache, 0x100, key) && cache.misses == 1);
+
+    format_row(row_cache_store(&cache, 0x100, key), "[1] kitty  shell");
+    const CachedRow *row = row_cache_lookup(&cache, 0x100, key);
+    ASSERT_TRUE("stored row is found", row && strcmp(row->line, "[1] kitty  shell") == 0 &&
+                                       cache.hits == 1);
+
+    ASSERT_TRUE("changed content misses", !row_cache_lookup(&cache, 0x100, row_cache_key(43, -1, 0x100)));
+    ASSERT_TRUE("harpoon slot misses", !row_cache_lookup(&cache, 0x100, row_cache_key(42, 3, 0x100)));
+    ASSERT_TRUE("shown ID misses", !row_cache_lookup(&cache, 0x100, row_cache_key(42, -1, 0x200)));
+    ASSERT_TRUE("other window misses", !row_cache_lookup(&cache, 0x200, key));
+
+    format_row(row_cache_store(&cache, 0x100, row_cache_key(42, 3, 0x100)), "3 [1] kitty  shell");
+    ASSERT_TRUE("storing again reuses the entry", cache.count == 1 &&
+                row_cache_lookup(&cache, 0x100, row_cache_key(42, 3, 0x100)) &&
+                !row_cache_lookup(&cache, 0x100, key));
+    row_cache_cleanup(&cache);
+}
+
+static void test_forget_keeps_other_rows(void) {
+    RowCache cache = {0};
+    for (Window id = 1; id <= 5; id++) {
+        char text[16];
+        snprintf(text, sizeof(text), "row %lu", id);
+        format_row(row_cache_store(&cache, id, row_cache_key(id, -1, id)), text);
+    }
+
+    row_cache_forget(&cache, 2);
+    row_cache_forget(&cache, 99);
+    ASSERT_TRUE("forgotten window is gone", cache.count == 4 &&
+                !row_cache_lookup(&cache, 2, row_cache_key(2, -1, 2)));
+
+    int found = 0;
+    for (Window id = 1; id <= 5; id++) {
+        const CachedRow *row = row_cache_lookup(&cache, id, row_cache_key(id, -1, id));
+        char text[16];
+        snprintf(text, sizeof(text), "row %lu", id);
+        if (row && strcmp(row->line, text) == 0) found++;
+    }
+    ASSERT_TRUE("other rows still found with their text", found == 4);
+    row_cache_cleanup(&cache);
+}
+
+static void test_frames_format_changed_rows_only(void) {
+    RowCache cache = {0};
+    uint64_t fingerprints[40];
+    for (int i = 0; i < 40; i++) fingerprints[i] = 1000 + (uint64_t)i;
+
+    ASSERT_TRUE("first frame formats every row", draw_frame(&cache, fingerprints, 40) == 40);
+    ASSERT_TRUE("same frame formats nothing", draw_frame(&cache, fingerprints, 40) == 0);
+
+    fingerprints[7] = 7777;
+    ASSERT_TRUE("a title change formats its row", draw_frame(&cache, fingerprints, 40) == 1);
+    ASSERT_TRUE("one row per window", cache.count == 40);
+    row_cache_cleanup(&cache);
+}
+
+int main(void) {
+    test_rows_match_their_key();
+    test_forget_keeps_other_rows();
+    test_frames_format_changed_rows_only();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -97,6 +97,7 @@ static void test_enter_run_mode_keeps_entry_without_prefix(void) {
 
 static void test_exit_run_mode_is_noop_when_already_normal(void) {
     AppData app = {0};
+    ensure_window_capacity(&app, 16);
     int before_filtered_count;
     int before_window_index;
     Window before_selected_window_id;
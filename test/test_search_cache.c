@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/search_cache.h"
+#include "../src/log.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static WindowInfo make_window(Window id, const char *title, const char *class_name, int desktop) {
+    WindowInfo win;
+    memset(&win, 0, sizeof(win));
+    win.id = id;
+    snprintf(win.title, sizeof(win.title), "%s", title);
+    snprintf(win.class_name, sizeof(win.class_name), "%s", class_name);
+    snprintf(win.instance, sizeof(win.instance), "%s", class_name);
+    win.desktop = desktop;
+    return win;
+}
+
+static void test_fingerprint_tracks_displayed_fields(void) {
+    WindowInfo win = make_window(0x100, "Terminal", "kitty", 0);
+    uint64_t base = search_key_fingerprint(&win);
+
+    WindowInfo other = win;
+    other.pid = 4242;
+    other.state = 1;
+    ASSERT_TRUE("fields outside the display string do not matter",
+                search_key_fingerprint(&other) == base);
+
+    other = win;
+    snprintf(other.title, sizeof(other.title), "Terminal - vim");
+    ASSERT_TRUE("title change changes the fingerprint", search_key_fingerprint(&other) != base);
+
+    other = win;
+    other.desktop = 1;
+    ASSERT_TRUE("desktop change changes the fingerprint", search_key_fingerprint(&other) != base);
+
+    other = win;
+    snprintf(other.class_name, sizeof(other.class_name), "alacritty");
+    ASSERT_TRUE("class change changes the fingerprint", search_key_fingerprint(&other) != base);
+
+    // Field borders count: moving text between fields is a change
+    WindowInfo a = make_window(0x100, "ab", "c", 0);
+    WindowInfo b = make_window(0x100, "a", "bc", 0);
+    snprintf(b.instance, sizeof(b.instance), "c");
+    ASSERT_TRUE("field borders are hashed", search_key_fingerprint(&a) != search_key_fingerprint(&b));
+}
+
+static void test_store_and_lookup(void) {
+    SearchCache cache;
+    init_search_cache(&cache);
+
+    ASSERT_TRUE("empty cache misses", search_cache_lookup(&cache, 0x100, 1) == NULL);
+
+    const SearchKey *key = search_cache_store(&cache, 0x100, 1, "[1] kitty Daniel Dario-Lukic kitty");
+    ASSERT_TRUE("store returns the key", key != NULL && key->id == 0x100);
+    ASSERT_TRUE("haystack is lowercased",
+                key && strcmp(key->haystack.text, "[1] kitty daniel dario-lukic kitty") == 0);
+    ASSERT_TRUE("initials are the lowercased word starts",
+                key && strcmp(key->initials, "[kddlk") == 0);
+
+    ASSERT_TRUE("same fingerprint hits", search_cache_lookup(&cache, 0x100, 1) == key);
+    ASSERT_TRUE("new fingerprint misses", search_cache_lookup(&cache, 0x100, 2) == NULL);
+
+    key = search_cache_store(&cache, 0x100, 2, "[1] kitty vim kitty");
+    ASSERT_TRUE("recompiling replaces in place", cache.count == 1 &&
+                strcmp(key->haystack.text, "[1] kitty vim kitty") == 0 &&
+                search_cache_lookup(&cache, 0x100, 2) == key);
+
+    cleanup_search_cache(&cache);
+    ASSERT_TRUE("cleanup empties", cache.count == 0 && cache.entries == NULL);
+}
+
+static void test_forget_keeps_index_in_sync(void) {
+    SearchCache cache;
+    init_search_cache(&cache);
+
+    search_cache_store(&cache, 0x100, 1, "one");
+    search_cache_store(&cache, 0x200, 2, "two");
+    search_cache_store(&cache, 0x300, 3, "three");
+
+    search_cache_forget(&cache, 0x100);
+    ASSERT_TRUE("forgotten window misses", search_cache_lookup(&cache, 0x100, 1) == NULL);
+
+    const SearchKey *moved = search_cache_lookup(&cache, 0x300, 3);
+    ASSERT_TRUE("swapped entry still found", moved != NULL && strcmp(moved->haystack.text, "three") == 0);
+    ASSERT_TRUE("other entry still found", search_cache_lookup(&cache, 0x200, 2) != NULL);
+    ASSERT_TRUE("count drops", cache.count == 2);
+
+    search_cache_forget(&cache, 0x999);
+    ASSERT_TRUE("forgetting an unknown window is a no-op", cache.count == 2);
+
+    cleanup_search_cache(&cache);
+}
+
+int main(void) {
+    log_set_quiet(true);
+
+    test_fingerprint_tracks_displayed_fields();
+    test_store_and_lookup();
+    test_forget_keeps_index_in_sync();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
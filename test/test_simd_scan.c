@@ -0,0 +1,216 @@
+/*
+ * simd_find_either(): vectorized subsequence prefilter.
+ *
+ * Checks has_match() and fzf_has_match() against the byte-at-a-time
+ * versions they replaced (kept below as references) over random strings at
+ * every alignment, strings ending right before an unmapped page, and a
+ * title corpus; then reports the timing of both over that corpus.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/fzf_algo.h"
+#include "../src/match.h"
+#include "../src/simd_scan.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- References: the scans this replaced ---- */
+
+static char *reference_strcasechr(const char *s, char c) {
+    const char accept[3] = {c, toupper(c), 0};
+    return strpbrk(s, accept);
+}
+
+static int reference_has_match(const char *needle, const char *haystack) {
+    while (*needle) {
+        char nch = *needle++;
+        if (!(haystack = reference_strcasechr(haystack, nch))) return 0;
+        haystack++;
+    }
+    return 1;
+}
+
+static int reference_fzf_has_match(const char *needle, const char *haystack) {
+    if (!needle || !needle[0]) return 1;
+    if (!haystack) return 0;
+
+    for (const char *np = needle; *np; np++) {
+        char nc = tolower((unsigned char)*np);
+        while (*haystack) {
+            if (tolower((unsigned char)*haystack) == nc) {
+                haystack++;
+                goto next_char;
+            }
+            haystack++;
+        }
+        return 0;
+next_char:;
+    }
+    return 1;
+}
+
+/* ---- Corpus ---- */
+
+#define CORPUS_SIZE 20000
+
+static const char *words[] = {
+    "kitty", "Firefox", "Mozilla", "zsh", "~/projects/cofi", "vim", "src/filter.c",
+    "Google", "Chrome", "YouTube", "Slack", "#general", "Code", "Visual", "Studio",
+    "Thunar", "Downloads", "Terminal", "htop", "GitKraken", "Twitch", "Spotify",
+    "Release", "Notes", "-", "|", "(2)", "[S]", "Über", "café", "README.md",
+};
+
+static char corpus[CORPUS_SIZE][256];
+
+static void build_corpus(void) {
+    srand(4242);
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        int n = snprintf(corpus[i], sizeof(corpus[i]), "[%d]", rand() % 9 + 1);
+        int word_count = 3 + rand() % 12;
+        for (int w = 0; w < word_count && n < 200; w++) {
+            n += snprintf(corpus[i] + n, sizeof(corpus[i]) - (size_t)n, " %s",
+                          words[rand() % (int)(sizeof(words) / sizeof(words[0]))]);
+        }
+    }
+}
+
+static const char *queries[] = {
+    "fire", "ffx", "kitty", "KITTY", "Kitty", "cofi", "fil", "gk", "zz", "q",
+    "src/", "yt", "üb", "caf", "notes release", "ddl", "slack general", "x",
+};
+#define QUERY_COUNT (int)(sizeof(queries) / sizeof(queries[0]))
+
+/* ---- Tests ---- */
+
+static void test_find_either_every_alignment(void) {
+    // Random bytes (including high ones) at every offset within a block
+    static char buffer[64 + 300];
+    int ok = 1;
+    srand(7);
+    for (int round = 0; round < 2000 && ok; round++) {
+        int offset = rand() % 64;
+        int len = rand() % 300;
+        char *s = buffer + offset;
+        for (int i = 0; i < len; i++) {
+            char c;
+            do { c = (char)(rand() % 256); } while (c == '\0');
+            s[i] = c;
+        }
+        s[len] = '\0';
+
+        char a = (char)(1 + rand() % 255);
+        char b = rand() % 2 ? a : (char)(1 + rand() % 255);
+        const char *expected = NULL;
+        for (const char *p = s; *p; p++) {
+            if (*p == a || *p == b) { expected = p; break; }
+        }
+        ok &= simd_find_either(s, a, b) == expected;
+    }
+    ASSERT_TRUE("finds the same byte as a plain scan at every alignment", ok);
+}
+
+static void test_find_either_stops_at_page_end(void) {
+    // String ending in the last byte of a page followed by an unmapped one
+    long page = sysconf(_SC_PAGESIZE);
+    char *map = mmap(NULL, (size_t)page * 2, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_TRUE("guard page mapped", map != MAP_FAILED);
+    if (map == MAP_FAILED) return;
+    mprotect(map + page, (size_t)page, PROT_NONE);
+
+    int ok = 1;
+    for (int len = 0; len < 70; len++) {
+        char *s = map + page - 1 - len;
+        memset(s, 'a', (size_t)len);
+        s[len] = '\0';
+        ok &= simd_find_either(s, 'z', 'Z') == NULL;
+        ok &= len == 0 || simd_find_either(s, 'a', 'a') == s;
+    }
+    ASSERT_TRUE("never reads past the block holding the terminator", ok);
+    munmap(map, (size_t)page * 2);
+}
+
+static void test_has_match_identical_to_reference(void) {
+    int ok_has = 1;
+    int ok_fzf = 1;
+    int matches = 0;
+    for (int i = 0; i < CORPUS_SIZE; i++) {
+        for (int q = 0; q < QUERY_COUNT; q++) {
+            int expected = reference_has_match(queries[q], corpus[i]);
+            ok_has &= has_match(queries[q], corpus[i]) == expected;
+            ok_fzf &= fzf_has_match(queries[q], corpus[i]) ==
+                      reference_fzf_has_match(queries[q], corpus[i]);
+            matches += expected;
+        }
+    }
+    printf("  %d of %d pairs match\n", matches, CORPUS_SIZE * QUERY_COUNT);
+    ASSERT_TRUE("has_match agrees with the strpbrk version", ok_has);
+    ASSERT_TRUE("fzf_has_match agrees with the tolower version", ok_fzf);
+
+    // Asymmetric case rule of has_match: uppercase needle chars are exact
+    ASSERT_TRUE("lowercase needle matches uppercase", has_match("fire", "FIREFOX"));
+    ASSERT_TRUE("uppercase needle does not match lowercase", !has_match("FIRE", "firefox"));
+    ASSERT_TRUE("fzf_has_match folds both ways", fzf_has_match("FIRE", "firefox"));
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef int (*MatchFn)(const char *needle, const char *haystack);
+
+// Best-of-5 time for every query against the whole corpus
+static double time_corpus(MatchFn fn) {
+    double best = 1e9;
+    volatile int sink = 0;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        for (int q = 0; q < QUERY_COUNT; q++) {
+            for (int i = 0; i < CORPUS_SIZE; i++) sink += fn(queries[q], corpus[i]);
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    (void)sink;
+    return best;
+}
+
+static void test_benchmark_corpus(void) {
+    double has_before = time_corpus(reference_has_match);
+    double has_after = time_corpus(has_match);
+    double fzf_before = time_corpus(reference_fzf_has_match);
+    double fzf_after = time_corpus(fzf_has_match);
+    double pairs = (double)CORPUS_SIZE * QUERY_COUNT;
+
+    printf("  backend: %s\n", simd_scan_backend());
+    printf("  has_match:     %.1f -> %.1f ns/pair\n", has_before * 1e9 / pairs, has_after * 1e9 / pairs);
+    printf("  fzf_has_match: %.1f -> %.1f ns/pair\n", fzf_before * 1e9 / pairs, fzf_after * 1e9 / pairs);
+    // Reported only; timings on a loaded machine would make this flaky
+}
+
+int main(void) {
+    build_corpus();
+
+    test_find_either_every_alignment();
+    test_find_either_stops_at_page_end();
+    test_has_match_identical_to_reference();
+    test_benchmark_corpus();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -108,6 +108,15 @@ gboolean path_binaries_is_scanning(void) {
     return FALSE;
 }
 
+void path_binaries_cancel_filter(void) {
+}
+
+void path_binaries_filter_async(AppData *app, const char *query, gint64 keystroke_us) {
+    (void)app;
+    (void)query;
+    (void)keystroke_us;
+}
+
 void dispatch_hotkey_mode(AppData *app, ShowMode mode) {
     (void)app;
     (void)mode;
@@ -207,6 +216,10 @@ void show_window(AppData *app) {
     show_window_calls++;
 }
 
+void warm_show_mark_request(AppData *app) {
+    (void)app;
+}
+
 void enter_command_mode(AppData *app) {
     (void)app;
 }
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/title_throttle.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+#define T0 1000000000LL
+#define INTERVAL TITLE_THROTTLE_INTERVAL_US
+
+static TitleThrottle throttle;
+
+static void test_leading_edge_passes(void) {
+    init_title_throttle(&throttle);
+
+    ASSERT_TRUE("first title change refetches now", title_throttle_event(&throttle, 0x10, T0));
+    ASSERT_TRUE("nothing deferred after a single change", title_throttle_next_due(&throttle) == 0);
+    ASSERT_TRUE("change after the interval refetches now",
+                title_throttle_event(&throttle, 0x10, T0 + INTERVAL));
+    ASSERT_TRUE("other windows are independent", title_throttle_event(&throttle, 0x20, T0 + INTERVAL));
+}
+
+static void test_trailing_edge_delivers_final_title(void) {
+    init_title_throttle(&throttle);
+    Window due[8];
+
+    title_throttle_event(&throttle, 0x10, T0);
+    ASSERT_TRUE("change inside the interval is deferred",
+                !title_throttle_event(&throttle, 0x10, T0 + 1000));
+    ASSERT_TRUE("further changes stay deferred",
+                !title_throttle_event(&throttle, 0x10, T0 + 2000));
+    ASSERT_TRUE("deferred title due at the end of the interval",
+                title_throttle_next_due(&throttle) == T0 + INTERVAL);
+
+    ASSERT_TRUE("nothing due before the interval ends",
+                title_throttle_collect_due(&throttle, T0 + INTERVAL - 1, due, 8) == 0);
+    int n = title_throttle_collect_due(&throttle, T0 + INTERVAL, due, 8);
+    ASSERT_TRUE("deferred title delivered once", n == 1 && due[0] == 0x10);
+    ASSERT_TRUE("delivered title no longer pending", title_throttle_next_due(&throttle) == 0);
+
+    ASSERT_TRUE("change right after trailing delivery is deferred again",
+                !title_throttle_event(&throttle, 0x10, T0 + INTERVAL + 10));
+}
+
+static void test_collect_all_ignores_interval(void) {
+    init_title_throttle(&throttle);
+    Window due[8];
+
+    title_throttle_event(&throttle, 0x10, T0);
+    title_throttle_event(&throttle, 0x10, T0 + 1);
+    title_throttle_event(&throttle, 0x20, T0);
+    title_throttle_event(&throttle, 0x20, T0 + 1);
+
+    int n = title_throttle_collect_all(&throttle, T0 + 2, due, 8);
+    ASSERT_TRUE("collect_all takes every deferred title", n == 2);
+    ASSERT_TRUE("nothing left pending", title_throttle_next_due(&throttle) == 0);
+}
+
+static void test_forget_drops_window(void) {
+    init_title_throttle(&throttle);
+    Window due[8];
+
+    title_throttle_event(&throttle, 0x10, T0);
+    title_throttle_event(&throttle, 0x10, T0 + 1);
+    title_throttle_forget(&throttle, 0x10);
+
+    ASSERT_TRUE("forgotten window has no deferred title",
+                title_throttle_collect_all(&throttle, T0 + 2, due, 8) == 0);
+    ASSERT_TRUE("forgotten window starts fresh", title_throttle_event(&throttle, 0x10, T0 + 3));
+}
+
+static void test_rate_stats_rank_noisy_windows(void) {
+    init_title_throttle(&throttle);
+
+    // 0x10 changes its title 50 times a second, 0x20 twice
+    for (int i = 0; i <= 100; i++) {
+        title_throttle_event(&throttle, 0x10, T0 + (gint64)i * 20000);
+    }
+    for (int i = 0; i <= 4; i++) {
+        title_throttle_event(&throttle, 0x20, T0 + (gint64)i * 500000);
+    }
+
+    TitleThrottleEntry stats[4];
+    int n = title_throttle_stats(&throttle, stats, 4);
+    ASSERT_TRUE("stats cover both windows", n == 2);
+    ASSERT_TRUE("noisiest window first", stats[0].id == 0x10);
+    ASSERT_TRUE("noisy rate measured", stats[0].events_per_sec >= 45.0 &&
+                stats[0].events_per_sec <= 55.0);
+    ASSERT_TRUE("noisy window reported", stats[0].reported);
+    ASSERT_TRUE("quiet window not reported", !stats[1].reported);
+    ASSERT_TRUE("events counted", stats[0].events == 101);
+    ASSERT_TRUE("refetches capped by the interval",
+                stats[0].deliveries <= 2000000 / INTERVAL + 1);
+}
+
+int main(void) {
+    test_leading_edge_passes();
+    test_trailing_edge_delivers_final_title();
+    test_collect_all_ignores_interval();
+    test_forget_drops_window();
+    test_rate_stats_rank_noisy_windows();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
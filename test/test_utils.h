@@ -7,8 +7,8 @@
 #include "../src/app_data.h"
 
 // Test result tracking
-static int tests_run = 0;
-static int tests_passed = 0;
+static int tests_run __attribute__((unused)) = 0;
+static int tests_passed __attribute__((unused)) = 0;
 
 // Assertion macros
 #define ASSERT(condition, message) do { \
@@ -75,10 +75,27 @@ static inline WindowInfo create_test_window(Window id, const char *title, const
     return win;
 }
 
+// Fixed backing store for the window tables (AppData only holds pointers),
+// for tests that do not link window_store
+#define TEST_WINDOW_CAPACITY 16
+static WindowInfo test_windows[TEST_WINDOW_CAPACITY] __attribute__((unused));
+static Window test_history[TEST_WINDOW_CAPACITY] __attribute__((unused));
+static WindowInfo test_filtered[TEST_WINDOW_CAPACITY] __attribute__((unused));
+
+static inline void attach_window_tables(AppData *app) {
+    memset(test_windows, 0, sizeof(test_windows));
+    memset(test_history, 0, sizeof(test_history));
+    memset(test_filtered, 0, sizeof(test_filtered));
+    app->windows = test_windows;
+    app->history = test_history;
+    app->filtered = test_filtered;
+    app->window_capacity = TEST_WINDOW_CAPACITY;
+}
+
 // AppData initialization helper
 static inline void init_test_app_data(AppData *app) {
     memset(app, 0, sizeof(AppData));
-    app->selected_index = 0;
+    ensure_window_capacity(app, WINDOW_STORE_MIN_CAPACITY);
     app->window_count = 0;
     app->history_count = 0;
     app->filtered_count = 0;
@@ -87,7 +104,7 @@ static inline void init_test_app_data(AppData *app) {
 
 // Add windows to app data
 static inline void add_test_window(AppData *app, WindowInfo win) {
-    if (app->window_count < MAX_WINDOWS) {
+    if (ensure_window_capacity(app, app->window_count + 1)) {
         app->windows[app->window_count] = win;
         app->window_count++;
     }
@@ -95,8 +112,8 @@ static inline void add_test_window(AppData *app, WindowInfo win) {
 
 // Add windows to history
 static inline void add_history_window(AppData *app, WindowInfo win) {
-    if (app->history_count < MAX_WINDOWS) {
-        app->history[app->history_count] = win;
+    if (ensure_window_capacity(app, app->history_count + 1)) {
+        app->history[app->history_count] = win.id;
         app->history_count++;
     }
 }
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/app_data.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static int reset_selection_calls = 0;
+static int filter_windows_calls = 0;
+static int update_display_calls = 0;
+static int idle_add_calls = 0;
+static char last_filter[64];
+static GSourceFunc pending_idle = NULL;
+static gpointer pending_idle_data = NULL;
+
+void reset_selection(AppData *app) {
+    (void)app;
+    reset_selection_calls++;
+}
+
+void filter_windows(AppData *app, const char *filter) {
+    (void)app;
+    filter_windows_calls++;
+    strncpy(last_filter, filter, sizeof(last_filter) - 1);
+    last_filter[sizeof(last_filter) - 1] = '\0';
+}
+
+void update_display(AppData *app) {
+    (void)app;
+    update_display_calls++;
+}
+
+guint g_idle_add(GSourceFunc function, gpointer data) {
+    idle_add_calls++;
+    pending_idle = function;
+    pending_idle_data = data;
+    return 42;
+}
+
+gboolean g_source_remove(guint tag) {
+    (void)tag;
+    pending_idle = NULL;
+    return TRUE;
+}
+
+gulong g_signal_connect_data(gpointer instance, const gchar *signal, GCallback handler,
+                             gpointer data, GClosureNotify destroy, GConnectFlags flags) {
+    (void)instance;
+    (void)signal;
+    (void)handler;
+    (void)data;
+    (void)destroy;
+    (void)flags;
+    return 7;
+}
+
+#include "../src/warm_show.c"
+
+static void reset_mocks(void) {
+    reset_selection_calls = 0;
+    filter_windows_calls = 0;
+    update_display_calls = 0;
+    idle_add_calls = 0;
+    last_filter[0] = '\0';
+    pending_idle = NULL;
+    pending_idle_data = NULL;
+}
+
+static void run_pending_idle(void) {
+    GSourceFunc fn = pending_idle;
+    pending_idle = NULL;
+    if (fn) {
+        fn(pending_idle_data);
+    }
+}
+
+static void make_hidden_app(AppData *app) {
+    memset(app, 0, sizeof(*app));
+    app->window = (GtkWidget *)0x1;
+    app->textview = (GtkWidget *)0x2;
+    app->textbuffer = (GtkTextBuffer *)0x3;
+    app->current_tab = TAB_WINDOWS;
+    app->command_mode.state = CMD_MODE_NORMAL;
+    app->fixed_cols = 80;
+    app->fixed_rows = 20;
+    init_warm_show_state(&app->warm_show);
+}
+
+static void test_prepare_renders_hidden_window(void) {
+    static AppData app;
+    make_hidden_app(&app);
+    reset_mocks();
+
+    ASSERT_TRUE("not ready before prepare", !warm_show_is_ready(&app));
+    ASSERT_TRUE("prepare succeeds when hidden and sized", warm_show_prepare(&app));
+    ASSERT_TRUE("prepare resets selection", reset_selection_calls == 1);
+    ASSERT_TRUE("prepare filters with empty query",
+                filter_windows_calls == 1 && strcmp(last_filter, "") == 0);
+    ASSERT_TRUE("prepare renders", update_display_calls == 1);
+    ASSERT_TRUE("ready after prepare", warm_show_is_ready(&app));
+
+    warm_show_prepare(&app);
+    ASSERT_TRUE("second prepare is a no-op", filter_windows_calls == 1);
+
+    app.current_tab = TAB_HARPOON;
+    ASSERT_TRUE("not ready on another tab", !warm_show_is_ready(&app));
+}
+
+static void test_prepare_preconditions(void) {
+    static AppData app;
+
+    make_hidden_app(&app);
+    reset_mocks();
+    app.fixed_cols = 0;
+    ASSERT_TRUE("no prepare before fixed sizing", !warm_show_prepare(&app));
+
+    make_hidden_app(&app);
+    app.window_visible = TRUE;
+    ASSERT_TRUE("no prepare while visible", !warm_show_prepare(&app));
+
+    make_hidden_app(&app);
+    app.command_mode.state = CMD_MODE_COMMAND;
+    ASSERT_TRUE("no prepare in command mode", !warm_show_prepare(&app));
+
+    ASSERT_TRUE("nothing filtered", filter_windows_calls == 0);
+}
+
+static void test_invalidate_schedules_one_prepare(void) {
+    static AppData app;
+    make_hidden_app(&app);
+    reset_mocks();
+
+    warm_show_prepare(&app);
+    warm_show_invalidate(&app);
+    warm_show_invalidate(&app);
+    ASSERT_TRUE("invalidate drops ready", !warm_show_is_ready(&app));
+    ASSERT_TRUE("repeated invalidations coalesce into one idle", idle_add_calls == 1);
+
+    run_pending_idle();
+    ASSERT_TRUE("idle prepare re-renders", filter_windows_calls == 2 && update_display_calls == 2);
+    ASSERT_TRUE("ready again after idle", warm_show_is_ready(&app));
+
+    reset_mocks();
+    app.window_visible = TRUE;
+    warm_show_invalidate(&app);
+    ASSERT_TRUE("visible window schedules no prepare", idle_add_calls == 0);
+    ASSERT_TRUE("visible invalidate still drops ready", !warm_show_is_ready(&app));
+}
+
+static void test_first_paint_measurement(void) {
+    static AppData app;
+    make_hidden_app(&app);
+    reset_mocks();
+
+    warm_show_mark_request(&app);
+    ASSERT_TRUE("hidden show request is timed", app.warm_show.request_time_us != 0);
+
+    // Pretend the request happened long ago so the paint is over budget
+    app.warm_show.request_time_us -= WARM_SHOW_PAINT_BUDGET_US * 4;
+    warm_show_mark_path(&app, TRUE);
+    app.window_visible = TRUE;
+    on_textview_draw_after(NULL, NULL, &app);
+
+    ASSERT_TRUE("paint counted", app.warm_show.shows == 1 && app.warm_show.warm_shows == 1);
+    ASSERT_TRUE("slow paint counted over budget", app.warm_show.over_budget == 1);
+    ASSERT_TRUE("latency recorded", app.warm_show.last_paint_us >= WARM_SHOW_PAINT_BUDGET_US * 4 &&
+                app.warm_show.max_paint_us == app.warm_show.last_paint_us);
+    ASSERT_TRUE("request consumed", app.warm_show.request_time_us == 0);
+
+    on_textview_draw_after(NULL, NULL, &app);
+    ASSERT_TRUE("later draws are not first paints", app.warm_show.shows == 1);
+
+    warm_show_mark_request(&app);
+    ASSERT_TRUE("request while visible is ignored", app.warm_show.request_time_us == 0);
+
+    app.window_visible = FALSE;
+    warm_show_mark_request(&app);
+    warm_show_cancel_request(&app);
+    ASSERT_TRUE("cancelled request is dropped", app.warm_show.request_time_us == 0);
+}
+
+int main(void) {
+    test_prepare_renders_hidden_window();
+    test_prepare_preconditions();
+    test_invalidate_schedules_one_prepare();
+    test_first_paint_measurement();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
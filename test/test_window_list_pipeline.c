@@ -0,0 +1,544 @@
+/*
+ * Behavioral test: pipelined window-list acquisition.
+ *
+ * get_window_list() must issue all per-window property requests before it
+ * reads any reply, so the number of round trips to the X server does not
+ * depend on the number of client windows. A fake XCB connection records the
+ * request/reply order and counts every reply wait whose answer has not
+ * already arrived together with an earlier one as one round trip.
+ *
+ * The decoded WindowInfo must match what the old Xlib getters produced:
+ * _NET_WM_NAME preferred over WM_NAME, "Untitled window" for empty titles,
+ * WM_CLASS split into instance/class, cofi's own windows skipped, destroyed
+ * windows skipped, sticky desktop read as -1.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include "../src/app_data.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- Fake X server ---- */
+
+#define ROOT_WINDOW 0x1
+#define ATOM_NET_CLIENT_LIST 300
+#define ATOM_NET_WM_NAME 301
+#define ATOM_NET_WM_WINDOW_TYPE 302
+#define ATOM_NET_WM_WINDOW_TYPE_NORMAL 303
+#define ATOM_NET_WM_WINDOW_TYPE_DIALOG 304
+#define ATOM_NET_WM_PID 305
+#define ATOM_NET_WM_DESKTOP 306
+#define ATOM_NET_WM_STATE 307
+#define ATOM_NET_WM_STATE_HIDDEN 308
+
+#define FAKE_MAX_WINDOWS 512
+#define FAKE_MAX_REQUESTS 8192
+
+typedef struct {
+    uint32_t id;
+    int exists;
+    const char *net_wm_name;     /* NULL = property absent */
+    const char *wm_name;
+    const char *instance;
+    const char *class_name;
+    uint32_t type_atom;          /* 0 = property absent */
+    uint32_t pid;
+    uint32_t desktop;
+    int has_desktop;
+    uint32_t state_atom;         /* 0 = empty _NET_WM_STATE */
+} FakeWindow;
+
+typedef struct {
+    uint32_t window;
+    uint32_t property;           /* 0 = GetWindowAttributes */
+} FakeRequest;
+
+static FakeWindow fake_windows[FAKE_MAX_WINDOWS];
+static int fake_window_count = 0;
+static FakeRequest requests[FAKE_MAX_REQUESTS];
+static unsigned int next_sequence = 0;
+static unsigned int received_upto = 0;
+static int round_trips = 0;
+static int requests_after_first_batch_reply = 0;
+static int batch_reply_seen = 0;
+
+static void reset_fake_server(void) {
+    memset(fake_windows, 0, sizeof(fake_windows));
+    fake_window_count = 0;
+    next_sequence = 0;
+    received_upto = 0;
+    round_trips = 0;
+    requests_after_first_batch_reply = 0;
+    batch_reply_seen = 0;
+}
+
+static FakeWindow *add_fake_window(uint32_t id, const char *title,
+                                   const char *instance, const char *class_name) {
+    FakeWindow *w = &fake_windows[fake_window_count++];
+    w->id = id;
+    w->exists = 1;
+    w->net_wm_name = title;
+    w->instance = instance;
+    w->class_name = class_name;
+    w->type_atom = ATOM_NET_WM_WINDOW_TYPE_NORMAL;
+    w->pid = 1000 + id;
+    w->desktop = 0;
+    w->has_desktop = 1;
+    return w;
+}
+
+static FakeWindow *find_fake_window(uint32_t id) {
+    for (int i = 0; i < fake_window_count; i++) {
+        if (fake_windows[i].id == id) return &fake_windows[i];
+    }
+    return NULL;
+}
+
+static unsigned int record_request(uint32_t window, uint32_t property) {
+    if (batch_reply_seen) requests_after_first_batch_reply++;
+    unsigned int seq = ++next_sequence;
+    requests[seq].window = window;
+    requests[seq].property = property;
+    return seq;
+}
+
+/* Waiting for a reply that has not arrived yet costs one round trip; the
+ * server answers everything sent so far in that same trip */
+static void wait_for(unsigned int seq) {
+    if (seq > received_upto) {
+        round_trips++;
+        received_upto = next_sequence;
+    }
+}
+
+static xcb_get_property_reply_t *make_reply(uint32_t type, uint8_t format,
+                                            const void *data, int len) {
+    xcb_get_property_reply_t *r = calloc(1, sizeof(*r) + len + 1);
+    r->type = type;
+    r->format = format;
+    r->value_len = format ? len / (format / 8) : 0;
+    if (len > 0) memcpy(r + 1, data, len);
+    return r;
+}
+
+/* ---- XCB stubs ---- */
+
+static int fake_conn_storage;
+
+xcb_connection_t *XGetXCBConnection(Display *dpy) {
+    (void)dpy;
+    return (xcb_connection_t *)&fake_conn_storage;
+}
+
+int xcb_flush(xcb_connection_t *c) {
+    (void)c;
+    return 1;
+}
+
+xcb_get_window_attributes_cookie_t xcb_get_window_attributes(xcb_connection_t *c, xcb_window_t window) {
+    (void)c;
+    xcb_get_window_attributes_cookie_t cookie = { record_request(window, 0) };
+    return cookie;
+}
+
+xcb_get_property_cookie_t xcb_get_property(xcb_connection_t *c, uint8_t _delete, xcb_window_t window,
+                                           xcb_atom_t property, xcb_atom_t type,
+                                           uint32_t long_offset, uint32_t long_length) {
+    (void)c; (void)_delete; (void)type; (void)long_offset; (void)long_length;
+    xcb_get_property_cookie_t cookie = { record_request(window, property) };
+    return cookie;
+}
+
+/* The server's answer to request seq (GetWindowAttributes or GetProperty) */
+static void *fake_reply(unsigned int seq, xcb_generic_error_t **e) {
+    FakeRequest *req = &requests[seq];
+    if (req->window != ROOT_WINDOW) batch_reply_seen = 1;
+
+    if (req->property == 0) {
+        FakeWindow *w = find_fake_window(req->window);
+        if (!w || !w->exists) return NULL;
+        return calloc(1, sizeof(xcb_get_window_attributes_reply_t));
+    }
+
+    if (req->window == ROOT_WINDOW && req->property == ATOM_NET_CLIENT_LIST) {
+        uint32_t ids[FAKE_MAX_WINDOWS];
+        for (int i = 0; i < fake_window_count; i++) ids[i] = fake_windows[i].id;
+        return make_reply(XA_WINDOW, 32, ids, fake_window_count * 4);
+    }
+
+    FakeWindow *w = find_fake_window(req->window);
+    if (!w || !w->exists) {
+        /* BadWindow */
+        if (e) *e = calloc(1, sizeof(xcb_generic_error_t));
+        return NULL;
+    }
+
+    switch (req->property) {
+    case ATOM_NET_WM_NAME:
+        if (!w->net_wm_name) break;
+        return make_reply(ATOM_NET_WM_NAME, 8, w->net_wm_name, strlen(w->net_wm_name));
+    case XA_WM_NAME:
+        if (!w->wm_name) break;
+        return make_reply(XA_STRING, 8, w->wm_name, strlen(w->wm_name));
+    case XA_WM_CLASS: {
+        char buf[256];
+        int ilen = strlen(w->instance), clen = strlen(w->class_name);
+        memcpy(buf, w->instance, ilen + 1);
+        memcpy(buf + ilen + 1, w->class_name, clen + 1);
+        return make_reply(XA_STRING, 8, buf, ilen + clen + 2);
+    }
+    case ATOM_NET_WM_WINDOW_TYPE:
+        if (!w->type_atom) break;
+        return make_reply(XA_ATOM, 32, &w->type_atom, 4);
+    case ATOM_NET_WM_PID:
+        return make_reply(XA_CARDINAL, 32, &w->pid, 4);
+    case ATOM_NET_WM_DESKTOP:
+        if (!w->has_desktop) break;
+        return make_reply(XA_CARDINAL, 32, &w->desktop, 4);
+    case ATOM_NET_WM_STATE:
+        return make_reply(XA_ATOM, 32, &w->state_atom, w->state_atom ? 4 : 0);
+    }
+    return make_reply(XCB_NONE, 0, NULL, 0);
+}
+
+int xcb_poll_for_reply(xcb_connection_t *c, unsigned int request, void **reply,
+                       xcb_generic_error_t **error) {
+    (void)c;
+    if (request > received_upto) return 0;
+    *reply = fake_reply(request, error);
+    return 1;
+}
+
+void *xcb_wait_for_reply(xcb_connection_t *c, unsigned int request, xcb_generic_error_t **e) {
+    (void)c;
+    wait_for(request);
+    return fake_reply(request, e);
+}
+
+void *xcb_get_property_value(const xcb_get_property_reply_t *r) {
+    return (void *)(r + 1);
+}
+
+int xcb_get_property_value_length(const xcb_get_property_reply_t *r) {
+    return r->value_len * (r->format / 8);
+}
+
+void xcb_discard_reply(xcb_connection_t *c, unsigned int sequence) {
+    (void)c; (void)sequence;
+}
+
+/* ---- Module under test ---- */
+#include "../src/window_list.c"
+
+/* ---- Helpers ---- */
+
+static AppData app;
+static __typeof__(*((_XPrivDisplay)0)) fake_display;
+static Screen fake_screen;
+
+static void reset_app(void) {
+    memset(&app, 0, sizeof(app));
+    fake_screen.root = ROOT_WINDOW;
+    fake_display.screens = &fake_screen;
+    fake_display.default_screen = 0;
+    app.display = (Display *)&fake_display;
+    app.atoms.net_client_list = ATOM_NET_CLIENT_LIST;
+    app.atoms.net_wm_name = ATOM_NET_WM_NAME;
+    app.atoms.net_wm_window_type = ATOM_NET_WM_WINDOW_TYPE;
+    app.atoms.net_wm_window_type_normal = ATOM_NET_WM_WINDOW_TYPE_NORMAL;
+    app.atoms.net_wm_pid = ATOM_NET_WM_PID;
+    app.atoms.net_wm_desktop = ATOM_NET_WM_DESKTOP;
+    app.atoms.net_wm_state = ATOM_NET_WM_STATE;
+    app.atoms.net_wm_state_hidden = ATOM_NET_WM_STATE_HIDDEN;
+}
+
+static WindowInfo *find_result(Window id) {
+    for (int i = 0; i < app.window_count; i++) {
+        if (app.windows[i].id == id) return &app.windows[i];
+    }
+    return NULL;
+}
+
+/* ---- Tests ---- */
+
+static void test_decoded_fields_match_xlib_getters(void) {
+    reset_app();
+    reset_fake_server();
+
+    add_fake_window(0x100, "vim main.c", "kitty", "kitty");
+    FakeWindow *legacy = add_fake_window(0x200, NULL, "xterm", "XTerm");
+    legacy->wm_name = "legacy title";
+    FakeWindow *untitled = add_fake_window(0x300, "", "feh", "feh");
+    untitled->wm_name = "ignored";
+    FakeWindow *dialog = add_fake_window(0x400, "Save As", "gimp", "Gimp");
+    dialog->type_atom = ATOM_NET_WM_WINDOW_TYPE_DIALOG;
+    FakeWindow *sticky = add_fake_window(0x500, "Clock", "xclock", "XClock");
+    sticky->desktop = 0xFFFFFFFF;
+    add_fake_window(0x600, "cofi", "cofi", "cofi");
+    FakeWindow *gone = add_fake_window(0x700, "Closing", "x", "X");
+    gone->exists = 0;
+    FakeWindow *minimized = add_fake_window(0x900, "Minimized", "m", "M");
+    minimized->state_atom = ATOM_NET_WM_STATE_HIDDEN;
+    FakeWindow *no_desk = add_fake_window(0x800, "Panel", "bar", "Bar");
+    no_desk->has_desktop = 0;
+    no_desk->type_atom = 0;
+
+    get_window_list(&app);
+
+    ASSERT_TRUE("seven windows stored (cofi and destroyed window skipped)", app.window_count == 7);
+    ASSERT_TRUE("client list order preserved", app.windows[0].id == 0x100 && app.windows[6].id == 0x800);
+
+    WindowInfo *w = find_result(0x100);
+    ASSERT_TRUE("_NET_WM_NAME title", w && strcmp(w->title, "vim main.c") == 0);
+    ASSERT_TRUE("instance/class split", w && strcmp(w->instance, "kitty") == 0 &&
+                strcmp(w->class_name, "kitty") == 0);
+    ASSERT_TRUE("pid decoded", w && w->pid == 0x100 + 1000);
+    ASSERT_TRUE("Normal type", w && strcmp(w->type, "Normal") == 0);
+
+    w = find_result(0x200);
+    ASSERT_TRUE("WM_NAME fallback when _NET_WM_NAME is absent", w && strcmp(w->title, "legacy title") == 0);
+    ASSERT_TRUE("class keeps case", w && strcmp(w->class_name, "XTerm") == 0);
+
+    w = find_result(0x300);
+    ASSERT_TRUE("empty _NET_WM_NAME gives Untitled window", w && strcmp(w->title, "Untitled window") == 0);
+
+    w = find_result(0x400);
+    ASSERT_TRUE("dialog type is Special", w && strcmp(w->type, "Special") == 0);
+
+    w = find_result(0x500);
+    ASSERT_TRUE("sticky desktop reads as -1", w && w->desktop == -1);
+
+    w = find_result(0x900);
+    ASSERT_TRUE("_NET_WM_STATE_HIDDEN cached as state flag",
+                w && w->state == WINDOW_STATE_FLAG_HIDDEN);
+    ASSERT_TRUE("no state flags by default", find_result(0x100)->state == 0);
+
+    w = find_result(0x800);
+    ASSERT_TRUE("missing desktop defaults to -1", w && w->desktop == -1);
+    ASSERT_TRUE("missing type defaults to Normal", w && strcmp(w->type, "Normal") == 0);
+
+    ASSERT_TRUE("cofi window skipped", find_result(0x600) == NULL);
+    ASSERT_TRUE("destroyed window skipped", find_result(0x700) == NULL);
+}
+
+static int round_trips_for(int n) {
+    reset_app();
+    reset_fake_server();
+    for (int i = 0; i < n; i++) {
+        char *title = malloc(32);
+        snprintf(title, 32, "window %d", i);
+        add_fake_window(0x1000 + i, title, "app", "App");
+    }
+    get_window_list(&app);
+    for (int i = 0; i < n; i++) free((char *)fake_windows[i].net_wm_name);
+    return round_trips;
+}
+
+static void test_round_trips_independent_of_window_count(void) {
+    int rt_small = round_trips_for(5);
+    const WindowListStats *stats = get_window_list_stats();
+    ASSERT_TRUE("5 windows: all requests issued before first reply",
+                requests_after_first_batch_reply == 0);
+    ASSERT_TRUE("5 windows: two round trips", rt_small == 2);
+    ASSERT_TRUE("5 windows: stats agree with fake server", stats->round_trips == rt_small);
+    ASSERT_TRUE("5 windows: stats count requested windows", stats->windows_requested == 5);
+
+    int rt_large = round_trips_for(200);
+    ASSERT_TRUE("200 windows: all requests issued before first reply",
+                requests_after_first_batch_reply == 0);
+    ASSERT_TRUE("200 windows: same round trips as 5 windows", rt_large == rt_small);
+    ASSERT_TRUE("200 windows: stats agree with fake server", stats->round_trips == rt_large);
+    ASSERT_TRUE("200 windows: all stored", app.window_count == 200);
+    ASSERT_TRUE("200 windows: 8 requests per window plus client list",
+                stats->requests_sent == 200 * 8 + 1);
+}
+
+static void test_empty_client_list(void) {
+    reset_app();
+    reset_fake_server();
+    get_window_list(&app);
+    ASSERT_TRUE("empty list: no windows", app.window_count == 0);
+    ASSERT_TRUE("empty list: one round trip", get_window_list_stats()->round_trips == 1);
+}
+
+static void test_incremental_update_fetches_only_added(void) {
+    reset_app();
+    reset_fake_server();
+    add_fake_window(0x100, "one", "a", "A");
+    add_fake_window(0x200, "two", "b", "B");
+    add_fake_window(0x250, "cofi", "cofi", "cofi");
+    add_fake_window(0x300, "three", "c", "C");
+    get_window_list(&app);
+    ASSERT_TRUE("incremental: initial list has 3 windows", app.window_count == 3);
+
+    /* Title of a kept window changed on the server: must not be refetched */
+    fake_windows[0].net_wm_name = "one (changed on server)";
+
+    /* 0x200 closes, 0x400 opens at the end */
+    fake_windows[1] = fake_windows[2];
+    fake_windows[2] = fake_windows[3];
+    fake_window_count = 3;
+    add_fake_window(0x400, "four", "d", "D");
+
+    static WindowListDelta delta;
+    update_window_list(&app, &delta);
+    const WindowListStats *stats = get_window_list_stats();
+
+    ASSERT_TRUE("incremental: one window added", delta.added_count == 1);
+    ASSERT_TRUE("incremental: added index points at new window",
+                delta.added_count == 1 && app.windows[delta.added[0]].id == 0x400);
+    ASSERT_TRUE("incremental: one window removed",
+                delta.removed_count == 1 && delta.removed[0] == 0x200);
+    ASSERT_TRUE("incremental: order unchanged", !delta.order_changed);
+    ASSERT_TRUE("incremental: only the added window was fetched", stats->windows_requested == 1);
+    ASSERT_TRUE("incremental: two round trips", stats->round_trips == 2);
+    ASSERT_TRUE("incremental: client list order",
+                app.window_count == 3 && app.windows[0].id == 0x100 &&
+                app.windows[1].id == 0x300 && app.windows[2].id == 0x400);
+    ASSERT_TRUE("incremental: kept window untouched", strcmp(app.windows[0].title, "one") == 0);
+    ASSERT_TRUE("incremental: new window decoded", strcmp(app.windows[2].title, "four") == 0);
+
+    /* Nothing changed: one round trip, empty delta, cofi window not refetched */
+    update_window_list(&app, &delta);
+    ASSERT_TRUE("unchanged: empty delta",
+                delta.added_count == 0 && delta.removed_count == 0 && !delta.order_changed);
+    ASSERT_TRUE("unchanged: nothing fetched", stats->windows_requested == 0);
+    ASSERT_TRUE("unchanged: one round trip", stats->round_trips == 1);
+
+    /* Reordered client list */
+    FakeWindow tmp = fake_windows[0];
+    fake_windows[0] = fake_windows[2];
+    fake_windows[2] = tmp;
+    update_window_list(&app, &delta);
+    ASSERT_TRUE("reorder: flagged", delta.order_changed);
+    ASSERT_TRUE("reorder: follows client list",
+                app.window_count == 3 && app.windows[0].id == 0x300 && app.windows[1].id == 0x100);
+}
+
+/* Removals, insertions in the middle and a reordering in one update must
+ * give exactly what a full fetch of the same client list gives */
+static void test_incremental_update_matches_full_fetch(void) {
+    reset_app();
+    reset_fake_server();
+    const char *titles[] = { "t1", "t2", "t3", "t4", "t5", "t6", "t7", "t8" };
+    for (int i = 0; i < 6; i++) add_fake_window(0x100 * (i + 1), titles[i], "i", "C");
+    get_window_list(&app);
+
+    /* New client list: 0x500, new 0x700, 0x100, 0x300, new 0x800, 0x600
+     * (0x200 and 0x400 closed, 0x100/0x500 swapped) */
+    FakeWindow old[6];
+    memcpy(old, fake_windows, sizeof(old));
+    fake_window_count = 0;
+    fake_windows[fake_window_count++] = old[4];
+    add_fake_window(0x700, titles[6], "i", "C");
+    fake_windows[fake_window_count++] = old[0];
+    fake_windows[fake_window_count++] = old[2];
+    add_fake_window(0x800, titles[7], "i", "C");
+    fake_windows[fake_window_count++] = old[5];
+
+    static WindowListDelta delta;
+    update_window_list(&app, &delta);
+
+    int count = app.window_count;
+    Window got_ids[8];
+    char got_titles[8][16];
+    for (int i = 0; i < count && i < 8; i++) {
+        got_ids[i] = app.windows[i].id;
+        snprintf(got_titles[i], sizeof(got_titles[i]), "%s", app.windows[i].title);
+    }
+
+    ASSERT_TRUE("mixed update: two added, two removed",
+                delta.added_count == 2 && delta.removed_count == 2);
+    ASSERT_TRUE("mixed update: order change flagged", delta.order_changed);
+    ASSERT_TRUE("mixed update: added indices point at new windows",
+                delta.added_count == 2 && app.windows[delta.added[0]].id == 0x700 &&
+                app.windows[delta.added[1]].id == 0x800);
+    ASSERT_TRUE("mixed update: lookup index rebuilt",
+                find_window_index(&app, 0x300) >= 0 &&
+                app.windows[find_window_index(&app, 0x300)].id == 0x300 &&
+                find_window_index(&app, 0x200) < 0);
+
+    reset_app();
+    get_window_list(&app);
+    int same = app.window_count == count && count == 6;
+    for (int i = 0; same && i < count; i++) {
+        same = app.windows[i].id == got_ids[i] && strcmp(app.windows[i].title, got_titles[i]) == 0;
+    }
+    ASSERT_TRUE("mixed update: same rows as a full fetch", same);
+}
+
+static void test_refresh_updates_only_queued_fields(void) {
+    reset_app();
+    reset_fake_server();
+    add_fake_window(0x100, "one", "a", "A");
+    add_fake_window(0x200, "two", "b", "B");
+    add_fake_window(0x300, "three", "c", "C");
+    get_window_list(&app);
+
+    /* Server-side changes; only the title of 0x200 and the state of 0x300 are queued */
+    fake_windows[0].net_wm_name = "one (not queued)";
+    fake_windows[1].net_wm_name = "two (renamed)";
+    fake_windows[1].desktop = 4;
+    fake_windows[2].state_atom = ATOM_NET_WM_STATE_HIDDEN;
+
+    WindowPropertyUpdate updates[3] = {
+        { 0x200, WINDOW_FIELD_TITLE },
+        { 0x300, WINDOW_FIELD_STATE | WINDOW_FIELD_TITLE },
+        { 0x999, WINDOW_FIELD_TITLE },   /* unknown window: ignored */
+    };
+    int changed = refresh_window_properties(&app, updates, 3);
+    const WindowListStats *stats = get_window_list_stats();
+
+    ASSERT_TRUE("refresh: two windows changed", changed == 2);
+    ASSERT_TRUE("refresh: title change reported", updates[0].fields == WINDOW_FIELD_TITLE);
+    ASSERT_TRUE("refresh: unchanged title not reported", updates[1].fields == WINDOW_FIELD_STATE);
+    ASSERT_TRUE("refresh: unknown window reports nothing", updates[2].fields == 0);
+    ASSERT_TRUE("refresh: new title cached", strcmp(find_result(0x200)->title, "two (renamed)") == 0);
+    ASSERT_TRUE("refresh: unqueued desktop untouched", find_result(0x200)->desktop == 0);
+    ASSERT_TRUE("refresh: unqueued window untouched", strcmp(find_result(0x100)->title, "one") == 0);
+    ASSERT_TRUE("refresh: state flag cached", find_result(0x300)->state == WINDOW_STATE_FLAG_HIDDEN);
+    ASSERT_TRUE("refresh: one round trip", stats->round_trips == 1);
+    ASSERT_TRUE("refresh: only queued properties requested", stats->requests_sent == 2 + 3);
+
+    /* Destroyed window: errors leave the cached entry alone */
+    fake_windows[0].exists = 0;
+    WindowPropertyUpdate gone = { 0x100, WINDOW_FIELD_TITLE };
+    changed = refresh_window_properties(&app, &gone, 1);
+    ASSERT_TRUE("refresh: destroyed window not changed", changed == 0 && gone.fields == 0);
+    ASSERT_TRUE("refresh: destroyed window keeps cached title", strcmp(find_result(0x100)->title, "one") == 0);
+
+    ASSERT_TRUE("field for _NET_WM_NAME is title",
+                window_field_for_atom(&app.atoms, ATOM_NET_WM_NAME) == WINDOW_FIELD_TITLE);
+    ASSERT_TRUE("field for WM_NAME is title",
+                window_field_for_atom(&app.atoms, XA_WM_NAME) == WINDOW_FIELD_TITLE);
+    ASSERT_TRUE("field for _NET_WM_STATE is state",
+                window_field_for_atom(&app.atoms, ATOM_NET_WM_STATE) == WINDOW_FIELD_STATE);
+    ASSERT_TRUE("uncached atom maps to no field", window_field_for_atom(&app.atoms, 999) == 0);
+}
+
+/* ---- Main ---- */
+
+int main(void) {
+    log_set_quiet(true);   /* suppress log output during tests */
+
+    test_decoded_fields_match_xlib_getters();
+    test_round_trips_independent_of_window_count();
+    test_empty_client_list();
+    test_incremental_update_fetches_only_added();
+    test_incremental_update_matches_full_fetch();
+    test_refresh_updates_only_queued_fields();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/window_registry.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+static void test_empty_registry(void) {
+    WindowRegistry registry;
+    window_registry_init(&registry);
+
+    ASSERT_TRUE("zeroed registry has no buckets", registry.capacity == 0 && registry.keys == NULL);
+    ASSERT_TRUE("lookup in empty registry misses", window_registry_get(&registry, 0x1234) == -1);
+    ASSERT_TRUE("remove from empty registry is a no-op", !window_registry_remove(&registry, 0x1234));
+    ASSERT_TRUE("window 0 is rejected", !window_registry_put(&registry, 0, 1));
+    window_registry_free(&registry);
+}
+
+static void test_put_get_overwrite(void) {
+    WindowRegistry registry;
+    window_registry_init(&registry);
+
+    ASSERT_TRUE("put succeeds", window_registry_put(&registry, 0x3a00004, 7));
+    ASSERT_TRUE("get returns handle", window_registry_get(&registry, 0x3a00004) == 7);
+    ASSERT_TRUE("contains sees it", window_registry_contains(&registry, 0x3a00004));
+    ASSERT_TRUE("neighbouring ID misses", window_registry_get(&registry, 0x3a00005) == -1);
+
+    window_registry_put(&registry, 0x3a00004, 9);
+    ASSERT_TRUE("put overwrites in place", window_registry_get(&registry, 0x3a00004) == 9 &&
+                registry.count == 1);
+    window_registry_free(&registry);
+}
+
+// Reference check against a plain array for a mix of inserts and deletes.
+// IDs follow the X pattern (client base | small counter) so probe runs
+// and wrap-around deletions get exercised.
+static void test_matches_reference_under_churn(void) {
+    enum { N = 2000 };
+    static Window ids[N];
+    static int present[N];
+    WindowRegistry registry;
+    window_registry_init(&registry);
+
+    for (int i = 0; i < N; i++) {
+        ids[i] = ((Window)(0x1000 + i / 8) << 20) | (Window)(i % 8 + 1);
+        present[i] = 0;
+    }
+
+    srand(42);
+    int ok = 1;
+    for (int step = 0; step < 20000 && ok; step++) {
+        int i = rand() % N;
+        if (present[i] && rand() % 2) {
+            ok &= window_registry_remove(&registry, ids[i]);
+            present[i] = 0;
+        } else {
+            ok &= window_registry_put(&registry, ids[i], i);
+            present[i] = 1;
+        }
+    }
+
+    int expected = 0;
+    for (int i = 0; i < N && ok; i++) {
+        int got = window_registry_get(&registry, ids[i]);
+        ok &= present[i] ? got == i : got == -1;
+        expected += present[i];
+    }
+    ASSERT_TRUE("every lookup matches the reference after churn", ok);
+    ASSERT_TRUE("count matches the reference", registry.count == expected);
+    ASSERT_TRUE("load factor stays at or below 1/2", registry.count * 2 <= registry.capacity);
+
+    for (int i = 0; i < N; i++) {
+        if (present[i]) window_registry_remove(&registry, ids[i]);
+    }
+    ASSERT_TRUE("removing everything empties the registry", registry.count == 0);
+    ok = 1;
+    for (int i = 0; i < registry.capacity; i++) {
+        ok &= registry.keys[i] == 0;
+    }
+    ASSERT_TRUE("no stale buckets left behind", ok);
+    window_registry_free(&registry);
+}
+
+static void test_clear_keeps_buckets(void) {
+    WindowRegistry registry;
+    window_registry_init(&registry);
+    for (Window id = 1; id <= 100; id++) {
+        window_registry_put(&registry, id, (int)id);
+    }
+    int capacity = registry.capacity;
+
+    window_registry_clear(&registry);
+    ASSERT_TRUE("clear empties", registry.count == 0 && window_registry_get(&registry, 50) == -1);
+    ASSERT_TRUE("clear keeps capacity", registry.capacity == capacity);
+
+    window_registry_put(&registry, 50, 3);
+    ASSERT_TRUE("reusable after clear", window_registry_get(&registry, 50) == 3);
+
+    window_registry_free(&registry);
+    ASSERT_TRUE("free releases buckets", registry.keys == NULL && registry.capacity == 0);
+}
+
+int main(void) {
+    test_empty_registry();
+    test_put_get_overwrite();
+    test_matches_reference_under_churn();
+    test_clear_keeps_buckets();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,323 @@
+/*
+ * Window store: growable per-window tables instead of a fixed 256 cap.
+ *
+ * Fills the store with 2000 windows, runs the real history/partition/filter
+ * pipeline over it and checks nothing is dropped, then compares the cost
+ * per window at 500 and 2000 windows to catch quadratic passes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../src/app_data.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+/* ---- Stubs ---- */
+
+static int mock_active_window = 0;
+
+/* x11_utils.c */
+int get_active_window_id(Display *d)  { (void)d; return mock_active_window; }
+int get_current_desktop(Display *d)   { (void)d; return 0; }
+
+static Window mock_named_window = 0;
+
+/* named_window.c */
+const char *get_window_custom_name(const NamedWindowManager *manager, Window id) {
+    (void)manager;
+    return id != 0 && id == mock_named_window ? "scratchpad" : NULL;
+}
+
+static int mock_display_lines = 10;
+
+/* dynamic_display.c */
+gint get_dynamic_max_display_lines(struct AppData *app) { (void)app; return mock_display_lines; }
+
+/* selection.c */
+void preserve_selection(AppData *app)  { (void)app; }
+void restore_selection(AppData *app)   { (void)app; }
+void validate_selection(AppData *app)  { (void)app; }
+
+/* window_list.c */
+int find_window_index(const AppData *app, Window id) {
+    int index = window_registry_get(&app->windows_by_id, id);
+    if (index < 0 || index >= app->window_count || app->windows[index].id != id) {
+        return -1;
+    }
+    return index;
+}
+
+/* ---- Modules under test ---- */
+#include "../src/window_store.c"
+#include "../src/history.c"
+#include "../src/filter.c"
+
+/* ---- Helpers ---- */
+
+static const char *classes[] = { "kitty", "firefox", "code", "thunar", "slack" };
+
+static void fill_app(AppData *app, int count) {
+    memset(app, 0, sizeof(*app));
+    window_registry_init(&app->windows_by_id);
+    ensure_window_capacity(app, count);
+
+    for (int i = 0; i < count; i++) {
+        WindowInfo *win = &app->windows[i];
+        memset(win, 0, sizeof(*win));
+        win->id = 0x1000000 + (Window)i;
+        win->desktop = i % 4;
+        snprintf(win->title, sizeof(win->title), "%s window %d", classes[i % 5], i);
+        snprintf(win->class_name, sizeof(win->class_name), "%s", classes[i % 5]);
+        snprintf(win->instance, sizeof(win->instance), "%s", classes[i % 5]);
+        snprintf(win->type, sizeof(win->type), "%s", i % 7 == 3 ? "Special" : "Normal");
+        window_registry_put(&app->windows_by_id, win->id, i);
+    }
+    app->window_count = count;
+    mock_active_window = (int)app->windows[0].id;
+}
+
+static void free_app(AppData *app) {
+    free(app->windows);
+    free(app->history);
+    free(app->filtered);
+    free(app->windows_to_move);
+    window_registry_free(&app->windows_by_id);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Best-of-5 time for `rounds` filter passes (empty query and a typed one)
+static double time_pipeline(int count, int rounds) {
+    AppData app;
+    fill_app(&app, count);
+    filter_windows(&app, "");  // Seed history and warm up the scratch tables
+
+    double best = 1e9;
+    for (int attempt = 0; attempt < 5; attempt++) {
+        double start = now_seconds();
+        for (int r = 0; r < rounds; r++) {
+            filter_windows(&app, "");
+            filter_windows(&app, "kit");
+        }
+        double elapsed = now_seconds() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    free_app(&app);
+    return best;
+}
+
+/* ---- Tests ---- */
+
+static void test_grow_array_doubles_and_keeps_contents(void) {
+    int *items = NULL;
+    int capacity = 0;
+
+    ASSERT_TRUE("first growth succeeds", GROW_ARRAY(items, capacity, 10));
+    ASSERT_TRUE("first growth starts at the minimum", capacity == WINDOW_STORE_MIN_CAPACITY);
+    for (int i = 0; i < capacity; i++) items[i] = i;
+
+    int *before = items;
+    ASSERT_TRUE("request within capacity is a no-op",
+                GROW_ARRAY(items, capacity, 20) && items == before);
+
+    ASSERT_TRUE("growth past capacity succeeds", GROW_ARRAY(items, capacity, 1000));
+    ASSERT_TRUE("capacity doubles to cover the request", capacity == 1024);
+    int ok = 1;
+    for (int i = 0; i < WINDOW_STORE_MIN_CAPACITY; i++) ok &= items[i] == i;
+    ASSERT_TRUE("contents survive growth", ok);
+    free(items);
+}
+
+static void test_store_holds_2000_windows(void) {
+    AppData app;
+    fill_app(&app, 2000);
+
+    ASSERT_TRUE("shared capacity covers 2000 windows", app.window_capacity >= 2000);
+
+    filter_windows(&app, "");
+    ASSERT_TRUE("history keeps every window", app.history_count == 2000);
+    ASSERT_TRUE("empty filter lists every window", app.filtered_count == 2000);
+    ASSERT_TRUE("active window stays first", app.filtered[0].id == app.windows[0].id);
+
+    filter_windows(&app, "code window 1997");
+    ASSERT_TRUE("window far past the old cap is findable",
+                app.filtered_count > 0 && app.filtered[0].id == app.windows[1997].id);
+
+    // Growing after the fact keeps what is already stored
+    WindowInfo last = app.windows[1999];
+    ensure_window_capacity(&app, 4000);
+    ASSERT_TRUE("store grows again on demand", app.window_capacity >= 4000);
+    ASSERT_TRUE("stored windows survive regrowth", app.windows[1999].id == last.id &&
+                strcmp(app.windows[1999].title, last.title) == 0);
+    free_app(&app);
+}
+
+static void test_custom_name_is_matched_and_displayed(void) {
+    AppData app;
+    fill_app(&app, 300);
+    mock_named_window = app.windows[280].id;
+
+    filter_windows(&app, "scratchpad");
+    ASSERT_TRUE("custom name is matched",
+                app.filtered_count > 0 && app.filtered[0].id == mock_named_window);
+    ASSERT_TRUE("filtered row shows custom name before the title",
+                app.filtered_count > 0 &&
+                strcmp(app.filtered[0].title, "scratchpad - kitty window 280") == 0);
+    ASSERT_TRUE("canonical window keeps its own title",
+                strcmp(app.windows[280].title, "kitty window 280") == 0);
+
+    mock_named_window = 0;
+    free_app(&app);
+}
+
+// Filter from scratch: an empty query first ends any refinement pass
+static void filter_fresh(AppData *app, const char *filter, Window *ids, int *count) {
+    filter_windows(app, "");
+    filter_windows(app, filter);
+    ensure_filtered_order(app, app->filtered_count);
+    for (int i = 0; i < app->filtered_count; i++) ids[i] = app->filtered[i].id;
+    *count = app->filtered_count;
+}
+
+static int same_results(AppData *app, const Window *ids, int count) {
+    if (app->filtered_count != count) return 0;
+    ensure_filtered_order(app, count);
+    for (int i = 0; i < count; i++) {
+        if (app->filtered[i].id != ids[i]) return 0;
+    }
+    return 1;
+}
+
+static void test_refined_query_matches_full_scan(void) {
+    static Window expected[300];
+    int expected_count = 0;
+    AppData app;
+    fill_app(&app, 300);
+
+    const char *typed[] = { "k", "ki", "kit", "kitw", "kitw2" };
+    int ok = 1;
+    for (int i = 0; i < 5; i++) {
+        filter_fresh(&app, typed[i], expected, &expected_count);
+        filter_windows(&app, "");
+        for (int j = 0; j <= i; j++) filter_windows(&app, typed[j]);
+        ok &= same_results(&app, expected, expected_count);
+    }
+    ASSERT_TRUE("typing on gives the same rows as a full scan", ok);
+
+    // Backspace and edits start over instead of narrowing further
+    filter_windows(&app, "kitw2");
+    filter_windows(&app, "kitw");
+    filter_fresh(&app, "kitw", expected, &expected_count);
+    filter_windows(&app, "kitw2");
+    filter_windows(&app, "kitw");
+    ASSERT_TRUE("deleting a character widens the results again",
+                same_results(&app, expected, expected_count) && expected_count > 0);
+
+    // A window rejected earlier in the pass whose title changes is rescored
+    filter_windows(&app, "");
+    filter_windows(&app, "ki");
+    snprintf(app.windows[1].title, sizeof(app.windows[1].title), "kitty window renamed");
+    filter_windows(&app, "kitty window ren");
+    ASSERT_TRUE("changed window is rescored mid-pass",
+                app.filtered_count > 0 && app.filtered[0].id == app.windows[1].id);
+    free_app(&app);
+}
+
+// Reference ranking of the typed query: every row scored, fully sorted
+static int reference_ranking(AppData *app, const char *filter, Window *ids) {
+    int count = score_and_filter_windows(app, filter, scored_scratch);
+    qsort(scored_scratch, (size_t)count, sizeof(ScoredWindow), compare_scores);
+    for (int i = 0; i < count; i++) ids[i] = app->windows[scored_scratch[i].index].id;
+    return count;
+}
+
+static void test_only_visible_rows_are_ranked(void) {
+    static Window expected[2000];
+    AppData app;
+    fill_app(&app, 2000);
+    filter_windows(&app, "");
+    memset(app.filtered, 0, sizeof(WindowInfo) * (size_t)app.window_capacity);
+    filter_windows(&app, "kit");
+    int ranked = mock_display_lines * 2;
+
+    ASSERT_TRUE("every match is listed", app.filtered_count == 400);
+    ASSERT_TRUE("only a screen and a page are ranked",
+                app.filtered_unordered == app.filtered_count - ranked);
+    ASSERT_TRUE("only ranked rows are copied",
+                app.filtered[ranked - 1].id != 0 && app.filtered[ranked].id == 0);
+
+    int count = reference_ranking(&app, "kit", expected);
+    filter_windows(&app, "");
+    filter_windows(&app, "kit");
+    int ok = count == app.filtered_count;
+    for (int i = 0; i < ranked && ok; i++) ok &= app.filtered[i].id == expected[i];
+    ASSERT_TRUE("ranked rows match a full sort", ok);
+
+    // Scrolling past them ranks another block instead of one row
+    ensure_filtered_order(&app, ranked + 1);
+    ASSERT_TRUE("extending ranks a whole block",
+                app.filtered_unordered == app.filtered_count - 2 * ranked);
+
+    // Looking up a row in the tail ranks everything, so the row is final
+    Window deep = expected[count - 3];
+    int row = find_filtered_row(&app, deep);
+    ASSERT_TRUE("row found in the tail is its final row",
+                row == count - 3 && app.filtered_unordered == 0);
+    ok = 1;
+    for (int i = 0; i < count; i++) ok &= app.filtered[i].id == expected[i];
+    ASSERT_TRUE("fully extended rows match a full sort", ok);
+
+    // An empty query keeps history order, Special windows last; it too
+    // copies only the first screen and a page
+    filter_windows(&app, "");
+    ASSERT_TRUE("empty query copies only a screen and a page",
+                app.filtered_unordered == app.filtered_count - ranked);
+    count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < app.history_count; i++) {
+            const WindowInfo *win = &app.windows[find_window_index(&app, app.history[i])];
+            if ((strcmp(win->type, "Normal") == 0) == (pass == 0)) expected[count++] = win->id;
+        }
+    }
+    ensure_filtered_order(&app, app.filtered_count);
+    ok = count == app.filtered_count && app.filtered_unordered == 0;
+    for (int i = 0; i < count && ok; i++) ok &= app.filtered[i].id == expected[i];
+    ASSERT_TRUE("empty query tail keeps display order", ok);
+    free_app(&app);
+}
+
+static void test_pipeline_scales_linearly(void) {
+    double small = time_pipeline(500, 10);
+    double large = time_pipeline(2000, 10);
+    double ratio = small > 0 ? large / small : 0;
+
+    // 4x the windows: linear work costs ~4x, a quadratic pass ~16x.
+    // Reported only, since wall-clock ratios are noise on a loaded machine.
+    printf("  500 windows: %.2f ms, 2000 windows: %.2f ms (x%.1f)\n",
+           small * 1000 / 10, large * 1000 / 10, ratio);
+}
+
+int main(void) {
+    log_set_quiet(true);   /* suppress log output during tests */
+
+    test_grow_array_doubles_and_keeps_contents();
+    test_store_holds_2000_windows();
+    test_custom_name_is_matched_and_displayed();
+    test_refined_query_matches_full_scan();
+    test_only_visible_rows_are_ranked();
+    test_pipeline_scales_linearly();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}
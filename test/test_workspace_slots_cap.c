@@ -20,7 +20,17 @@ typedef struct {
     int h;
 } TestGeometry;
 
-static TestGeometry test_geometries[MAX_WINDOWS];
+#define TEST_MAX_WINDOWS 256
+
+// Backing store for app.windows (AppData only holds a pointer)
+static WindowInfo test_windows[TEST_MAX_WINDOWS];
+
+static WindowInfo *fresh_windows(void) {
+    memset(test_windows, 0, sizeof(test_windows));
+    return test_windows;
+}
+
+static TestGeometry test_geometries[TEST_MAX_WINDOWS];
 static int test_geometry_count = 0;
 static int test_current_desktop = 0;
 
@@ -43,13 +53,6 @@ int get_current_desktop(Display *display) {
     return test_current_desktop;
 }
 
-int get_window_state(Display *display, Window window, const char *state_name) {
-    (void)display;
-    (void)window;
-    (void)state_name;
-    return 0;
-}
-
 int get_window_geometry(Display *display, Window window, int *x, int *y, int *w, int *h) {
     (void)display;
     for (int i = 0; i < test_geometry_count; i++) {
@@ -117,7 +120,7 @@ int XFree(void *data) {
 #include "../src/workspace_slots.c"
 
 static void test_assign_workspace_slots_keeps_behavior_for_small_sets(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -141,7 +144,7 @@ static void test_assign_workspace_slots_keeps_behavior_for_small_sets(void) {
 }
 
 static void test_assign_workspace_slots_considers_all_candidates_before_capping(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -35,21 +35,29 @@ typedef struct {
     int x, y, w, h;
 } TestGeometry;
 
-static TestGeometry test_geometries[MAX_WINDOWS];
+#define TEST_MAX_WINDOWS 256
+
+// Backing store for app.windows (AppData only holds a pointer)
+static WindowInfo test_windows[TEST_MAX_WINDOWS];
+
+static WindowInfo *fresh_windows(void) {
+    memset(test_windows, 0, sizeof(test_windows));
+    return test_windows;
+}
+
+static TestGeometry test_geometries[TEST_MAX_WINDOWS];
 static int test_geometry_count = 0;
 static int test_current_desktop = 0;
 
-static Window test_stack[MAX_WINDOWS];
+static Window test_stack[TEST_MAX_WINDOWS];
 static unsigned long test_stack_count = 0;
-static Window test_hidden[MAX_WINDOWS];
-static int test_hidden_count = 0;
 
 typedef struct {
     Window id;
     int left, right, top, bottom;
 } TestFrameExtents;
 
-static TestFrameExtents test_fe_table[MAX_WINDOWS];
+static TestFrameExtents test_fe_table[TEST_MAX_WINDOWS];
 static int test_fe_count = 0;
 
 static void reset_test_state(void) {
@@ -58,8 +66,6 @@ static void reset_test_state(void) {
     test_current_desktop = 0;
     memset(test_stack, 0, sizeof(test_stack));
     test_stack_count = 0;
-    memset(test_hidden, 0, sizeof(test_hidden));
-    test_hidden_count = 0;
     memset(test_fe_table, 0, sizeof(test_fe_table));
     test_fe_count = 0;
 }
@@ -78,10 +84,6 @@ static void set_stack(Window *stack, int count) {
     test_stack_count = count;
 }
 
-static void add_hidden(Window id) {
-    test_hidden[test_hidden_count++] = id;
-}
-
 static void add_frame_extents(Window id, int left, int top, int right, int bottom) {
     test_fe_table[test_fe_count].id     = id;
     test_fe_table[test_fe_count].left   = left;
@@ -106,15 +108,6 @@ int get_current_desktop(Display *display) {
     return test_current_desktop;
 }
 
-int get_window_state(Display *display, Window window, const char *state_name) {
-    (void)display;
-    if (strcmp(state_name, "_NET_WM_STATE_HIDDEN") != 0) return 0;
-    for (int i = 0; i < test_hidden_count; i++) {
-        if (test_hidden[i] == window) return 1;
-    }
-    return 0;
-}
-
 int get_window_geometry(Display *display, Window window, int *x, int *y, int *w, int *h) {
     (void)display;
     for (int i = 0; i < test_geometry_count; i++) {
@@ -199,7 +192,7 @@ int get_frame_extents(Display *display, Window window, FrameExtents *extents) {
  *         All should get slots.
  * ================================================================== */
 static void test_no_occlusion_all_get_slots(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -230,7 +223,7 @@ static void test_no_occlusion_all_get_slots(void) {
  *         Background window should be EXCLUDED (zero visible pixels).
  * ================================================================== */
 static void test_fully_covered_by_single_window_is_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -265,7 +258,7 @@ static void test_fully_covered_by_single_window_is_excluded(void) {
  *         Background should SURVIVE.
  * ================================================================== */
 static void test_partially_visible_strip_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -313,7 +306,7 @@ static void test_partially_visible_strip_survives(void) {
  *           A and C excluded (zero or sub-threshold visible area).
  * ================================================================== */
 static void test_real_side_project_workspace(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_COLUMN_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -365,7 +358,7 @@ static void test_real_side_project_workspace(void) {
  *         A should be EXCLUDED (zero visible pixels).
  * ================================================================== */
 static void test_fully_covered_by_multiple_windows_is_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -405,7 +398,7 @@ static void test_fully_covered_by_multiple_windows_is_excluded(void) {
  *         (6.25% visible). A should SURVIVE.
  * ================================================================== */
 static void test_mostly_covered_but_visible_strip_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -444,7 +437,7 @@ static void test_mostly_covered_but_visible_strip_survives(void) {
  *         A should be EXCLUDED.
  * ================================================================== */
 static void test_overlapping_occluders_cover_fully(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -482,7 +475,7 @@ static void test_overlapping_occluders_cover_fully(void) {
  *         A should SURVIVE (gap at x=900..1000).
  * ================================================================== */
 static void test_overlapping_occluders_with_gap_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -521,7 +514,7 @@ static void test_overlapping_occluders_with_gap_survives(void) {
  *         A should be EXCLUDED.
  * ================================================================== */
 static void test_one_pixel_visible_is_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -556,7 +549,7 @@ static void test_one_pixel_visible_is_excluded(void) {
  *          A should SURVIVE.
  * ================================================================== */
 static void test_vertical_strip_top_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -591,7 +584,7 @@ static void test_vertical_strip_top_survives(void) {
  *          A should be EXCLUDED (fully covered). B should survive.
  * ================================================================== */
 static void test_below_in_stack_does_not_occlude(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -629,7 +622,7 @@ static void test_below_in_stack_does_not_occlude(void) {
  *          A should SURVIVE (>= threshold).
  * ================================================================== */
 static void test_exactly_at_threshold_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -663,7 +656,7 @@ static void test_exactly_at_threshold_survives(void) {
  *          Should survive (treated as non-occluded).
  * ================================================================== */
 static void test_window_not_in_stack_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -697,7 +690,7 @@ static void test_window_not_in_stack_survives(void) {
  *          Must be excluded by min-dimension check.
  * ================================================================== */
 static void test_thin_decoration_strip_excluded_by_dimension(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -732,7 +725,7 @@ static void test_thin_decoration_strip_excluded_by_dimension(void) {
  *          Visible fragment 8px tall, area well above threshold.
  * ================================================================== */
 static void test_dimension_boundary_exactly_8_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -767,7 +760,7 @@ static void test_dimension_boundary_exactly_8_survives(void) {
  *          Visible fragment 7px tall, area passes but dimension fails.
  * ================================================================== */
 static void test_dimension_boundary_7_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -801,7 +794,7 @@ static void test_dimension_boundary_7_excluded(void) {
  *          when area and min dimensions both pass.
  * ================================================================== */
 static void test_small_chunky_fragment_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -838,7 +831,7 @@ static void test_small_chunky_fragment_survives(void) {
  *          Expected survivors: Chrome-L and Chrome-R only.
  * ================================================================== */
 static void test_real_sp4_workspace(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_COLUMN_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -864,7 +857,7 @@ static void test_real_sp4_workspace(void) {
     app.windows[2].desktop = 0;
     strcpy(app.windows[2].type, "Normal");
     add_geometry(0x4c003a9, 3840, 0, 3840, 2112);
-    add_hidden(0x4c003a9);
+    app.windows[2].state = WINDOW_STATE_FLAG_HIDDEN;
 
     /* 0x412b6b0 Term-C (top-right quarter) */
     app.windows[3].id = 0x412b6b0;
@@ -926,7 +919,7 @@ static void test_real_sp4_workspace(void) {
  *  area visible → both SURVIVE.
  * ================================================================== */
 static void test_workspace1_tiled_terminals_thunderbird(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -991,7 +984,7 @@ static void test_workspace1_tiled_terminals_thunderbird(void) {
  *          Expected: B survives, A excluded.
  * ================================================================== */
 static void test_frame_extents_titlebar_strip_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -1038,7 +1031,7 @@ static void test_frame_extents_titlebar_strip_excluded(void) {
  *          Expected: both survive (A at 50%, B unoccluded).
  * ================================================================== */
 static void test_frame_extents_partial_content_survives(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_ROW_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
@@ -1080,7 +1073,7 @@ static void test_frame_extents_partial_content_survives(void) {
  *          a digit slot. Only the front terminals should survive.
  * ================================================================== */
 static void test_workspace1_thunderbird_behind_two_terminals_is_excluded(void) {
-    AppData app = {0};
+    AppData app = { .windows = fresh_windows() };
     init_workspace_slots(&app.workspace_slots);
     app.config.slot_sort_order = SLOT_SORT_COLUMN_FIRST;
     app.config.digit_slot_mode = DIGIT_MODE_DEFAULT;
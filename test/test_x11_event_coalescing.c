@@ -0,0 +1,487 @@
+/*
+ * Behavioral test: coalesced X event processing.
+ *
+ * process_x11_events() must only record what a burst of root and window
+ * property events made stale, then run one refresh from an idle callback:
+ * one client list diff, one property refetch, one active window read, one
+ * refilter/redraw, no matter how many events arrived. drain_x11_events()
+ * applies the pending refresh synchronously for show_window(). Windows are
+ * refetched once subscribed, so a change between their first fetch and
+ * the subscription (which sends no event) is not lost.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../src/app_data.h"
+
+static int pass = 0;
+static int fail = 0;
+
+#define ASSERT_TRUE(name, cond) do { \
+    if (cond) { printf("PASS: %s\n", name); pass++; } \
+    else       { printf("FAIL: %s\n", name); fail++; } \
+} while (0)
+
+#define ROOT_WINDOW 0x1
+#define CLIENT_WINDOW 0x500
+#define ATOM_NET_CLIENT_LIST 300
+#define ATOM_NET_ACTIVE_WINDOW 301
+#define ATOM_NET_CURRENT_DESKTOP 302
+#define ATOM_NET_CLIENT_LIST_STACKING 303
+#define ATOM_NET_WM_NAME 304
+
+/* ---- Fake event queue ---- */
+
+static XEvent queue[64];
+static int queue_head = 0;
+static int queue_tail = 0;
+
+static void push_property_event(Window window, Atom atom) {
+    XEvent ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.type = PropertyNotify;
+    ev.xproperty.window = window;
+    ev.xproperty.atom = atom;
+    queue[queue_tail++] = ev;
+}
+
+static void push_create_event(Window window) {
+    XEvent ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.type = CreateNotify;
+    ev.xcreatewindow.window = window;
+    queue[queue_tail++] = ev;
+}
+
+int test_XPending(Display *display) {
+    (void)display;
+    return queue_tail - queue_head;
+}
+
+int test_XNextEvent(Display *display, XEvent *event) {
+    (void)display;
+    *event = queue[queue_head++];
+    return 0;
+}
+
+/* ---- Counted collaborators ---- */
+
+static int update_window_list_calls = 0;
+static int refresh_properties_calls = 0;
+static int refreshed_property_windows = 0;
+static int active_window_reads = 0;
+static int current_desktop_reads = 0;
+static int filter_windows_calls = 0;
+static int update_display_calls = 0;
+static int warm_invalidate_calls = 0;
+static int idle_add_calls = 0;
+static GSourceFunc pending_idle = NULL;
+static gpointer pending_idle_data = NULL;
+
+// Title the X server holds for the window the next list diff adds (none
+// when 0); the diff fetches it, then the title changes before cofi has
+// subscribed to the window
+static Window appearing_window = 0;
+static char server_title[MAX_TITLE_LEN];
+static int added_index;
+static int select_input_calls = 0;
+static int subscribed_before_refetch = 0;
+
+void update_window_list(AppData *app, WindowListDelta *delta) {
+    update_window_list_calls++;
+    delta->added_count = 0;
+    delta->removed_count = 0;
+    delta->order_changed = true;
+
+    if (appearing_window != 0) {
+        WindowInfo *win = &app->windows[app->window_count];
+        memset(win, 0, sizeof(*win));
+        win->id = appearing_window;
+        strcpy(win->title, server_title);
+        added_index = app->window_count++;
+        delta->added = &added_index;
+        delta->added_count = 1;
+        strcpy(server_title, "changed before subscribing");
+        appearing_window = 0;
+    }
+}
+
+int refresh_window_properties(AppData *app, WindowPropertyUpdate *updates, int count) {
+    refresh_properties_calls++;
+    refreshed_property_windows += count;
+    for (int i = 0; i < count; i++) {
+        int index = find_window_index(app, updates[i].id);
+        if (index >= 0 && (updates[i].fields & WINDOW_FIELD_TITLE) && server_title[0]) {
+            strcpy(app->windows[index].title, server_title);
+            subscribed_before_refetch = select_input_calls > 0;
+        }
+    }
+    return count;
+}
+
+int find_window_index(const AppData *app, Window id) {
+    for (int i = 0; i < app->window_count; i++) {
+        if (app->windows[i].id == id) return i;
+    }
+    return -1;
+}
+
+unsigned int window_field_for_atom(const AtomCache *atoms, Atom atom) {
+    (void)atoms;
+    return atom == ATOM_NET_WM_NAME ? WINDOW_FIELD_TITLE : 0;
+}
+
+int get_active_window_id(Display *display) {
+    (void)display;
+    active_window_reads++;
+    return CLIENT_WINDOW;
+}
+
+int get_current_desktop(Display *display) {
+    (void)display;
+    current_desktop_reads++;
+    return 0;
+}
+
+void filter_windows(AppData *app, const char *filter) {
+    (void)app;
+    (void)filter;
+    filter_windows_calls++;
+}
+
+void update_display(AppData *app) {
+    (void)app;
+    update_display_calls++;
+}
+
+void warm_show_invalidate(AppData *app) {
+    (void)app;
+    warm_invalidate_calls++;
+}
+
+guint g_idle_add_full(gint priority, GSourceFunc function, gpointer data, GDestroyNotify notify) {
+    (void)priority;
+    (void)notify;
+    idle_add_calls++;
+    pending_idle = function;
+    pending_idle_data = data;
+    return 42;
+}
+
+gboolean g_source_remove(guint tag) {
+    (void)tag;
+    pending_idle = NULL;
+    return TRUE;
+}
+
+guint g_timeout_add(guint interval, GSourceFunc function, gpointer data) {
+    (void)interval;
+    (void)function;
+    (void)data;
+    return 7;
+}
+
+gboolean gtk_widget_get_visible(GtkWidget *widget) {
+    (void)widget;
+    return TRUE;
+}
+
+const gchar *gtk_entry_get_text(GtkEntry *entry) {
+    (void)entry;
+    return "";
+}
+
+/* ---- Inert collaborators ---- */
+
+bool check_and_reassign_windows_delta(HarpoonManager *manager, WindowInfo *windows,
+                                      int window_count, const WindowListDelta *delta) {
+    (void)manager; (void)windows; (void)window_count; (void)delta;
+    return false;
+}
+
+bool check_and_reassign_names_delta(NamedWindowManager *manager, WindowInfo *windows,
+                                    int window_count, const WindowListDelta *delta) {
+    (void)manager; (void)windows; (void)window_count; (void)delta;
+    return false;
+}
+
+void save_harpoon_slots(const HarpoonManager *harpoon) { (void)harpoon; }
+void save_named_windows(const NamedWindowManager *manager) { (void)manager; }
+void highlight_window(AppData *app, Window target) { (void)app; (void)target; }
+void destroy_highlight(AppData *app) { (void)app; }
+void handle_hotkey_event(AppData *app, XKeyEvent *event) { (void)app; (void)event; }
+void rule_state_remove_window(RuleState *state, Window id) { (void)state; (void)id; }
+
+RuleMatch check_rule_match(const Rule *rule, RuleState *state, Window id, const char *title) {
+    (void)rule; (void)state; (void)id; (void)title;
+    RuleMatch match = {0};
+    return match;
+}
+
+gboolean execute_command_background(const char *command, AppData *app, WindowInfo *window) {
+    (void)command; (void)app; (void)window;
+    return TRUE;
+}
+
+Status test_XGetWindowAttributes(Display *display, Window window, XWindowAttributes *attrs) {
+    (void)display;
+    (void)window;
+    memset(attrs, 0, sizeof(*attrs));
+    return 1;
+}
+
+int test_XSelectInput(Display *display, Window window, long mask) {
+    (void)display;
+    (void)window;
+    (void)mask;
+    select_input_calls++;
+    return 1;
+}
+
+GIOChannel *g_io_channel_unix_new(gint fd) {
+    (void)fd;
+    return NULL;
+}
+
+guint g_io_add_watch(GIOChannel *channel, GIOCondition condition, GIOFunc func,
+                     gpointer user_data) {
+    (void)channel; (void)condition; (void)func; (void)user_data;
+    return 9;
+}
+
+#define XPending test_XPending
+#define XNextEvent test_XNextEvent
+#define XGetWindowAttributes test_XGetWindowAttributes
+#define XSelectInput test_XSelectInput
+
+#undef GTK_IS_WIDGET
+#define GTK_IS_WIDGET(widget) ((widget) != NULL)
+#undef GTK_IS_ENTRY
+#define GTK_IS_ENTRY(widget) ((widget) != NULL)
+#undef GTK_ENTRY
+#define GTK_ENTRY(widget) ((GtkEntry *)(widget))
+
+/* ---- Module under test ---- */
+#include "../src/x11_events.c"
+
+/* ---- Helpers ---- */
+
+static AppData app;
+static WindowInfo windows[4];
+static __typeof__(*((_XPrivDisplay)0)) fake_display;
+static Screen fake_screen;
+
+static void reset(gboolean visible) {
+    memset(&app, 0, sizeof(app));
+    fake_screen.root = ROOT_WINDOW;
+    fake_display.screens = &fake_screen;
+    fake_display.default_screen = 0;
+    app.display = (Display *)&fake_display;
+    app.atoms.net_client_list = ATOM_NET_CLIENT_LIST;
+    app.atoms.net_active_window = ATOM_NET_ACTIVE_WINDOW;
+    app.atoms.net_current_desktop = ATOM_NET_CURRENT_DESKTOP;
+    app.atoms.net_client_list_stacking = ATOM_NET_CLIENT_LIST_STACKING;
+    app.atoms.net_wm_name = ATOM_NET_WM_NAME;
+    app.window = (GtkWidget *)0x10;
+    app.entry = (GtkWidget *)0x11;
+    app.window_visible = visible;
+    app.windows = windows;
+    app.window_capacity = 4;
+
+    init_title_throttle(&title_throttle);
+    title_timer_id = 0;
+
+    queue_head = queue_tail = 0;
+    update_window_list_calls = 0;
+    refresh_properties_calls = 0;
+    refreshed_property_windows = 0;
+    active_window_reads = 0;
+    current_desktop_reads = 0;
+    filter_windows_calls = 0;
+    update_display_calls = 0;
+    warm_invalidate_calls = 0;
+    idle_add_calls = 0;
+    pending_idle = NULL;
+    pending_idle_data = NULL;
+    appearing_window = 0;
+    server_title[0] = '\0';
+    select_input_calls = 0;
+    subscribed_before_refetch = 0;
+    window_registry_clear(&subscribed_windows);
+}
+
+static void run_pending_idle(void) {
+    GSourceFunc fn = pending_idle;
+    pending_idle = NULL;
+    if (fn) {
+        fn(pending_idle_data);
+    }
+}
+
+static void push_burst(void) {
+    for (int i = 0; i < 10; i++) {
+        push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    }
+    for (int i = 0; i < 3; i++) {
+        push_property_event(ROOT_WINDOW, ATOM_NET_ACTIVE_WINDOW);
+    }
+    push_property_event(ROOT_WINDOW, ATOM_NET_CURRENT_DESKTOP);
+    push_property_event(ROOT_WINDOW, ATOM_NET_CURRENT_DESKTOP);
+    for (int i = 0; i < 4; i++) {
+        push_property_event(CLIENT_WINDOW, ATOM_NET_WM_NAME);
+    }
+}
+
+/* ---- Tests ---- */
+
+static void test_burst_refreshes_once(void) {
+    reset(TRUE);
+    X11EventStats before = get_x11_event_stats();
+
+    push_burst();
+    process_x11_events(NULL, G_IO_IN, &app);
+
+    ASSERT_TRUE("burst: events only mark state dirty",
+                update_window_list_calls == 0 && filter_windows_calls == 0 &&
+                active_window_reads == 0);
+    ASSERT_TRUE("burst: one idle refresh scheduled", idle_add_calls == 1 && pending_idle != NULL);
+
+    run_pending_idle();
+    ASSERT_TRUE("burst: client list diffed once", update_window_list_calls == 1);
+    ASSERT_TRUE("burst: first title change refetched, the rest throttled",
+                refresh_properties_calls == 1 && refreshed_property_windows == 1);
+    ASSERT_TRUE("burst: trailing title delivery scheduled", title_timer_id != 0);
+    ASSERT_TRUE("burst: active window read once", active_window_reads == 1);
+    ASSERT_TRUE("burst: current desktop read once", current_desktop_reads == 1);
+    ASSERT_TRUE("burst: one refilter and redraw",
+                filter_windows_calls == 1 && update_display_calls == 1);
+
+    X11EventStats after = get_x11_event_stats();
+    ASSERT_TRUE("burst: 16 unthrottled events counted", after.events - before.events == 16);
+    ASSERT_TRUE("burst: one refresh", after.refreshes - before.refreshes == 1);
+    ASSERT_TRUE("burst: 15 refreshes avoided",
+                after.refreshes_avoided - before.refreshes_avoided == 15);
+}
+
+static void test_back_to_back_reads_share_idle(void) {
+    reset(TRUE);
+
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    process_x11_events(NULL, G_IO_IN, &app);
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    process_x11_events(NULL, G_IO_IN, &app);
+
+    ASSERT_TRUE("reads before the idle share one refresh", idle_add_calls == 1);
+    run_pending_idle();
+    ASSERT_TRUE("shared refresh diffs once", update_window_list_calls == 1);
+}
+
+static void test_drain_applies_synchronously(void) {
+    reset(TRUE);
+
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    process_x11_events(NULL, G_IO_IN, &app);
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    drain_x11_events(&app);
+
+    ASSERT_TRUE("drain applies pending refresh now",
+                update_window_list_calls == 1 && filter_windows_calls == 1);
+    ASSERT_TRUE("drain cancels the scheduled idle", pending_idle == NULL);
+
+    drain_x11_events(&app);
+    ASSERT_TRUE("drain with nothing queued does no work",
+                update_window_list_calls == 1 && refresh_properties_calls == 0);
+}
+
+static void test_drain_delivers_throttled_titles(void) {
+    reset(TRUE);
+
+    push_property_event(CLIENT_WINDOW, ATOM_NET_WM_NAME);
+    push_property_event(CLIENT_WINDOW, ATOM_NET_WM_NAME);
+    push_property_event(CLIENT_WINDOW, ATOM_NET_WM_NAME);
+    process_x11_events(NULL, G_IO_IN, &app);
+    run_pending_idle();
+    ASSERT_TRUE("throttle: leading title refetched once", refresh_properties_calls == 1);
+    ASSERT_TRUE("throttle: trailing timer armed", title_timer_id != 0);
+
+    drain_x11_events(&app);
+    ASSERT_TRUE("throttle: drain delivers the final title",
+                refresh_properties_calls == 2 && refreshed_property_windows == 2);
+    ASSERT_TRUE("throttle: drain disarms the timer", title_timer_id == 0);
+
+    TitleThrottleEntry stats[4];
+    int n = get_title_update_stats(stats, 4);
+    ASSERT_TRUE("throttle: per-window stats exposed",
+                n == 1 && stats[0].id == CLIENT_WINDOW &&
+                stats[0].events == 3 && stats[0].deliveries == 2);
+}
+
+static void test_hidden_window_only_invalidates(void) {
+    reset(FALSE);
+
+    push_property_event(ROOT_WINDOW, ATOM_NET_ACTIVE_WINDOW);
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST_STACKING);
+    process_x11_events(NULL, G_IO_IN, &app);
+    run_pending_idle();
+
+    ASSERT_TRUE("hidden: no refilter or redraw",
+                filter_windows_calls == 0 && update_display_calls == 0);
+    ASSERT_TRUE("hidden: warm list invalidated once", warm_invalidate_calls == 1);
+}
+
+static void test_irrelevant_events_schedule_nothing(void) {
+    reset(TRUE);
+
+    push_create_event(CLIENT_WINDOW);
+    push_property_event(CLIENT_WINDOW, 999);
+    process_x11_events(NULL, G_IO_IN, &app);
+
+    ASSERT_TRUE("unrelated events schedule no refresh", idle_add_calls == 0);
+}
+
+static void test_added_window_refetched_after_subscribing(void) {
+    reset(TRUE);
+    appearing_window = CLIENT_WINDOW;
+    strcpy(server_title, "first title");
+
+    push_property_event(ROOT_WINDOW, ATOM_NET_CLIENT_LIST);
+    process_x11_events(NULL, G_IO_IN, &app);
+    run_pending_idle();
+
+    ASSERT_TRUE("new window: subscribed to its properties", select_input_calls == 1);
+    ASSERT_TRUE("new window: refetched after subscribing",
+                refresh_properties_calls == 1 && subscribed_before_refetch);
+    ASSERT_TRUE("new window: change before the subscription picked up",
+                strcmp(app.windows[0].title, "changed before subscribing") == 0);
+}
+
+static void test_startup_windows_refetched_after_subscribing(void) {
+    reset(FALSE);
+    app.window_count = 1;
+    app.windows[0].id = CLIENT_WINDOW;
+    strcpy(app.windows[0].title, "fetched at startup");
+    strcpy(server_title, "changed before monitoring");
+
+    setup_x11_event_monitoring(&app);
+
+    ASSERT_TRUE("startup: refetched after subscribing",
+                refresh_properties_calls == 1 && subscribed_before_refetch);
+    ASSERT_TRUE("startup: change before monitoring picked up",
+                strcmp(app.windows[0].title, "changed before monitoring") == 0);
+    ASSERT_TRUE("startup: warm list rebuilt", warm_invalidate_calls == 1);
+    cleanup_x11_event_monitoring();
+}
+
+int main(void) {
+    test_burst_refreshes_once();
+    test_back_to_back_reads_share_idle();
+    test_drain_applies_synchronously();
+    test_drain_delivers_throttled_titles();
+    test_hidden_window_only_invalidates();
+    test_irrelevant_events_schedule_nothing();
+    test_added_window_refetched_after_subscribing();
+    test_startup_windows_refetched_after_subscribing();
+
+    printf("\nResults: %d/%d tests passed\n", pass, pass + fail);
+    return fail == 0 ? 0 : 1;
+}